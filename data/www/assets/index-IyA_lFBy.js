@@ -18,4 +18,4 @@
   * vue-router v4.5.0
   * (c) 2024 Eduardo San Martin Morote
   * @license MIT
-  */const At=typeof document<"u";function si(e){return typeof e=="object"||"displayName"in e||"props"in e||"__vccOpts"in e}function Zc(e){return e.__esModule||e[Symbol.toStringTag]==="Module"||e.default&&si(e.default)}const q=Object.assign;function rs(e,t){const n={};for(const s in t){const r=t[s];n[s]=ke(r)?r.map(e):e(r)}return n}const Xt=()=>{},ke=Array.isArray,ri=/#/g,eu=/&/g,tu=/\//g,nu=/=/g,su=/\?/g,oi=/\+/g,ru=/%5B/g,ou=/%5D/g,ii=/%5E/g,iu=/%60/g,li=/%7B/g,lu=/%7C/g,ci=/%7D/g,cu=/%20/g;function Ds(e){return encodeURI(""+e).replace(lu,"|").replace(ru,"[").replace(ou,"]")}function uu(e){return Ds(e).replace(li,"{").replace(ci,"}").replace(ii,"^")}function ys(e){return Ds(e).replace(oi,"%2B").replace(cu,"+").replace(ri,"%23").replace(eu,"%26").replace(iu,"`").replace(li,"{").replace(ci,"}").replace(ii,"^")}function fu(e){return ys(e).replace(nu,"%3D")}function au(e){return Ds(e).replace(ri,"%23").replace(su,"%3F")}function du(e){return e==null?"":au(e).replace(tu,"%2F")}function ln(e){try{return decodeURIComponent(""+e)}catch{}return""+e}const pu=/\/$/,hu=e=>e.replace(pu,"");function os(e,t,n="/"){let s,r={},o="",i="";const l=t.indexOf("#");let c=t.indexOf("?");return l<c&&l>=0&&(c=-1),c>-1&&(s=t.slice(0,c),o=t.slice(c+1,l>-1?l:t.length),r=e(o)),l>-1&&(s=s||t.slice(0,l),i=t.slice(l,t.length)),s=yu(s??t,n),{fullPath:s+(o&&"?")+o+i,path:s,query:r,hash:ln(i)}}function mu(e,t){const n=t.query?e(t.query):"";return t.path+(n&&"?")+n+(t.hash||"")}function Rr(e,t){return!t||!e.toLowerCase().startsWith(t.toLowerCase())?e:e.slice(t.length)||"/"}function gu(e,t,n){const s=t.matched.length-1,r=n.matched.length-1;return s>-1&&s===r&&jt(t.matched[s],n.matched[r])&&ui(t.params,n.params)&&e(t.query)===e(n.query)&&t.hash===n.hash}function jt(e,t){return(e.aliasOf||e)===(t.aliasOf||t)}function ui(e,t){if(Object.keys(e).length!==Object.keys(t).length)return!1;for(const n in e)if(!_u(e[n],t[n]))return!1;return!0}function _u(e,t){return ke(e)?Cr(e,t):ke(t)?Cr(t,e):e===t}function Cr(e,t){return ke(t)?e.length===t.length&&e.every((n,s)=>n===t[s]):e.length===1&&e[0]===t}function yu(e,t){if(e.startsWith("/"))return e;if(!e)return t;const n=t.split("/"),s=e.split("/"),r=s[s.length-1];(r===".."||r===".")&&s.push("");let o=n.length-1,i,l;for(i=0;i<s.length;i++)if(l=s[i],l!==".")if(l==="..")o>1&&o--;else break;return n.slice(0,o).join("/")+"/"+s.slice(i).join("/")}const ot={path:"/",name:void 0,params:{},query:{},hash:"",fullPath:"/",matched:[],meta:{},redirectedFrom:void 0};var cn;(function(e){e.pop="pop",e.push="push"})(cn||(cn={}));var Zt;(function(e){e.back="back",e.forward="forward",e.unknown=""})(Zt||(Zt={}));function vu(e){if(!e)if(At){const t=document.querySelector("base");e=t&&t.getAttribute("href")||"/",e=e.replace(/^\w+:\/\/[^\/]+/,"")}else e="/";return e[0]!=="/"&&e[0]!=="#"&&(e="/"+e),hu(e)}const bu=/^[^#]+#/;function xu(e,t){return e.replace(bu,"#")+t}function wu(e,t){const n=document.documentElement.getBoundingClientRect(),s=e.getBoundingClientRect();return{behavior:t.behavior,left:s.left-n.left-(t.left||0),top:s.top-n.top-(t.top||0)}}const qn=()=>({left:window.scrollX,top:window.scrollY});function Su(e){let t;if("el"in e){const n=e.el,s=typeof n=="string"&&n.startsWith("#"),r=typeof n=="string"?s?document.getElementById(n.slice(1)):document.querySelector(n):n;if(!r)return;t=wu(r,e)}else t=e;"scrollBehavior"in document.documentElement.style?window.scrollTo(t):window.scrollTo(t.left!=null?t.left:window.scrollX,t.top!=null?t.top:window.scrollY)}function Pr(e,t){return(history.state?history.state.position-t:-1)+e}const vs=new Map;function Eu(e,t){vs.set(e,t)}function Ru(e){const t=vs.get(e);return vs.delete(e),t}let Cu=()=>location.protocol+"//"+location.host;function fi(e,t){const{pathname:n,search:s,hash:r}=t,o=e.indexOf("#");if(o>-1){let l=r.includes(e.slice(o))?e.slice(o).length:1,c=r.slice(l);return c[0]!=="/"&&(c="/"+c),Rr(c,"")}return Rr(n,e)+s+r}function Pu(e,t,n,s){let r=[],o=[],i=null;const l=({state:h})=>{const g=fi(e,location),C=n.value,P=t.value;let D=0;if(h){if(n.value=g,t.value=h,i&&i===C){i=null;return}D=P?h.position-P.position:0}else s(g);r.forEach(N=>{N(n.value,C,{delta:D,type:cn.pop,direction:D?D>0?Zt.forward:Zt.back:Zt.unknown})})};function c(){i=n.value}function d(h){r.push(h);const g=()=>{const C=r.indexOf(h);C>-1&&r.splice(C,1)};return o.push(g),g}function f(){const{history:h}=window;h.state&&h.replaceState(q({},h.state,{scroll:qn()}),"")}function p(){for(const h of o)h();o=[],window.removeEventListener("popstate",l),window.removeEventListener("beforeunload",f)}return window.addEventListener("popstate",l),window.addEventListener("beforeunload",f,{passive:!0}),{pauseListeners:c,listen:d,destroy:p}}function Or(e,t,n,s=!1,r=!1){return{back:e,current:t,forward:n,replaced:s,position:window.history.length,scroll:r?qn():null}}function Ou(e){const{history:t,location:n}=window,s={value:fi(e,n)},r={value:t.state};r.value||o(s.value,{back:null,current:s.value,forward:null,position:t.length-1,replaced:!0,scroll:null},!0);function o(c,d,f){const p=e.indexOf("#"),h=p>-1?(n.host&&document.querySelector("base")?e:e.slice(p))+c:Cu()+e+c;try{t[f?"replaceState":"pushState"](d,"",h),r.value=d}catch(g){console.error(g),n[f?"replace":"assign"](h)}}function i(c,d){const f=q({},t.state,Or(r.value.back,c,r.value.forward,!0),d,{position:r.value.position});o(c,f,!0),s.value=c}function l(c,d){const f=q({},r.value,t.state,{forward:c,scroll:qn()});o(f.current,f,!0);const p=q({},Or(s.value,c,null),{position:f.position+1},d);o(c,p,!1),s.value=c}return{location:s,state:r,push:l,replace:i}}function Au(e){e=vu(e);const t=Ou(e),n=Pu(e,t.state,t.location,t.replace);function s(o,i=!0){i||n.pauseListeners(),history.go(o)}const r=q({location:"",base:e,go:s,createHref:xu.bind(null,e)},t,n);return Object.defineProperty(r,"location",{enumerable:!0,get:()=>t.location.value}),Object.defineProperty(r,"state",{enumerable:!0,get:()=>t.state.value}),r}function Tu(e){return typeof e=="string"||e&&typeof e=="object"}function ai(e){return typeof e=="string"||typeof e=="symbol"}const di=Symbol("");var Ar;(function(e){e[e.aborted=4]="aborted",e[e.cancelled=8]="cancelled",e[e.duplicated=16]="duplicated"})(Ar||(Ar={}));function Vt(e,t){return q(new Error,{type:e,[di]:!0},t)}function Ye(e,t){return e instanceof Error&&di in e&&(t==null||!!(e.type&t))}const Tr="[^/]+?",Mu={sensitive:!1,strict:!1,start:!0,end:!0},$u=/[.+*?^${}()[\]/\\]/g;function Iu(e,t){const n=q({},Mu,t),s=[];let r=n.start?"^":"";const o=[];for(const d of e){const f=d.length?[]:[90];n.strict&&!d.length&&(r+="/");for(let p=0;p<d.length;p++){const h=d[p];let g=40+(n.sensitive?.25:0);if(h.type===0)p||(r+="/"),r+=h.value.replace($u,"\\$&"),g+=40;else if(h.type===1){const{value:C,repeatable:P,optional:D,regexp:N}=h;o.push({name:C,repeatable:P,optional:D});const I=N||Tr;if(I!==Tr){g+=10;try{new RegExp(`(${I})`)}catch(M){throw new Error(`Invalid custom RegExp for param "${C}" (${I}): `+M.message)}}let F=P?`((?:${I})(?:/(?:${I}))*)`:`(${I})`;p||(F=D&&d.length<2?`(?:/${F})`:"/"+F),D&&(F+="?"),r+=F,g+=20,D&&(g+=-8),P&&(g+=-20),I===".*"&&(g+=-50)}f.push(g)}s.push(f)}if(n.strict&&n.end){const d=s.length-1;s[d][s[d].length-1]+=.7000000000000001}n.strict||(r+="/?"),n.end?r+="$":n.strict&&!r.endsWith("/")&&(r+="(?:/|$)");const i=new RegExp(r,n.sensitive?"":"i");function l(d){const f=d.match(i),p={};if(!f)return null;for(let h=1;h<f.length;h++){const g=f[h]||"",C=o[h-1];p[C.name]=g&&C.repeatable?g.split("/"):g}return p}function c(d){let f="",p=!1;for(const h of e){(!p||!f.endsWith("/"))&&(f+="/"),p=!1;for(const g of h)if(g.type===0)f+=g.value;else if(g.type===1){const{value:C,repeatable:P,optional:D}=g,N=C in d?d[C]:"";if(ke(N)&&!P)throw new Error(`Provided param "${C}" is an array but it is not repeatable (* or + modifiers)`);const I=ke(N)?N.join("/"):N;if(!I)if(D)h.length<2&&(f.endsWith("/")?f=f.slice(0,-1):p=!0);else throw new Error(`Missing required param "${C}"`);f+=I}}return f||"/"}return{re:i,score:s,keys:o,parse:l,stringify:c}}function ku(e,t){let n=0;for(;n<e.length&&n<t.length;){const s=t[n]-e[n];if(s)return s;n++}return e.length<t.length?e.length===1&&e[0]===80?-1:1:e.length>t.length?t.length===1&&t[0]===80?1:-1:0}function pi(e,t){let n=0;const s=e.score,r=t.score;for(;n<s.length&&n<r.length;){const o=ku(s[n],r[n]);if(o)return o;n++}if(Math.abs(r.length-s.length)===1){if(Mr(s))return 1;if(Mr(r))return-1}return r.length-s.length}function Mr(e){const t=e[e.length-1];return e.length>0&&t[t.length-1]<0}const Lu={type:0,value:""},Nu=/[a-zA-Z0-9_]/;function Fu(e){if(!e)return[[]];if(e==="/")return[[Lu]];if(!e.startsWith("/"))throw new Error(`Invalid path "${e}"`);function t(g){throw new Error(`ERR (${n})/"${d}": ${g}`)}let n=0,s=n;const r=[];let o;function i(){o&&r.push(o),o=[]}let l=0,c,d="",f="";function p(){d&&(n===0?o.push({type:0,value:d}):n===1||n===2||n===3?(o.length>1&&(c==="*"||c==="+")&&t(`A repeatable param (${d}) must be alone in its segment. eg: '/:ids+.`),o.push({type:1,value:d,regexp:f,repeatable:c==="*"||c==="+",optional:c==="*"||c==="?"})):t("Invalid state to consume buffer"),d="")}function h(){d+=c}for(;l<e.length;){if(c=e[l++],c==="\\"&&n!==2){s=n,n=4;continue}switch(n){case 0:c==="/"?(d&&p(),i()):c===":"?(p(),n=1):h();break;case 4:h(),n=s;break;case 1:c==="("?n=2:Nu.test(c)?h():(p(),n=0,c!=="*"&&c!=="?"&&c!=="+"&&l--);break;case 2:c===")"?f[f.length-1]=="\\"?f=f.slice(0,-1)+c:n=3:f+=c;break;case 3:p(),n=0,c!=="*"&&c!=="?"&&c!=="+"&&l--,f="";break;default:t("Unknown state");break}}return n===2&&t(`Unfinished custom RegExp for param "${d}"`),p(),i(),r}function ju(e,t,n){const s=Iu(Fu(e.path),n),r=q(s,{record:e,parent:t,children:[],alias:[]});return t&&!r.record.aliasOf==!t.record.aliasOf&&t.children.push(r),r}function Vu(e,t){const n=[],s=new Map;t=Lr({strict:!1,end:!0,sensitive:!1},t);function r(p){return s.get(p)}function o(p,h,g){const C=!g,P=Ir(p);P.aliasOf=g&&g.record;const D=Lr(t,p),N=[P];if("alias"in p){const M=typeof p.alias=="string"?[p.alias]:p.alias;for(const Z of M)N.push(Ir(q({},P,{components:g?g.record.components:P.components,path:Z,aliasOf:g?g.record:P})))}let I,F;for(const M of N){const{path:Z}=M;if(h&&Z[0]!=="/"){const ce=h.record.path,re=ce[ce.length-1]==="/"?"":"/";M.path=h.record.path+(Z&&re+Z)}if(I=ju(M,h,D),g?g.alias.push(I):(F=F||I,F!==I&&F.alias.push(I),C&&p.name&&!kr(I)&&i(p.name)),hi(I)&&c(I),P.children){const ce=P.children;for(let re=0;re<ce.length;re++)o(ce[re],I,g&&g.children[re])}g=g||I}return F?()=>{i(F)}:Xt}function i(p){if(ai(p)){const h=s.get(p);h&&(s.delete(p),n.splice(n.indexOf(h),1),h.children.forEach(i),h.alias.forEach(i))}else{const h=n.indexOf(p);h>-1&&(n.splice(h,1),p.record.name&&s.delete(p.record.name),p.children.forEach(i),p.alias.forEach(i))}}function l(){return n}function c(p){const h=Bu(p,n);n.splice(h,0,p),p.record.name&&!kr(p)&&s.set(p.record.name,p)}function d(p,h){let g,C={},P,D;if("name"in p&&p.name){if(g=s.get(p.name),!g)throw Vt(1,{location:p});D=g.record.name,C=q($r(h.params,g.keys.filter(F=>!F.optional).concat(g.parent?g.parent.keys.filter(F=>F.optional):[]).map(F=>F.name)),p.params&&$r(p.params,g.keys.map(F=>F.name))),P=g.stringify(C)}else if(p.path!=null)P=p.path,g=n.find(F=>F.re.test(P)),g&&(C=g.parse(P),D=g.record.name);else{if(g=h.name?s.get(h.name):n.find(F=>F.re.test(h.path)),!g)throw Vt(1,{location:p,currentLocation:h});D=g.record.name,C=q({},h.params,p.params),P=g.stringify(C)}const N=[];let I=g;for(;I;)N.unshift(I.record),I=I.parent;return{name:D,path:P,params:C,matched:N,meta:Du(N)}}e.forEach(p=>o(p));function f(){n.length=0,s.clear()}return{addRoute:o,resolve:d,removeRoute:i,clearRoutes:f,getRoutes:l,getRecordMatcher:r}}function $r(e,t){const n={};for(const s of t)s in e&&(n[s]=e[s]);return n}function Ir(e){const t={path:e.path,redirect:e.redirect,name:e.name,meta:e.meta||{},aliasOf:e.aliasOf,beforeEnter:e.beforeEnter,props:Hu(e),children:e.children||[],instances:{},leaveGuards:new Set,updateGuards:new Set,enterCallbacks:{},components:"components"in e?e.components||null:e.component&&{default:e.component}};return Object.defineProperty(t,"mods",{value:{}}),t}function Hu(e){const t={},n=e.props||!1;if("component"in e)t.default=n;else for(const s in e.components)t[s]=typeof n=="object"?n[s]:n;return t}function kr(e){for(;e;){if(e.record.aliasOf)return!0;e=e.parent}return!1}function Du(e){return e.reduce((t,n)=>q(t,n.meta),{})}function Lr(e,t){const n={};for(const s in e)n[s]=s in t?t[s]:e[s];return n}function Bu(e,t){let n=0,s=t.length;for(;n!==s;){const o=n+s>>1;pi(e,t[o])<0?s=o:n=o+1}const r=Uu(e);return r&&(s=t.lastIndexOf(r,s-1)),s}function Uu(e){let t=e;for(;t=t.parent;)if(hi(t)&&pi(e,t)===0)return t}function hi({record:e}){return!!(e.name||e.components&&Object.keys(e.components).length||e.redirect)}function Ku(e){const t={};if(e===""||e==="?")return t;const s=(e[0]==="?"?e.slice(1):e).split("&");for(let r=0;r<s.length;++r){const o=s[r].replace(oi," "),i=o.indexOf("="),l=ln(i<0?o:o.slice(0,i)),c=i<0?null:ln(o.slice(i+1));if(l in t){let d=t[l];ke(d)||(d=t[l]=[d]),d.push(c)}else t[l]=c}return t}function Nr(e){let t="";for(let n in e){const s=e[n];if(n=fu(n),s==null){s!==void 0&&(t+=(t.length?"&":"")+n);continue}(ke(s)?s.map(o=>o&&ys(o)):[s&&ys(s)]).forEach(o=>{o!==void 0&&(t+=(t.length?"&":"")+n,o!=null&&(t+="="+o))})}return t}function zu(e){const t={};for(const n in e){const s=e[n];s!==void 0&&(t[n]=ke(s)?s.map(r=>r==null?null:""+r):s==null?s:""+s)}return t}const mi=Symbol(""),Fr=Symbol(""),Gn=Symbol(""),gi=Symbol(""),bs=Symbol("");function zt(){let e=[];function t(s){return e.push(s),()=>{const r=e.indexOf(s);r>-1&&e.splice(r,1)}}function n(){e=[]}return{add:t,list:()=>e.slice(),reset:n}}function Wu(e,t,n){const s=()=>{e[t].delete(n)};Fs(s),Po(s),Co(()=>{e[t].add(n)}),e[t].add(n)}function qu(e){const t=$e(mi,{}).value;t&&Wu(t,"leaveGuards",e)}function ct(e,t,n,s,r,o=i=>i()){const i=s&&(s.enterCallbacks[r]=s.enterCallbacks[r]||[]);return()=>new Promise((l,c)=>{const d=h=>{h===!1?c(Vt(4,{from:n,to:t})):h instanceof Error?c(h):Tu(h)?c(Vt(2,{from:t,to:h})):(i&&s.enterCallbacks[r]===i&&typeof h=="function"&&i.push(h),l())},f=o(()=>e.call(s&&s.instances[r],t,n,d));let p=Promise.resolve(f);e.length<3&&(p=p.then(d)),p.catch(h=>c(h))})}function is(e,t,n,s,r=o=>o()){const o=[];for(const i of e)for(const l in i.components){let c=i.components[l];if(!(t!=="beforeRouteEnter"&&!i.instances[l]))if(si(c)){const f=(c.__vccOpts||c)[t];f&&o.push(ct(f,n,s,i,l,r))}else{let d=c();o.push(()=>d.then(f=>{if(!f)throw new Error(`Couldn't resolve component "${l}" at "${i.path}"`);const p=Zc(f)?f.default:f;i.mods[l]=f,i.components[l]=p;const g=(p.__vccOpts||p)[t];return g&&ct(g,n,s,i,l,r)()}))}}return o}function jr(e){const t=$e(Gn),n=$e(gi),s=Oe(()=>{const c=bt(e.to);return t.resolve(c)}),r=Oe(()=>{const{matched:c}=s.value,{length:d}=c,f=c[d-1],p=n.matched;if(!f||!p.length)return-1;const h=p.findIndex(jt.bind(null,f));if(h>-1)return h;const g=Vr(c[d-2]);return d>1&&Vr(f)===g&&p[p.length-1].path!==g?p.findIndex(jt.bind(null,c[d-2])):h}),o=Oe(()=>r.value>-1&&Xu(n.params,s.value.params)),i=Oe(()=>r.value>-1&&r.value===n.matched.length-1&&ui(n.params,s.value.params));function l(c={}){if(Qu(c)){const d=t[bt(e.replace)?"replace":"push"](bt(e.to)).catch(Xt);return e.viewTransition&&typeof document<"u"&&"startViewTransition"in document&&document.startViewTransition(()=>d),d}return Promise.resolve()}return{route:s,href:Oe(()=>s.value.href),isActive:o,isExactActive:i,navigate:l}}function Gu(e){return e.length===1?e[0]:e}const Yu=ge({name:"RouterLink",compatConfig:{MODE:3},props:{to:{type:[String,Object],required:!0},replace:Boolean,activeClass:String,exactActiveClass:String,custom:Boolean,ariaCurrentValue:{type:String,default:"page"}},useLink:jr,setup(e,{slots:t}){const n=fn(jr(e)),{options:s}=$e(Gn),r=Oe(()=>({[Hr(e.activeClass,s.linkActiveClass,"router-link-active")]:n.isActive,[Hr(e.exactActiveClass,s.linkExactActiveClass,"router-link-exact-active")]:n.isExactActive}));return()=>{const o=t.default&&Gu(t.default(n));return e.custom?o:ei("a",{"aria-current":n.isExactActive?e.ariaCurrentValue:null,href:n.href,onClick:n.navigate,class:r.value},o)}}}),Ju=Yu;function Qu(e){if(!(e.metaKey||e.altKey||e.ctrlKey||e.shiftKey)&&!e.defaultPrevented&&!(e.button!==void 0&&e.button!==0)){if(e.currentTarget&&e.currentTarget.getAttribute){const t=e.currentTarget.getAttribute("target");if(/\b_blank\b/i.test(t))return}return e.preventDefault&&e.preventDefault(),!0}}function Xu(e,t){for(const n in t){const s=t[n],r=e[n];if(typeof s=="string"){if(s!==r)return!1}else if(!ke(r)||r.length!==s.length||s.some((o,i)=>o!==r[i]))return!1}return!0}function Vr(e){return e?e.aliasOf?e.aliasOf.path:e.path:""}const Hr=(e,t,n)=>e??t??n,Zu=ge({name:"RouterView",inheritAttrs:!1,props:{name:{type:String,default:"default"},route:Object},compatConfig:{MODE:3},setup(e,{attrs:t,slots:n}){const s=$e(bs),r=Oe(()=>e.route||s.value),o=$e(Fr,0),i=Oe(()=>{let d=bt(o);const{matched:f}=r.value;let p;for(;(p=f[d])&&!p.components;)d++;return d}),l=Oe(()=>r.value.matched[i.value]);xn(Fr,Oe(()=>i.value+1)),xn(mi,l),xn(bs,r);const c=et();return wn(()=>[c.value,l.value,e.name],([d,f,p],[h,g,C])=>{f&&(f.instances[p]=d,g&&g!==f&&d&&d===h&&(f.leaveGuards.size||(f.leaveGuards=g.leaveGuards),f.updateGuards.size||(f.updateGuards=g.updateGuards))),d&&f&&(!g||!jt(f,g)||!h)&&(f.enterCallbacks[p]||[]).forEach(P=>P(d))},{flush:"post"}),()=>{const d=r.value,f=e.name,p=l.value,h=p&&p.components[f];if(!h)return Dr(n.default,{Component:h,route:d});const g=p.props[f],C=g?g===!0?d.params:typeof g=="function"?g(d):g:null,D=ei(h,q({},C,t,{onVnodeUnmounted:N=>{N.component.isUnmounted&&(p.instances[f]=null)},ref:c}));return Dr(n.default,{Component:D,route:d})||D}}});function Dr(e,t){if(!e)return null;const n=e(t);return n.length===1?n[0]:n}const ef=Zu;function tf(e){const t=Vu(e.routes,e),n=e.parseQuery||Ku,s=e.stringifyQuery||Nr,r=e.history,o=zt(),i=zt(),l=zt(),c=mo(ot);let d=ot;At&&e.scrollBehavior&&"scrollRestoration"in history&&(history.scrollRestoration="manual");const f=rs.bind(null,y=>""+y),p=rs.bind(null,du),h=rs.bind(null,ln);function g(y,A){let R,$;return ai(y)?(R=t.getRecordMatcher(y),$=A):$=y,t.addRoute($,R)}function C(y){const A=t.getRecordMatcher(y);A&&t.removeRoute(A)}function P(){return t.getRoutes().map(y=>y.record)}function D(y){return!!t.getRecordMatcher(y)}function N(y,A){if(A=q({},A||c.value),typeof y=="string"){const m=os(n,y,A.path),_=t.resolve({path:m.path},A),b=r.createHref(m.fullPath);return q(m,_,{params:h(_.params),hash:ln(m.hash),redirectedFrom:void 0,href:b})}let R;if(y.path!=null)R=q({},y,{path:os(n,y.path,A.path).path});else{const m=q({},y.params);for(const _ in m)m[_]==null&&delete m[_];R=q({},y,{params:p(m)}),A.params=p(A.params)}const $=t.resolve(R,A),ee=y.hash||"";$.params=f(h($.params));const u=mu(s,q({},y,{hash:uu(ee),path:$.path})),a=r.createHref(u);return q({fullPath:u,hash:ee,query:s===Nr?zu(y.query):y.query||{}},$,{redirectedFrom:void 0,href:a})}function I(y){return typeof y=="string"?os(n,y,c.value.path):q({},y)}function F(y,A){if(d!==y)return Vt(8,{from:A,to:y})}function M(y){return re(y)}function Z(y){return M(q(I(y),{replace:!0}))}function ce(y){const A=y.matched[y.matched.length-1];if(A&&A.redirect){const{redirect:R}=A;let $=typeof R=="function"?R(y):R;return typeof $=="string"&&($=$.includes("?")||$.includes("#")?$=I($):{path:$},$.params={}),q({query:y.query,hash:y.hash,params:$.path!=null?{}:y.params},$)}}function re(y,A){const R=d=N(y),$=c.value,ee=y.state,u=y.force,a=y.replace===!0,m=ce(R);if(m)return re(q(I(m),{state:typeof m=="object"?q({},ee,m.state):ee,force:u,replace:a}),A||R);const _=R;_.redirectedFrom=A;let b;return!u&&gu(s,$,R)&&(b=Vt(16,{to:_,from:$}),je($,$,!0,!1)),(b?Promise.resolve(b):Ne(_,$)).catch(v=>Ye(v)?Ye(v,2)?v:rt(v):W(v,_,$)).then(v=>{if(v){if(Ye(v,2))return re(q({replace:a},I(v.to),{state:typeof v.to=="object"?q({},ee,v.to.state):ee,force:u}),A||_)}else v=mt(_,$,!0,a,ee);return st(_,$,v),v})}function Le(y,A){const R=F(y,A);return R?Promise.reject(R):Promise.resolve()}function nt(y){const A=Ct.values().next().value;return A&&typeof A.runWithContext=="function"?A.runWithContext(y):y()}function Ne(y,A){let R;const[$,ee,u]=nf(y,A);R=is($.reverse(),"beforeRouteLeave",y,A);for(const m of $)m.leaveGuards.forEach(_=>{R.push(ct(_,y,A))});const a=Le.bind(null,y,A);return R.push(a),Pe(R).then(()=>{R=[];for(const m of o.list())R.push(ct(m,y,A));return R.push(a),Pe(R)}).then(()=>{R=is(ee,"beforeRouteUpdate",y,A);for(const m of ee)m.updateGuards.forEach(_=>{R.push(ct(_,y,A))});return R.push(a),Pe(R)}).then(()=>{R=[];for(const m of u)if(m.beforeEnter)if(ke(m.beforeEnter))for(const _ of m.beforeEnter)R.push(ct(_,y,A));else R.push(ct(m.beforeEnter,y,A));return R.push(a),Pe(R)}).then(()=>(y.matched.forEach(m=>m.enterCallbacks={}),R=is(u,"beforeRouteEnter",y,A,nt),R.push(a),Pe(R))).then(()=>{R=[];for(const m of i.list())R.push(ct(m,y,A));return R.push(a),Pe(R)}).catch(m=>Ye(m,8)?m:Promise.reject(m))}function st(y,A,R){l.list().forEach($=>nt(()=>$(y,A,R)))}function mt(y,A,R,$,ee){const u=F(y,A);if(u)return u;const a=A===ot,m=At?history.state:{};R&&($||a?r.replace(y.fullPath,q({scroll:a&&m&&m.scroll},ee)):r.push(y.fullPath,ee)),c.value=y,je(y,A,R,a),rt()}let Fe;function Dt(){Fe||(Fe=r.listen((y,A,R)=>{if(!mn.listening)return;const $=N(y),ee=ce($);if(ee){re(q(ee,{replace:!0,force:!0}),$).catch(Xt);return}d=$;const u=c.value;At&&Eu(Pr(u.fullPath,R.delta),qn()),Ne($,u).catch(a=>Ye(a,12)?a:Ye(a,2)?(re(q(I(a.to),{force:!0}),$).then(m=>{Ye(m,20)&&!R.delta&&R.type===cn.pop&&r.go(-1,!1)}).catch(Xt),Promise.reject()):(R.delta&&r.go(-R.delta,!1),W(a,$,u))).then(a=>{a=a||mt($,u,!1),a&&(R.delta&&!Ye(a,8)?r.go(-R.delta,!1):R.type===cn.pop&&Ye(a,20)&&r.go(-1,!1)),st($,u,a)}).catch(Xt)}))}let Et=zt(),ie=zt(),Q;function W(y,A,R){rt(y);const $=ie.list();return $.length?$.forEach(ee=>ee(y,A,R)):console.error(y),Promise.reject(y)}function qe(){return Q&&c.value!==ot?Promise.resolve():new Promise((y,A)=>{Et.add([y,A])})}function rt(y){return Q||(Q=!y,Dt(),Et.list().forEach(([A,R])=>y?R(y):A()),Et.reset()),y}function je(y,A,R,$){const{scrollBehavior:ee}=e;if(!At||!ee)return Promise.resolve();const u=!R&&Ru(Pr(y.fullPath,0))||($||!R)&&history.state&&history.state.scroll||null;return ks().then(()=>ee(y,A,u)).then(a=>a&&Su(a)).catch(a=>W(a,y,A))}const _e=y=>r.go(y);let Rt;const Ct=new Set,mn={currentRoute:c,listening:!0,addRoute:g,removeRoute:C,clearRoutes:t.clearRoutes,hasRoute:D,getRoutes:P,resolve:N,options:e,push:M,replace:Z,go:_e,back:()=>_e(-1),forward:()=>_e(1),beforeEach:o.add,beforeResolve:i.add,afterEach:l.add,onError:ie.add,isReady:qe,install(y){const A=this;y.component("RouterLink",Ju),y.component("RouterView",ef),y.config.globalProperties.$router=A,Object.defineProperty(y.config.globalProperties,"$route",{enumerable:!0,get:()=>bt(c)}),At&&!Rt&&c.value===ot&&(Rt=!0,M(r.location).catch(ee=>{}));const R={};for(const ee in ot)Object.defineProperty(R,ee,{get:()=>c.value[ee],enumerable:!0});y.provide(Gn,A),y.provide(gi,po(R)),y.provide(bs,c);const $=y.unmount;Ct.add(y),y.unmount=function(){Ct.delete(y),Ct.size<1&&(d=ot,Fe&&Fe(),Fe=null,c.value=ot,Rt=!1,Q=!1),$()}}};function Pe(y){return y.reduce((A,R)=>A.then(()=>nt(R)),Promise.resolve())}return mn}function nf(e,t){const n=[],s=[],r=[],o=Math.max(t.matched.length,e.matched.length);for(let i=0;i<o;i++){const l=t.matched[i];l&&(e.matched.find(d=>jt(d,l))?s.push(l):n.push(l));const c=e.matched[i];c&&(t.matched.find(d=>jt(d,c))||r.push(c))}return[n,s,r]}function sf(){return $e(Gn)}const _i=et(!1);function rf(e){_i.value=e}function Bs(){return{confirmAccess:_i,setConfirmAccess:rf}}const hn=(e,t)=>{const n=e.__vccOpts||e;for(const[s,r]of t)n[s]=r;return n},of={},lf={class:"max-w-2xl grow mx-auto px-8 flex flex-col justify-center gap-y-3 md:gap-y-6"};function cf(e,t){const n=Un("RouterLink");return B(),X("div",lf,[t[1]||(t[1]=T("section",null,[T("h1",{class:"text-size-3xl text-color-title font-bold"},"HomeSphere"),T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ")],-1)),K(n,{to:{name:"wifi"}},{default:dn(()=>t[0]||(t[0]=[Jo("Configuración WiFi")])),_:1})])}const uf=hn(of,[["render",cf]]),ff={class:"flex flex-col gap-y-1 md:gap-y-2"},af={for:"ssidInput",class:"text-color-title ml-1.5 font-semibold leading-none"},df={class:"flex flex-col rounded-t-lg overflow-hidden"},pf=["id","type"],Br=ge({__name:"InputGroup",props:Tl({type:{},id:{},label:{}},{modelValue:{required:!0},modelModifiers:{}}),emits:["update:modelValue"],setup(e,{expose:t}){const n=e,s=Xl(e,"modelValue"),r=Eo("input");return t({focus:function(){r.value&&(r.value.focus(),r.value.scrollIntoView({behavior:"smooth",block:"center"}))}}),(o,i)=>(B(),X("div",ff,[T("label",af,St(n.label),1),T("div",df,[al(T("input",{ref:"input","onUpdate:modelValue":i[0]||(i[0]=l=>s.value=l),id:n.id,type:n.type,class:"bg-primary-50 dark:bg-zinc-900 px-4 py-2"},null,8,pf),[[Uc,s.value]]),i[1]||(i[1]=T("div",{class:"w-full h-0.5 bg-primary-500 dark:bg-primary-400"},null,-1))])]))}}),hf=["type","disabled"],mf={key:0,class:"py-1"},gf={key:1,class:"text-zinc-50 dark:text-zinc-950 relative top-0.5 font-bold uppercase w-min text-nowrap"},kn=ge({__name:"CTAButton",props:{type:{},label:{},loading:{type:Boolean},disabled:{type:Boolean}},setup(e){const t=e;return(n,s)=>(B(),X("button",{type:t.type,disabled:t.disabled,class:"flex justify-center py-2 mt-1 rounded-lg bg-primary-500 dark:bg-primary-400 cursor-pointer disabled:cursor-default"},[t.loading?(B(),X("div",mf,s[0]||(s[0]=[T("div",{class:"loader loader-color-cta h-4 md:h-5"},null,-1)]))):(B(),X("span",gf,St(t.label),1))],8,hf))}}),_f={},yf={id:"listItemSecure"};function vf(e,t){return B(),X("div",yf,t[0]||(t[0]=[T("svg",{xmlns:"http://www.w3.org/2000/svg",width:"24",height:"24",viewBox:"0 0 24 24",class:"w-4 h-4"},[T("path",{fill:"currentColor","fill-rule":"evenodd",d:"M12 1.5a5.25 5.25 0 0 0-5.25 5.25v3a3 3 0 0 0-3 3v6.75a3 3 0 0 0 3 3h10.5a3 3 0 0 0 3-3v-6.75a3 3 0 0 0-3-3v-3c0-2.9-2.35-5.25-5.25-5.25m3.75 8.25v-3a3.75 3.75 0 1 0-7.5 0v3z","clip-rule":"evenodd"})],-1)]))}const bf=hn(_f,[["render",vf]]),xf={},wf={id:"listItemNotSecure"};function Sf(e,t){return B(),X("div",wf,t[0]||(t[0]=[T("svg",{xmlns:"http://www.w3.org/2000/svg",width:"24",height:"24",viewBox:"0 0 24 24",class:"w-4 h-4"},[T("path",{fill:"currentColor",d:"M18 1.5c2.9 0 5.25 2.35 5.25 5.25v3.75a.75.75 0 0 1-1.5 0V6.75a3.75 3.75 0 1 0-7.5 0v3a3 3 0 0 1 3 3v6.75a3 3 0 0 1-3 3H3.75a3 3 0 0 1-3-3v-6.75a3 3 0 0 1 3-3h9v-3c0-2.9 2.35-5.25 5.25-5.25"})],-1)]))}const Ef=hn(xf,[["render",Sf]]),Rf=["data-level"],Cf=ge({__name:"IconRSSI",props:{rssi:{}},setup(e){const t=e,n=Oe(()=>t.rssi>=-50?4:t.rssi>=-60?3:t.rssi>=-70?2:t.rssi>=-80?1:0);return(s,r)=>(B(),X("div",{"data-level":n.value,class:"bg-primary-500 dark:bg-primary-400 flex flex-col p-1.5 rounded-full"},r[0]||(r[0]=[cc('<svg xmlns="http://www.w3.org/2000/svg" width="16" height="16" viewBox="0 0 16 16" class="list-item-rssi w-7 h-7 text-primary-300 dark:text-zinc-600"><path class="rssi-bar" fill="currentColor" fill-rule="evenodd" d="M14.188 7.063a8.75 8.75 0 0 0-12.374 0a.75.75 0 0 1-1.061-1.06c4.003-4.004 10.493-4.004 14.496 0a.75.75 0 1 1-1.061 1.06"></path><path class="rssi-bar" fill="currentColor" fill-rule="evenodd" d="M12.067 9.184a5.75 5.75 0 0 0-8.132 0a.75.75 0 0 1-1.06-1.06a7.25 7.25 0 0 1 10.252 0a.75.75 0 0 1-1.06 1.06"></path><path class="rssi-bar" fill="currentColor" fill-rule="evenodd" d="M9.945 11.306a2.75 2.75 0 0 0-3.889 0a.75.75 0 1 1-1.06-1.061a4.25 4.25 0 0 1 6.01 0a.75.75 0 0 1-1.06 1.06"></path><path class="rssi-bar" fill="currentColor" fill-rule="evenodd" d="M7.117 12.366a1.25 1.25 0 0 1 1.768 0a.75.75 0 0 1 0 1.06l-.355.355a.75.75 0 0 1-1.06 0l-.354-.354a.75.75 0 0 1 0-1.06"></path></svg>',1)]),8,Rf))}}),Pf={class:"grow flex items-center gap-x-1.5"},Of={class:"text-size-xl text-color-title inline font-semibold wrap-anywhere"},Af=ge({__name:"NetworkCard",props:{network:{}},emits:["selected"],setup(e){const t=e;return(n,s)=>(B(),X("button",{type:"button",class:"w-full p-3 rounded-lg bg-primary-50 dark:bg-zinc-900 border flex border-primary-300 dark:border-primary-400 cursor-pointer",onClick:s[0]||(s[0]=r=>n.$emit("selected",n.network.ssid))},[T("aside",Pf,[T("span",Of,St(t.network.ssid),1),t.network.secure?(B(),ft(bf,{key:0,class:"text-color-title relative -top-0.5"})):(B(),ft(Ef,{key:1,class:"text-color-title relative -top-0.5"}))]),K(Cf,{rssi:t.network.rssi},null,8,["rssi"])]))}}),Tf={},Mf={xmlns:"http://www.w3.org/2000/svg",width:"16",height:"16",viewBox:"0 0 16 16"};function $f(e,t){return B(),X("svg",Mf,t[0]||(t[0]=[T("path",{fill:"currentColor","fill-rule":"evenodd",d:"M8 3.5q-1.157 0-2.297.066a1.124 1.124 0 0 0-1.058 1.028l-.018.214a.75.75 0 1 1-1.495-.12l.018-.221a2.624 2.624 0 0 1 2.467-2.399a42 42 0 0 1 4.766 0a2.624 2.624 0 0 1 2.467 2.399q.084.993.122 2l.748-.748a.75.75 0 1 1 1.06 1.06l-2 2.001a.75.75 0 0 1-1.061 0l-2-1.999a.75.75 0 0 1 1.061-1.06l.689.688a40 40 0 0 0-.114-1.815a1.124 1.124 0 0 0-1.058-1.028A40 40 0 0 0 8 3.5M3.22 7.22a.75.75 0 0 1 1.061 0l2 2a.75.75 0 1 1-1.06 1.06l-.69-.69q.037.914.114 1.816c.048.56.496.996 1.058 1.028a40 40 0 0 0 4.594 0a1.124 1.124 0 0 0 1.058-1.028l.018-.219a.75.75 0 1 1 1.495.12l-.018.226a2.624 2.624 0 0 1-2.467 2.399a42 42 0 0 1-4.766 0a2.624 2.624 0 0 1-2.467-2.399a41 41 0 0 1-.122-2l-.748.748A.75.75 0 1 1 1.22 9.22z","clip-rule":"evenodd"},null,-1)]))}const Ur=hn(Tf,[["render",$f]]);function If(e){return{all:e=e||new Map,on:function(t,n){var s=e.get(t);s?s.push(n):e.set(t,[n])},off:function(t,n){var s=e.get(t);s&&(n?s.splice(s.indexOf(n)>>>0,1):e.set(t,[]))},emit:function(t,n){var s=e.get(t);s&&s.slice().map(function(r){r(n)}),(s=e.get("*"))&&s.slice().map(function(r){r(t,n)})}}}const Kr=If();function Us(){return{emitter:Kr.emit,listener:Kr.on}}const kf={class:"max-w-2xl mx-auto px-8"},Lf={class:"flex flex-col justify-center gap-y-5 md:gap-y-8"},Nf={key:0,class:"flex justify-center py-10"},Ff={key:1},jf={key:0,class:"flex flex-col gap-y-2"},Vf={class:"flex justify-between items-center"},Hf={class:"flex flex-col gap-y-2.5"},Df={key:1,class:"flex flex-col justify-center items-center text-center py-10 gap-y-1"},Bf={key:2,class:"flex flex-col gap-y-3.5"},Uf=ge({__name:"WiFiView",setup(e){const t=fn({ssid:"",password:""}),n=et(),s=et(!1),r=et(!1),o=Eo("passwordInput"),i=sf(),{emitter:l}=Us();async function c(){r.value=!0;try{{const p=await fetch("/scan").then(h=>h.json());n.value=p}}catch{l("layout:error")}finally{r.value=!1}}async function d(){s.value=!0;try{await fetch("/setup/wifi",{method:"POST",body:JSON.stringify({ssid:t.ssid,password:t.password})}),Bs().setConfirmAccess(!0),await i.push({name:"confirm-challenge"})}catch{l("layout:error")}finally{s.value=!1}}function f(p){t.ssid=p,o.value&&o.value.focus()}return(p,h)=>(B(),X("div",kf,[T("div",Lf,[h[6]||(h[6]=T("section",null,[T("h1",{class:"text-size-3xl text-color-title font-bold"},"Configuración WiFi"),T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ")],-1)),T("form",{onSubmit:qc(d,["prevent"]),class:"flex flex-col gap-y-2.5"},[K(Br,{modelValue:t.ssid,"onUpdate:modelValue":h[0]||(h[0]=g=>t.ssid=g),type:"text",id:"ssidInput",label:"Nombre de la red"},null,8,["modelValue"]),K(Br,{ref:"passwordInput",modelValue:t.password,"onUpdate:modelValue":h[1]||(h[1]=g=>t.password=g),type:"password",id:"passwordInput",label:"Contraseña"},null,8,["modelValue"]),K(kn,{type:"submit",label:"Guardar",loading:s.value,disabled:s.value||r.value},null,8,["loading","disabled"])],32),T("section",null,[r.value?(B(),X("div",Nf,h[2]||(h[2]=[T("div",{class:"loader loader-color-primary h-5 md:h-6"},null,-1)]))):n.value?(B(),X("div",Ff,[n.value.length?(B(),X("div",jf,[T("aside",Vf,[h[3]||(h[3]=T("h3",{class:"text-size-2xl text-color-title font-bold"},"Redes encontradas:",-1)),T("button",{type:"button",onClick:c,class:"cursor-pointer"},[K(Ur,{class:"w-8 h-8 md:w-9 md:h-9 p-0.5 text-color-title"})])]),T("ul",Hf,[(B(!0),X(Ee,null,Pl(n.value,(g,C)=>(B(),X("li",{key:C},[K(Af,{network:g,onSelected:f},null,8,["network"])]))),128))])])):(B(),X("div",Df,[h[4]||(h[4]=T("span",{class:"text-color-title text-size-xl px-4 font-bold"},"No se encontró ninguna red",-1)),T("button",{type:"button",onClick:c,class:"cursor-pointer"},[K(Ur,{class:"w-8 h-8 md:w-9 md:h-9 p-0.5 text-color-title"})])]))])):(B(),X("div",Bf,[h[5]||(h[5]=T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ",-1)),K(kn,{onClick:c,type:"button",label:"Escanear",loading:!1,disabled:s.value||r.value},null,8,["disabled"])]))])])]))}}),Kf=["type","disabled"],zf={key:0,class:"py-1"},Wf={key:1,class:"text-zinc-500 dark:text-zinc-50 relative top-0.5 font-bold uppercase"},qf=ge({__name:"CancelButton",props:{type:{},label:{},loading:{type:Boolean},disabled:{type:Boolean}},setup(e){const t=e;return(n,s)=>(B(),X("button",{type:t.type,disabled:t.disabled,class:"flex justify-center py-2 mt-1 rounded-lg bg-zinc-300 dark:bg-zinc-700 cursor-pointer disabled:cursor-default"},[t.loading?(B(),X("div",zf,s[0]||(s[0]=[T("div",{class:"loader loader-color-cancel h-4 md:h-5"},null,-1)]))):(B(),X("span",Wf,St(t.label),1))],8,Kf))}}),Gf={class:"text-zinc-50 w-min text-nowrap dark:text-zinc-950 relative top-0.5 font-bold uppercase"},yi=ge({__name:"LinkButton",props:{to:{},label:{}},setup(e){const t=e;return(n,s)=>{const r=Un("RouterLink");return B(),ft(r,{to:t.to,class:"flex justify-center bg-primary-500 dark:bg-primary-400 py-2 px-6 mt-1 rounded-lg cursor-pointer disabled:cursor-default"},{default:dn(()=>[T("span",Gf,St(t.label),1)]),_:1},8,["to"])}}}),Yf={class:"max-w-2xl grow mx-auto px-8 flex flex-col justify-center gap-y-3 md:gap-y-6"},Jf={class:"flex gap-x-3"},Qf={class:"flex flex-col items-center gap-y-3 mt-6"},Xf=ge({__name:"ConfirmView",setup(e){const t=et(!1),n=et(!1),{emitter:s}=Us();async function r(){n.value=!0;try{await fetch("/close",{method:"POST"}),s("layout:end")}catch{s("layout:error")}finally{n.value=!1}}async function o(){t.value=!0;try{await fetch("/setup",{method:"POST"}),s("layout:end")}catch{s("layout:error")}finally{t.value=!1}}return qu(()=>{Bs().setConfirmAccess(!1)}),(i,l)=>(B(),X("div",Yf,[l[1]||(l[1]=T("section",null,[T("h1",{class:"text-size-3xl text-color-title font-bold"},"Confirmar cambios"),T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ")],-1)),T("div",Jf,[K(qf,{type:"button",label:"Cancelar",loading:n.value,disabled:n.value||t.value,class:"w-full",onClick:r},null,8,["loading","disabled"]),K(kn,{type:"button",label:"Confirmar",loading:t.value,disabled:n.value||t.value,class:"w-full",onClick:o},null,8,["loading","disabled"])]),T("section",Qf,[l[0]||(l[0]=T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ",-1)),K(yi,{to:{name:"home"},label:"Seguir editando",class:"self-center"})])]))}}),Zf={class:"max-w-2xl grow mx-auto px-8 flex flex-col justify-center gap-y-3 md:gap-y-6"},ea=ge({__name:"NotFoundView",setup(e){return(t,n)=>(B(),X("div",Zf,[n[0]||(n[0]=T("section",null,[T("h1",{class:"text-size-3xl text-color-title font-bold"},"Página no encontrada"),T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ")],-1)),K(yi,{to:{name:"home"},label:"Página principal",class:"self-center"})]))}}),ta=[{path:"/",name:"home",component:uf},{path:"/wifi",name:"wifi",component:Uf},{path:"/:pathMatch(.*)*",name:"404",component:ea},{path:"/confirm-challenge",name:"confirm-challenge",component:Xf,beforeEnter:function(e,t,n){Bs().confirmAccess.value?n():n({name:"home"})}}],na=tf({history:Au(),routes:ta}),sa={},ra={xmlns:"http://www.w3.org/2000/svg",width:"496",height:"512",viewBox:"0 0 496 512"};function oa(e,t){return B(),X("svg",ra,t[0]||(t[0]=[T("path",{fill:"currentColor",d:"M165.9 397.4c0 2-2.3 3.6-5.2 3.6c-3.3.3-5.6-1.3-5.6-3.6c0-2 2.3-3.6 5.2-3.6c3-.3 5.6 1.3 5.6 3.6m-31.1-4.5c-.7 2 1.3 4.3 4.3 4.9c2.6 1 5.6 0 6.2-2s-1.3-4.3-4.3-5.2c-2.6-.7-5.5.3-6.2 2.3m44.2-1.7c-2.9.7-4.9 2.6-4.6 4.9c.3 2 2.9 3.3 5.9 2.6c2.9-.7 4.9-2.6 4.6-4.6c-.3-1.9-3-3.2-5.9-2.9M244.8 8C106.1 8 0 113.3 0 252c0 110.9 69.8 205.8 169.5 239.2c12.8 2.3 17.3-5.6 17.3-12.1c0-6.2-.3-40.4-.3-61.4c0 0-70 15-84.7-29.8c0 0-11.4-29.1-27.8-36.6c0 0-22.9-15.7 1.6-15.4c0 0 24.9 2 38.6 25.8c21.9 38.6 58.6 27.5 72.9 20.9c2.3-16 8.8-27.1 16-33.7c-55.9-6.2-112.3-14.3-112.3-110.5c0-27.5 7.6-41.3 23.6-58.9c-2.6-6.5-11.1-33.3 2.6-67.9c20.9-6.5 69 27 69 27c20-5.6 41.5-8.5 62.8-8.5s42.8 2.9 62.8 8.5c0 0 48.1-33.6 69-27c13.7 34.7 5.2 61.4 2.6 67.9c16 17.7 25.8 31.5 25.8 58.9c0 96.5-58.9 104.2-114.8 110.5c9.2 7.9 17 22.9 17 46.4c0 33.7-.3 75.4-.3 83.6c0 6.5 4.6 14.4 17.3 12.1C428.2 457.8 496 362.9 496 252C496 113.3 383.5 8 244.8 8M97.2 352.9c-1.3 1-1 3.3.7 5.2c1.6 1.6 3.9 2.3 5.2 1c1.3-1 1-3.3-.7-5.2c-1.6-1.6-3.9-2.3-5.2-1m-10.8-8.1c-.7 1.3.3 2.9 2.3 3.9c1.6 1 3.6.7 4.3-.7c.7-1.3-.3-2.9-2.3-3.9c-2-.6-3.6-.3-4.3.7m32.4 35.6c-1.6 1.3-1 4.3 1.3 6.2c2.3 2.3 5.2 2.6 6.5 1c1.3-1.3.7-4.3-1.3-6.2c-2.2-2.3-5.2-2.6-6.5-1m-11.4-14.7c-1.6 1-1.6 3.6 0 5.9s4.3 3.3 5.6 2.3c1.6-1.3 1.6-3.9 0-6.2c-1.4-2.3-4-3.3-5.6-2"},null,-1)]))}const vi=hn(sa,[["render",oa]]),ia={class:"text-size-base text-color-body dark:bg-zinc-950 bg-zinc-50 font-display"},la={class:"min-h-dvh flex flex-col items-center"},ca={class:"divider flex justify-between items-center w-full px-6 h-14"},ua={href:"https://github.com/vircoding",target:"_blank"},fa={class:"divider flex flex-col grow w-full py-10"},aa={class:"text-center pt-3 pb-[10px]"},da={class:"text-color-title font-semibold"},pa=ge({__name:"Layout",setup(e){const t=new Date().getFullYear();return(n,s)=>{const r=Un("RouterLink");return B(),X("div",ia,[T("div",la,[T("header",ca,[K(r,{to:{name:"home"}},{default:dn(()=>s[0]||(s[0]=[T("h3",{class:"text-color-title text-2xl font-bold"},"HomeSphere",-1)])),_:1}),T("nav",null,[T("a",ua,[K(vi,{class:"icon-link w-6 h-6"})])])]),T("main",fa,[Ol(n.$slots,"default")]),T("footer",aa,[T("span",da,"© "+St(bt(t))+", La Habana, Cuba",1)])])])}}}),ha={class:"absolute top-0 left-0 right-0 bottom-0 text-size-base text-color-body dark:bg-zinc-950 bg-zinc-50 font-display"},ma={class:"min-h-dvh flex flex-col items-center"},ga={class:"divider flex flex-col grow w-full py-10"},_a={class:"max-w-2xl grow mx-auto px-8 flex flex-col justify-center items-center gap-y-3 md:gap-y-6"},ya={href:"https://github.com/vircoding",target:"_blank",class:"inline-block mt-5"},va=ge({__name:"SuccessModal",setup(e){return(t,n)=>(B(),X("div",ha,[T("div",ma,[T("main",ga,[T("div",_a,[n[0]||(n[0]=T("section",{class:"text-center"},[T("h1",{class:"text-size-3xl text-color-title font-bold mb-3"},"HomeSphere reinciado"),T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ")],-1)),T("a",ya,[K(vi,{class:"icon-link w-10 h-10"})])])])])]))}}),ba={class:"absolute top-0 left-0 right-0 bottom-0 text-size-base text-color-body dark:bg-zinc-950 bg-zinc-50 font-display"},xa={class:"min-h-dvh flex flex-col items-center"},wa={class:"divider flex flex-col grow w-full py-10"},Sa={class:"max-w-2xl grow mx-auto px-8 flex flex-col justify-center items-center gap-y-3 md:gap-y-6"},Ea=ge({__name:"ErrorModal",setup(e){function t(){window.location.reload()}return(n,s)=>(B(),X("div",ba,[T("div",xa,[T("main",wa,[T("div",Sa,[s[0]||(s[0]=T("section",null,[T("h1",{class:"text-size-3xl text-color-title font-bold"},"Error inesperado"),T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ")],-1)),K(kn,{type:"button",label:"Refrescar",loading:!1,disabled:!1,class:"px-6",onClick:t})])])])]))}}),Ra={class:"relative"},Ca=ge({__name:"App",setup(e){const t=et(!1),n=et(!1),{listener:s}=Us();return s("layout:end",()=>{t.value=!0}),s("layout:error",()=>{n.value=!0}),(r,o)=>{const i=Un("RouterView");return B(),X("div",Ra,[K(pa,null,{default:dn(()=>[K(i)]),_:1}),t.value?(B(),ft(va,{key:0})):ir("",!0),n.value?(B(),ft(Ea,{key:1})):ir("",!0)])}}}),bi=Jc(Ca);bi.use(na);bi.mount("#app");
+  */const At=typeof document<"u";function si(e){return typeof e=="object"||"displayName"in e||"props"in e||"__vccOpts"in e}function Zc(e){return e.__esModule||e[Symbol.toStringTag]==="Module"||e.default&&si(e.default)}const q=Object.assign;function rs(e,t){const n={};for(const s in t){const r=t[s];n[s]=ke(r)?r.map(e):e(r)}return n}const Xt=()=>{},ke=Array.isArray,ri=/#/g,eu=/&/g,tu=/\//g,nu=/=/g,su=/\?/g,oi=/\+/g,ru=/%5B/g,ou=/%5D/g,ii=/%5E/g,iu=/%60/g,li=/%7B/g,lu=/%7C/g,ci=/%7D/g,cu=/%20/g;function Ds(e){return encodeURI(""+e).replace(lu,"|").replace(ru,"[").replace(ou,"]")}function uu(e){return Ds(e).replace(li,"{").replace(ci,"}").replace(ii,"^")}function ys(e){return Ds(e).replace(oi,"%2B").replace(cu,"+").replace(ri,"%23").replace(eu,"%26").replace(iu,"`").replace(li,"{").replace(ci,"}").replace(ii,"^")}function fu(e){return ys(e).replace(nu,"%3D")}function au(e){return Ds(e).replace(ri,"%23").replace(su,"%3F")}function du(e){return e==null?"":au(e).replace(tu,"%2F")}function ln(e){try{return decodeURIComponent(""+e)}catch{}return""+e}const pu=/\/$/,hu=e=>e.replace(pu,"");function os(e,t,n="/"){let s,r={},o="",i="";const l=t.indexOf("#");let c=t.indexOf("?");return l<c&&l>=0&&(c=-1),c>-1&&(s=t.slice(0,c),o=t.slice(c+1,l>-1?l:t.length),r=e(o)),l>-1&&(s=s||t.slice(0,l),i=t.slice(l,t.length)),s=yu(s??t,n),{fullPath:s+(o&&"?")+o+i,path:s,query:r,hash:ln(i)}}function mu(e,t){const n=t.query?e(t.query):"";return t.path+(n&&"?")+n+(t.hash||"")}function Rr(e,t){return!t||!e.toLowerCase().startsWith(t.toLowerCase())?e:e.slice(t.length)||"/"}function gu(e,t,n){const s=t.matched.length-1,r=n.matched.length-1;return s>-1&&s===r&&jt(t.matched[s],n.matched[r])&&ui(t.params,n.params)&&e(t.query)===e(n.query)&&t.hash===n.hash}function jt(e,t){return(e.aliasOf||e)===(t.aliasOf||t)}function ui(e,t){if(Object.keys(e).length!==Object.keys(t).length)return!1;for(const n in e)if(!_u(e[n],t[n]))return!1;return!0}function _u(e,t){return ke(e)?Cr(e,t):ke(t)?Cr(t,e):e===t}function Cr(e,t){return ke(t)?e.length===t.length&&e.every((n,s)=>n===t[s]):e.length===1&&e[0]===t}function yu(e,t){if(e.startsWith("/"))return e;if(!e)return t;const n=t.split("/"),s=e.split("/"),r=s[s.length-1];(r===".."||r===".")&&s.push("");let o=n.length-1,i,l;for(i=0;i<s.length;i++)if(l=s[i],l!==".")if(l==="..")o>1&&o--;else break;return n.slice(0,o).join("/")+"/"+s.slice(i).join("/")}const ot={path:"/",name:void 0,params:{},query:{},hash:"",fullPath:"/",matched:[],meta:{},redirectedFrom:void 0};var cn;(function(e){e.pop="pop",e.push="push"})(cn||(cn={}));var Zt;(function(e){e.back="back",e.forward="forward",e.unknown=""})(Zt||(Zt={}));function vu(e){if(!e)if(At){const t=document.querySelector("base");e=t&&t.getAttribute("href")||"/",e=e.replace(/^\w+:\/\/[^\/]+/,"")}else e="/";return e[0]!=="/"&&e[0]!=="#"&&(e="/"+e),hu(e)}const bu=/^[^#]+#/;function xu(e,t){return e.replace(bu,"#")+t}function wu(e,t){const n=document.documentElement.getBoundingClientRect(),s=e.getBoundingClientRect();return{behavior:t.behavior,left:s.left-n.left-(t.left||0),top:s.top-n.top-(t.top||0)}}const qn=()=>({left:window.scrollX,top:window.scrollY});function Su(e){let t;if("el"in e){const n=e.el,s=typeof n=="string"&&n.startsWith("#"),r=typeof n=="string"?s?document.getElementById(n.slice(1)):document.querySelector(n):n;if(!r)return;t=wu(r,e)}else t=e;"scrollBehavior"in document.documentElement.style?window.scrollTo(t):window.scrollTo(t.left!=null?t.left:window.scrollX,t.top!=null?t.top:window.scrollY)}function Pr(e,t){return(history.state?history.state.position-t:-1)+e}const vs=new Map;function Eu(e,t){vs.set(e,t)}function Ru(e){const t=vs.get(e);return vs.delete(e),t}let Cu=()=>location.protocol+"//"+location.host;function fi(e,t){const{pathname:n,search:s,hash:r}=t,o=e.indexOf("#");if(o>-1){let l=r.includes(e.slice(o))?e.slice(o).length:1,c=r.slice(l);return c[0]!=="/"&&(c="/"+c),Rr(c,"")}return Rr(n,e)+s+r}function Pu(e,t,n,s){let r=[],o=[],i=null;const l=({state:h})=>{const g=fi(e,location),C=n.value,P=t.value;let D=0;if(h){if(n.value=g,t.value=h,i&&i===C){i=null;return}D=P?h.position-P.position:0}else s(g);r.forEach(N=>{N(n.value,C,{delta:D,type:cn.pop,direction:D?D>0?Zt.forward:Zt.back:Zt.unknown})})};function c(){i=n.value}function d(h){r.push(h);const g=()=>{const C=r.indexOf(h);C>-1&&r.splice(C,1)};return o.push(g),g}function f(){const{history:h}=window;h.state&&h.replaceState(q({},h.state,{scroll:qn()}),"")}function p(){for(const h of o)h();o=[],window.removeEventListener("popstate",l),window.removeEventListener("beforeunload",f)}return window.addEventListener("popstate",l),window.addEventListener("beforeunload",f,{passive:!0}),{pauseListeners:c,listen:d,destroy:p}}function Or(e,t,n,s=!1,r=!1){return{back:e,current:t,forward:n,replaced:s,position:window.history.length,scroll:r?qn():null}}function Ou(e){const{history:t,location:n}=window,s={value:fi(e,n)},r={value:t.state};r.value||o(s.value,{back:null,current:s.value,forward:null,position:t.length-1,replaced:!0,scroll:null},!0);function o(c,d,f){const p=e.indexOf("#"),h=p>-1?(n.host&&document.querySelector("base")?e:e.slice(p))+c:Cu()+e+c;try{t[f?"replaceState":"pushState"](d,"",h),r.value=d}catch(g){console.error(g),n[f?"replace":"assign"](h)}}function i(c,d){const f=q({},t.state,Or(r.value.back,c,r.value.forward,!0),d,{position:r.value.position});o(c,f,!0),s.value=c}function l(c,d){const f=q({},r.value,t.state,{forward:c,scroll:qn()});o(f.current,f,!0);const p=q({},Or(s.value,c,null),{position:f.position+1},d);o(c,p,!1),s.value=c}return{location:s,state:r,push:l,replace:i}}function Au(e){e=vu(e);const t=Ou(e),n=Pu(e,t.state,t.location,t.replace);function s(o,i=!0){i||n.pauseListeners(),history.go(o)}const r=q({location:"",base:e,go:s,createHref:xu.bind(null,e)},t,n);return Object.defineProperty(r,"location",{enumerable:!0,get:()=>t.location.value}),Object.defineProperty(r,"state",{enumerable:!0,get:()=>t.state.value}),r}function Tu(e){return typeof e=="string"||e&&typeof e=="object"}function ai(e){return typeof e=="string"||typeof e=="symbol"}const di=Symbol("");var Ar;(function(e){e[e.aborted=4]="aborted",e[e.cancelled=8]="cancelled",e[e.duplicated=16]="duplicated"})(Ar||(Ar={}));function Vt(e,t){return q(new Error,{type:e,[di]:!0},t)}function Ye(e,t){return e instanceof Error&&di in e&&(t==null||!!(e.type&t))}const Tr="[^/]+?",Mu={sensitive:!1,strict:!1,start:!0,end:!0},$u=/[.+*?^${}()[\]/\\]/g;function Iu(e,t){const n=q({},Mu,t),s=[];let r=n.start?"^":"";const o=[];for(const d of e){const f=d.length?[]:[90];n.strict&&!d.length&&(r+="/");for(let p=0;p<d.length;p++){const h=d[p];let g=40+(n.sensitive?.25:0);if(h.type===0)p||(r+="/"),r+=h.value.replace($u,"\\$&"),g+=40;else if(h.type===1){const{value:C,repeatable:P,optional:D,regexp:N}=h;o.push({name:C,repeatable:P,optional:D});const I=N||Tr;if(I!==Tr){g+=10;try{new RegExp(`(${I})`)}catch(M){throw new Error(`Invalid custom RegExp for param "${C}" (${I}): `+M.message)}}let F=P?`((?:${I})(?:/(?:${I}))*)`:`(${I})`;p||(F=D&&d.length<2?`(?:/${F})`:"/"+F),D&&(F+="?"),r+=F,g+=20,D&&(g+=-8),P&&(g+=-20),I===".*"&&(g+=-50)}f.push(g)}s.push(f)}if(n.strict&&n.end){const d=s.length-1;s[d][s[d].length-1]+=.7000000000000001}n.strict||(r+="/?"),n.end?r+="$":n.strict&&!r.endsWith("/")&&(r+="(?:/|$)");const i=new RegExp(r,n.sensitive?"":"i");function l(d){const f=d.match(i),p={};if(!f)return null;for(let h=1;h<f.length;h++){const g=f[h]||"",C=o[h-1];p[C.name]=g&&C.repeatable?g.split("/"):g}return p}function c(d){let f="",p=!1;for(const h of e){(!p||!f.endsWith("/"))&&(f+="/"),p=!1;for(const g of h)if(g.type===0)f+=g.value;else if(g.type===1){const{value:C,repeatable:P,optional:D}=g,N=C in d?d[C]:"";if(ke(N)&&!P)throw new Error(`Provided param "${C}" is an array but it is not repeatable (* or + modifiers)`);const I=ke(N)?N.join("/"):N;if(!I)if(D)h.length<2&&(f.endsWith("/")?f=f.slice(0,-1):p=!0);else throw new Error(`Missing required param "${C}"`);f+=I}}return f||"/"}return{re:i,score:s,keys:o,parse:l,stringify:c}}function ku(e,t){let n=0;for(;n<e.length&&n<t.length;){const s=t[n]-e[n];if(s)return s;n++}return e.length<t.length?e.length===1&&e[0]===80?-1:1:e.length>t.length?t.length===1&&t[0]===80?1:-1:0}function pi(e,t){let n=0;const s=e.score,r=t.score;for(;n<s.length&&n<r.length;){const o=ku(s[n],r[n]);if(o)return o;n++}if(Math.abs(r.length-s.length)===1){if(Mr(s))return 1;if(Mr(r))return-1}return r.length-s.length}function Mr(e){const t=e[e.length-1];return e.length>0&&t[t.length-1]<0}const Lu={type:0,value:""},Nu=/[a-zA-Z0-9_]/;function Fu(e){if(!e)return[[]];if(e==="/")return[[Lu]];if(!e.startsWith("/"))throw new Error(`Invalid path "${e}"`);function t(g){throw new Error(`ERR (${n})/"${d}": ${g}`)}let n=0,s=n;const r=[];let o;function i(){o&&r.push(o),o=[]}let l=0,c,d="",f="";function p(){d&&(n===0?o.push({type:0,value:d}):n===1||n===2||n===3?(o.length>1&&(c==="*"||c==="+")&&t(`A repeatable param (${d}) must be alone in its segment. eg: '/:ids+.`),o.push({type:1,value:d,regexp:f,repeatable:c==="*"||c==="+",optional:c==="*"||c==="?"})):t("Invalid state to consume buffer"),d="")}function h(){d+=c}for(;l<e.length;){if(c=e[l++],c==="\\"&&n!==2){s=n,n=4;continue}switch(n){case 0:c==="/"?(d&&p(),i()):c===":"?(p(),n=1):h();break;case 4:h(),n=s;break;case 1:c==="("?n=2:Nu.test(c)?h():(p(),n=0,c!=="*"&&c!=="?"&&c!=="+"&&l--);break;case 2:c===")"?f[f.length-1]=="\\"?f=f.slice(0,-1)+c:n=3:f+=c;break;case 3:p(),n=0,c!=="*"&&c!=="?"&&c!=="+"&&l--,f="";break;default:t("Unknown state");break}}return n===2&&t(`Unfinished custom RegExp for param "${d}"`),p(),i(),r}function ju(e,t,n){const s=Iu(Fu(e.path),n),r=q(s,{record:e,parent:t,children:[],alias:[]});return t&&!r.record.aliasOf==!t.record.aliasOf&&t.children.push(r),r}function Vu(e,t){const n=[],s=new Map;t=Lr({strict:!1,end:!0,sensitive:!1},t);function r(p){return s.get(p)}function o(p,h,g){const C=!g,P=Ir(p);P.aliasOf=g&&g.record;const D=Lr(t,p),N=[P];if("alias"in p){const M=typeof p.alias=="string"?[p.alias]:p.alias;for(const Z of M)N.push(Ir(q({},P,{components:g?g.record.components:P.components,path:Z,aliasOf:g?g.record:P})))}let I,F;for(const M of N){const{path:Z}=M;if(h&&Z[0]!=="/"){const ce=h.record.path,re=ce[ce.length-1]==="/"?"":"/";M.path=h.record.path+(Z&&re+Z)}if(I=ju(M,h,D),g?g.alias.push(I):(F=F||I,F!==I&&F.alias.push(I),C&&p.name&&!kr(I)&&i(p.name)),hi(I)&&c(I),P.children){const ce=P.children;for(let re=0;re<ce.length;re++)o(ce[re],I,g&&g.children[re])}g=g||I}return F?()=>{i(F)}:Xt}function i(p){if(ai(p)){const h=s.get(p);h&&(s.delete(p),n.splice(n.indexOf(h),1),h.children.forEach(i),h.alias.forEach(i))}else{const h=n.indexOf(p);h>-1&&(n.splice(h,1),p.record.name&&s.delete(p.record.name),p.children.forEach(i),p.alias.forEach(i))}}function l(){return n}function c(p){const h=Bu(p,n);n.splice(h,0,p),p.record.name&&!kr(p)&&s.set(p.record.name,p)}function d(p,h){let g,C={},P,D;if("name"in p&&p.name){if(g=s.get(p.name),!g)throw Vt(1,{location:p});D=g.record.name,C=q($r(h.params,g.keys.filter(F=>!F.optional).concat(g.parent?g.parent.keys.filter(F=>F.optional):[]).map(F=>F.name)),p.params&&$r(p.params,g.keys.map(F=>F.name))),P=g.stringify(C)}else if(p.path!=null)P=p.path,g=n.find(F=>F.re.test(P)),g&&(C=g.parse(P),D=g.record.name);else{if(g=h.name?s.get(h.name):n.find(F=>F.re.test(h.path)),!g)throw Vt(1,{location:p,currentLocation:h});D=g.record.name,C=q({},h.params,p.params),P=g.stringify(C)}const N=[];let I=g;for(;I;)N.unshift(I.record),I=I.parent;return{name:D,path:P,params:C,matched:N,meta:Du(N)}}e.forEach(p=>o(p));function f(){n.length=0,s.clear()}return{addRoute:o,resolve:d,removeRoute:i,clearRoutes:f,getRoutes:l,getRecordMatcher:r}}function $r(e,t){const n={};for(const s of t)s in e&&(n[s]=e[s]);return n}function Ir(e){const t={path:e.path,redirect:e.redirect,name:e.name,meta:e.meta||{},aliasOf:e.aliasOf,beforeEnter:e.beforeEnter,props:Hu(e),children:e.children||[],instances:{},leaveGuards:new Set,updateGuards:new Set,enterCallbacks:{},components:"components"in e?e.components||null:e.component&&{default:e.component}};return Object.defineProperty(t,"mods",{value:{}}),t}function Hu(e){const t={},n=e.props||!1;if("component"in e)t.default=n;else for(const s in e.components)t[s]=typeof n=="object"?n[s]:n;return t}function kr(e){for(;e;){if(e.record.aliasOf)return!0;e=e.parent}return!1}function Du(e){return e.reduce((t,n)=>q(t,n.meta),{})}function Lr(e,t){const n={};for(const s in e)n[s]=s in t?t[s]:e[s];return n}function Bu(e,t){let n=0,s=t.length;for(;n!==s;){const o=n+s>>1;pi(e,t[o])<0?s=o:n=o+1}const r=Uu(e);return r&&(s=t.lastIndexOf(r,s-1)),s}function Uu(e){let t=e;for(;t=t.parent;)if(hi(t)&&pi(e,t)===0)return t}function hi({record:e}){return!!(e.name||e.components&&Object.keys(e.components).length||e.redirect)}function Ku(e){const t={};if(e===""||e==="?")return t;const s=(e[0]==="?"?e.slice(1):e).split("&");for(let r=0;r<s.length;++r){const o=s[r].replace(oi," "),i=o.indexOf("="),l=ln(i<0?o:o.slice(0,i)),c=i<0?null:ln(o.slice(i+1));if(l in t){let d=t[l];ke(d)||(d=t[l]=[d]),d.push(c)}else t[l]=c}return t}function Nr(e){let t="";for(let n in e){const s=e[n];if(n=fu(n),s==null){s!==void 0&&(t+=(t.length?"&":"")+n);continue}(ke(s)?s.map(o=>o&&ys(o)):[s&&ys(s)]).forEach(o=>{o!==void 0&&(t+=(t.length?"&":"")+n,o!=null&&(t+="="+o))})}return t}function zu(e){const t={};for(const n in e){const s=e[n];s!==void 0&&(t[n]=ke(s)?s.map(r=>r==null?null:""+r):s==null?s:""+s)}return t}const mi=Symbol(""),Fr=Symbol(""),Gn=Symbol(""),gi=Symbol(""),bs=Symbol("");function zt(){let e=[];function t(s){return e.push(s),()=>{const r=e.indexOf(s);r>-1&&e.splice(r,1)}}function n(){e=[]}return{add:t,list:()=>e.slice(),reset:n}}function Wu(e,t,n){const s=()=>{e[t].delete(n)};Fs(s),Po(s),Co(()=>{e[t].add(n)}),e[t].add(n)}function qu(e){const t=$e(mi,{}).value;t&&Wu(t,"leaveGuards",e)}function ct(e,t,n,s,r,o=i=>i()){const i=s&&(s.enterCallbacks[r]=s.enterCallbacks[r]||[]);return()=>new Promise((l,c)=>{const d=h=>{h===!1?c(Vt(4,{from:n,to:t})):h instanceof Error?c(h):Tu(h)?c(Vt(2,{from:t,to:h})):(i&&s.enterCallbacks[r]===i&&typeof h=="function"&&i.push(h),l())},f=o(()=>e.call(s&&s.instances[r],t,n,d));let p=Promise.resolve(f);e.length<3&&(p=p.then(d)),p.catch(h=>c(h))})}function is(e,t,n,s,r=o=>o()){const o=[];for(const i of e)for(const l in i.components){let c=i.components[l];if(!(t!=="beforeRouteEnter"&&!i.instances[l]))if(si(c)){const f=(c.__vccOpts||c)[t];f&&o.push(ct(f,n,s,i,l,r))}else{let d=c();o.push(()=>d.then(f=>{if(!f)throw new Error(`Couldn't resolve component "${l}" at "${i.path}"`);const p=Zc(f)?f.default:f;i.mods[l]=f,i.components[l]=p;const g=(p.__vccOpts||p)[t];return g&&ct(g,n,s,i,l,r)()}))}}return o}function jr(e){const t=$e(Gn),n=$e(gi),s=Oe(()=>{const c=bt(e.to);return t.resolve(c)}),r=Oe(()=>{const{matched:c}=s.value,{length:d}=c,f=c[d-1],p=n.matched;if(!f||!p.length)return-1;const h=p.findIndex(jt.bind(null,f));if(h>-1)return h;const g=Vr(c[d-2]);return d>1&&Vr(f)===g&&p[p.length-1].path!==g?p.findIndex(jt.bind(null,c[d-2])):h}),o=Oe(()=>r.value>-1&&Xu(n.params,s.value.params)),i=Oe(()=>r.value>-1&&r.value===n.matched.length-1&&ui(n.params,s.value.params));function l(c={}){if(Qu(c)){const d=t[bt(e.replace)?"replace":"push"](bt(e.to)).catch(Xt);return e.viewTransition&&typeof document<"u"&&"startViewTransition"in document&&document.startViewTransition(()=>d),d}return Promise.resolve()}return{route:s,href:Oe(()=>s.value.href),isActive:o,isExactActive:i,navigate:l}}function Gu(e){return e.length===1?e[0]:e}const Yu=ge({name:"RouterLink",compatConfig:{MODE:3},props:{to:{type:[String,Object],required:!0},replace:Boolean,activeClass:String,exactActiveClass:String,custom:Boolean,ariaCurrentValue:{type:String,default:"page"}},useLink:jr,setup(e,{slots:t}){const n=fn(jr(e)),{options:s}=$e(Gn),r=Oe(()=>({[Hr(e.activeClass,s.linkActiveClass,"router-link-active")]:n.isActive,[Hr(e.exactActiveClass,s.linkExactActiveClass,"router-link-exact-active")]:n.isExactActive}));return()=>{const o=t.default&&Gu(t.default(n));return e.custom?o:ei("a",{"aria-current":n.isExactActive?e.ariaCurrentValue:null,href:n.href,onClick:n.navigate,class:r.value},o)}}}),Ju=Yu;function Qu(e){if(!(e.metaKey||e.altKey||e.ctrlKey||e.shiftKey)&&!e.defaultPrevented&&!(e.button!==void 0&&e.button!==0)){if(e.currentTarget&&e.currentTarget.getAttribute){const t=e.currentTarget.getAttribute("target");if(/\b_blank\b/i.test(t))return}return e.preventDefault&&e.preventDefault(),!0}}function Xu(e,t){for(const n in t){const s=t[n],r=e[n];if(typeof s=="string"){if(s!==r)return!1}else if(!ke(r)||r.length!==s.length||s.some((o,i)=>o!==r[i]))return!1}return!0}function Vr(e){return e?e.aliasOf?e.aliasOf.path:e.path:""}const Hr=(e,t,n)=>e??t??n,Zu=ge({name:"RouterView",inheritAttrs:!1,props:{name:{type:String,default:"default"},route:Object},compatConfig:{MODE:3},setup(e,{attrs:t,slots:n}){const s=$e(bs),r=Oe(()=>e.route||s.value),o=$e(Fr,0),i=Oe(()=>{let d=bt(o);const{matched:f}=r.value;let p;for(;(p=f[d])&&!p.components;)d++;return d}),l=Oe(()=>r.value.matched[i.value]);xn(Fr,Oe(()=>i.value+1)),xn(mi,l),xn(bs,r);const c=et();return wn(()=>[c.value,l.value,e.name],([d,f,p],[h,g,C])=>{f&&(f.instances[p]=d,g&&g!==f&&d&&d===h&&(f.leaveGuards.size||(f.leaveGuards=g.leaveGuards),f.updateGuards.size||(f.updateGuards=g.updateGuards))),d&&f&&(!g||!jt(f,g)||!h)&&(f.enterCallbacks[p]||[]).forEach(P=>P(d))},{flush:"post"}),()=>{const d=r.value,f=e.name,p=l.value,h=p&&p.components[f];if(!h)return Dr(n.default,{Component:h,route:d});const g=p.props[f],C=g?g===!0?d.params:typeof g=="function"?g(d):g:null,D=ei(h,q({},C,t,{onVnodeUnmounted:N=>{N.component.isUnmounted&&(p.instances[f]=null)},ref:c}));return Dr(n.default,{Component:D,route:d})||D}}});function Dr(e,t){if(!e)return null;const n=e(t);return n.length===1?n[0]:n}const ef=Zu;function tf(e){const t=Vu(e.routes,e),n=e.parseQuery||Ku,s=e.stringifyQuery||Nr,r=e.history,o=zt(),i=zt(),l=zt(),c=mo(ot);let d=ot;At&&e.scrollBehavior&&"scrollRestoration"in history&&(history.scrollRestoration="manual");const f=rs.bind(null,y=>""+y),p=rs.bind(null,du),h=rs.bind(null,ln);function g(y,A){let R,$;return ai(y)?(R=t.getRecordMatcher(y),$=A):$=y,t.addRoute($,R)}function C(y){const A=t.getRecordMatcher(y);A&&t.removeRoute(A)}function P(){return t.getRoutes().map(y=>y.record)}function D(y){return!!t.getRecordMatcher(y)}function N(y,A){if(A=q({},A||c.value),typeof y=="string"){const m=os(n,y,A.path),_=t.resolve({path:m.path},A),b=r.createHref(m.fullPath);return q(m,_,{params:h(_.params),hash:ln(m.hash),redirectedFrom:void 0,href:b})}let R;if(y.path!=null)R=q({},y,{path:os(n,y.path,A.path).path});else{const m=q({},y.params);for(const _ in m)m[_]==null&&delete m[_];R=q({},y,{params:p(m)}),A.params=p(A.params)}const $=t.resolve(R,A),ee=y.hash||"";$.params=f(h($.params));const u=mu(s,q({},y,{hash:uu(ee),path:$.path})),a=r.createHref(u);return q({fullPath:u,hash:ee,query:s===Nr?zu(y.query):y.query||{}},$,{redirectedFrom:void 0,href:a})}function I(y){return typeof y=="string"?os(n,y,c.value.path):q({},y)}function F(y,A){if(d!==y)return Vt(8,{from:A,to:y})}function M(y){return re(y)}function Z(y){return M(q(I(y),{replace:!0}))}function ce(y){const A=y.matched[y.matched.length-1];if(A&&A.redirect){const{redirect:R}=A;let $=typeof R=="function"?R(y):R;return typeof $=="string"&&($=$.includes("?")||$.includes("#")?$=I($):{path:$},$.params={}),q({query:y.query,hash:y.hash,params:$.path!=null?{}:y.params},$)}}function re(y,A){const R=d=N(y),$=c.value,ee=y.state,u=y.force,a=y.replace===!0,m=ce(R);if(m)return re(q(I(m),{state:typeof m=="object"?q({},ee,m.state):ee,force:u,replace:a}),A||R);const _=R;_.redirectedFrom=A;let b;return!u&&gu(s,$,R)&&(b=Vt(16,{to:_,from:$}),je($,$,!0,!1)),(b?Promise.resolve(b):Ne(_,$)).catch(v=>Ye(v)?Ye(v,2)?v:rt(v):W(v,_,$)).then(v=>{if(v){if(Ye(v,2))return re(q({replace:a},I(v.to),{state:typeof v.to=="object"?q({},ee,v.to.state):ee,force:u}),A||_)}else v=mt(_,$,!0,a,ee);return st(_,$,v),v})}function Le(y,A){const R=F(y,A);return R?Promise.reject(R):Promise.resolve()}function nt(y){const A=Ct.values().next().value;return A&&typeof A.runWithContext=="function"?A.runWithContext(y):y()}function Ne(y,A){let R;const[$,ee,u]=nf(y,A);R=is($.reverse(),"beforeRouteLeave",y,A);for(const m of $)m.leaveGuards.forEach(_=>{R.push(ct(_,y,A))});const a=Le.bind(null,y,A);return R.push(a),Pe(R).then(()=>{R=[];for(const m of o.list())R.push(ct(m,y,A));return R.push(a),Pe(R)}).then(()=>{R=is(ee,"beforeRouteUpdate",y,A);for(const m of ee)m.updateGuards.forEach(_=>{R.push(ct(_,y,A))});return R.push(a),Pe(R)}).then(()=>{R=[];for(const m of u)if(m.beforeEnter)if(ke(m.beforeEnter))for(const _ of m.beforeEnter)R.push(ct(_,y,A));else R.push(ct(m.beforeEnter,y,A));return R.push(a),Pe(R)}).then(()=>(y.matched.forEach(m=>m.enterCallbacks={}),R=is(u,"beforeRouteEnter",y,A,nt),R.push(a),Pe(R))).then(()=>{R=[];for(const m of i.list())R.push(ct(m,y,A));return R.push(a),Pe(R)}).catch(m=>Ye(m,8)?m:Promise.reject(m))}function st(y,A,R){l.list().forEach($=>nt(()=>$(y,A,R)))}function mt(y,A,R,$,ee){const u=F(y,A);if(u)return u;const a=A===ot,m=At?history.state:{};R&&($||a?r.replace(y.fullPath,q({scroll:a&&m&&m.scroll},ee)):r.push(y.fullPath,ee)),c.value=y,je(y,A,R,a),rt()}let Fe;function Dt(){Fe||(Fe=r.listen((y,A,R)=>{if(!mn.listening)return;const $=N(y),ee=ce($);if(ee){re(q(ee,{replace:!0,force:!0}),$).catch(Xt);return}d=$;const u=c.value;At&&Eu(Pr(u.fullPath,R.delta),qn()),Ne($,u).catch(a=>Ye(a,12)?a:Ye(a,2)?(re(q(I(a.to),{force:!0}),$).then(m=>{Ye(m,20)&&!R.delta&&R.type===cn.pop&&r.go(-1,!1)}).catch(Xt),Promise.reject()):(R.delta&&r.go(-R.delta,!1),W(a,$,u))).then(a=>{a=a||mt($,u,!1),a&&(R.delta&&!Ye(a,8)?r.go(-R.delta,!1):R.type===cn.pop&&Ye(a,20)&&r.go(-1,!1)),st($,u,a)}).catch(Xt)}))}let Et=zt(),ie=zt(),Q;function W(y,A,R){rt(y);const $=ie.list();return $.length?$.forEach(ee=>ee(y,A,R)):console.error(y),Promise.reject(y)}function qe(){return Q&&c.value!==ot?Promise.resolve():new Promise((y,A)=>{Et.add([y,A])})}function rt(y){return Q||(Q=!y,Dt(),Et.list().forEach(([A,R])=>y?R(y):A()),Et.reset()),y}function je(y,A,R,$){const{scrollBehavior:ee}=e;if(!At||!ee)return Promise.resolve();const u=!R&&Ru(Pr(y.fullPath,0))||($||!R)&&history.state&&history.state.scroll||null;return ks().then(()=>ee(y,A,u)).then(a=>a&&Su(a)).catch(a=>W(a,y,A))}const _e=y=>r.go(y);let Rt;const Ct=new Set,mn={currentRoute:c,listening:!0,addRoute:g,removeRoute:C,clearRoutes:t.clearRoutes,hasRoute:D,getRoutes:P,resolve:N,options:e,push:M,replace:Z,go:_e,back:()=>_e(-1),forward:()=>_e(1),beforeEach:o.add,beforeResolve:i.add,afterEach:l.add,onError:ie.add,isReady:qe,install(y){const A=this;y.component("RouterLink",Ju),y.component("RouterView",ef),y.config.globalProperties.$router=A,Object.defineProperty(y.config.globalProperties,"$route",{enumerable:!0,get:()=>bt(c)}),At&&!Rt&&c.value===ot&&(Rt=!0,M(r.location).catch(ee=>{}));const R={};for(const ee in ot)Object.defineProperty(R,ee,{get:()=>c.value[ee],enumerable:!0});y.provide(Gn,A),y.provide(gi,po(R)),y.provide(bs,c);const $=y.unmount;Ct.add(y),y.unmount=function(){Ct.delete(y),Ct.size<1&&(d=ot,Fe&&Fe(),Fe=null,c.value=ot,Rt=!1,Q=!1),$()}}};function Pe(y){return y.reduce((A,R)=>A.then(()=>nt(R)),Promise.resolve())}return mn}function nf(e,t){const n=[],s=[],r=[],o=Math.max(t.matched.length,e.matched.length);for(let i=0;i<o;i++){const l=t.matched[i];l&&(e.matched.find(d=>jt(d,l))?s.push(l):n.push(l));const c=e.matched[i];c&&(t.matched.find(d=>jt(d,c))||r.push(c))}return[n,s,r]}function sf(){return $e(Gn)}const _i=et(!1);function rf(e){_i.value=e}function Bs(){return{confirmAccess:_i,setConfirmAccess:rf}}const hn=(e,t)=>{const n=e.__vccOpts||e;for(const[s,r]of t)n[s]=r;return n},of={},lf={class:"max-w-2xl grow mx-auto px-8 flex flex-col justify-center gap-y-3 md:gap-y-6"};function cf(e,t){const n=Un("RouterLink");return B(),X("div",lf,[t[1]||(t[1]=T("section",null,[T("h1",{class:"text-size-3xl text-color-title font-bold"},"HomeSphere"),T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ")],-1)),K(n,{to:{name:"wifi"}},{default:dn(()=>t[0]||(t[0]=[Jo("Configuración WiFi")])),_:1})])}const uf=hn(of,[["render",cf]]),ff={class:"flex flex-col gap-y-1 md:gap-y-2"},af={for:"ssidInput",class:"text-color-title ml-1.5 font-semibold leading-none"},df={class:"flex flex-col rounded-t-lg overflow-hidden"},pf=["id","type"],Br=ge({__name:"InputGroup",props:Tl({type:{},id:{},label:{}},{modelValue:{required:!0},modelModifiers:{}}),emits:["update:modelValue"],setup(e,{expose:t}){const n=e,s=Xl(e,"modelValue"),r=Eo("input");return t({focus:function(){r.value&&(r.value.focus(),r.value.scrollIntoView({behavior:"smooth",block:"center"}))}}),(o,i)=>(B(),X("div",ff,[T("label",af,St(n.label),1),T("div",df,[al(T("input",{ref:"input","onUpdate:modelValue":i[0]||(i[0]=l=>s.value=l),id:n.id,type:n.type,class:"bg-primary-50 dark:bg-zinc-900 px-4 py-2"},null,8,pf),[[Uc,s.value]]),i[1]||(i[1]=T("div",{class:"w-full h-0.5 bg-primary-500 dark:bg-primary-400"},null,-1))])]))}}),hf=["type","disabled"],mf={key:0,class:"py-1"},gf={key:1,class:"text-zinc-50 dark:text-zinc-950 relative top-0.5 font-bold uppercase w-min text-nowrap"},kn=ge({__name:"CTAButton",props:{type:{},label:{},loading:{type:Boolean},disabled:{type:Boolean}},setup(e){const t=e;return(n,s)=>(B(),X("button",{type:t.type,disabled:t.disabled,class:"flex justify-center py-2 mt-1 rounded-lg bg-primary-500 dark:bg-primary-400 cursor-pointer disabled:cursor-default"},[t.loading?(B(),X("div",mf,s[0]||(s[0]=[T("div",{class:"loader loader-color-cta h-4 md:h-5"},null,-1)]))):(B(),X("span",gf,St(t.label),1))],8,hf))}}),_f={},yf={id:"listItemSecure"};function vf(e,t){return B(),X("div",yf,t[0]||(t[0]=[T("svg",{xmlns:"http://www.w3.org/2000/svg",width:"24",height:"24",viewBox:"0 0 24 24",class:"w-4 h-4"},[T("path",{fill:"currentColor","fill-rule":"evenodd",d:"M12 1.5a5.25 5.25 0 0 0-5.25 5.25v3a3 3 0 0 0-3 3v6.75a3 3 0 0 0 3 3h10.5a3 3 0 0 0 3-3v-6.75a3 3 0 0 0-3-3v-3c0-2.9-2.35-5.25-5.25-5.25m3.75 8.25v-3a3.75 3.75 0 1 0-7.5 0v3z","clip-rule":"evenodd"})],-1)]))}const bf=hn(_f,[["render",vf]]),xf={},wf={id:"listItemNotSecure"};function Sf(e,t){return B(),X("div",wf,t[0]||(t[0]=[T("svg",{xmlns:"http://www.w3.org/2000/svg",width:"24",height:"24",viewBox:"0 0 24 24",class:"w-4 h-4"},[T("path",{fill:"currentColor",d:"M18 1.5c2.9 0 5.25 2.35 5.25 5.25v3.75a.75.75 0 0 1-1.5 0V6.75a3.75 3.75 0 1 0-7.5 0v3a3 3 0 0 1 3 3v6.75a3 3 0 0 1-3 3H3.75a3 3 0 0 1-3-3v-6.75a3 3 0 0 1 3-3h9v-3c0-2.9 2.35-5.25 5.25-5.25"})],-1)]))}const Ef=hn(xf,[["render",Sf]]),Rf=["data-level"],Cf=ge({__name:"IconRSSI",props:{rssi:{}},setup(e){const t=e,n=Oe(()=>t.rssi>=-50?4:t.rssi>=-60?3:t.rssi>=-70?2:t.rssi>=-80?1:0);return(s,r)=>(B(),X("div",{"data-level":n.value,class:"bg-primary-500 dark:bg-primary-400 flex flex-col p-1.5 rounded-full"},r[0]||(r[0]=[cc('<svg xmlns="http://www.w3.org/2000/svg" width="16" height="16" viewBox="0 0 16 16" class="list-item-rssi w-7 h-7 text-primary-300 dark:text-zinc-600"><path class="rssi-bar" fill="currentColor" fill-rule="evenodd" d="M14.188 7.063a8.75 8.75 0 0 0-12.374 0a.75.75 0 0 1-1.061-1.06c4.003-4.004 10.493-4.004 14.496 0a.75.75 0 1 1-1.061 1.06"></path><path class="rssi-bar" fill="currentColor" fill-rule="evenodd" d="M12.067 9.184a5.75 5.75 0 0 0-8.132 0a.75.75 0 0 1-1.06-1.06a7.25 7.25 0 0 1 10.252 0a.75.75 0 0 1-1.06 1.06"></path><path class="rssi-bar" fill="currentColor" fill-rule="evenodd" d="M9.945 11.306a2.75 2.75 0 0 0-3.889 0a.75.75 0 1 1-1.06-1.061a4.25 4.25 0 0 1 6.01 0a.75.75 0 0 1-1.06 1.06"></path><path class="rssi-bar" fill="currentColor" fill-rule="evenodd" d="M7.117 12.366a1.25 1.25 0 0 1 1.768 0a.75.75 0 0 1 0 1.06l-.355.355a.75.75 0 0 1-1.06 0l-.354-.354a.75.75 0 0 1 0-1.06"></path></svg>',1)]),8,Rf))}}),Pf={class:"grow flex items-center gap-x-1.5"},Of={class:"text-size-xl text-color-title inline font-semibold wrap-anywhere"},Af=ge({__name:"NetworkCard",props:{network:{}},emits:["selected"],setup(e){const t=e;return(n,s)=>(B(),X("button",{type:"button",class:"w-full p-3 rounded-lg bg-primary-50 dark:bg-zinc-900 border flex border-primary-300 dark:border-primary-400 cursor-pointer",onClick:s[0]||(s[0]=r=>n.$emit("selected",n.network.ssid))},[T("aside",Pf,[T("span",Of,St(t.network.ssid),1),t.network.secure?(B(),ft(bf,{key:0,class:"text-color-title relative -top-0.5"})):(B(),ft(Ef,{key:1,class:"text-color-title relative -top-0.5"}))]),K(Cf,{rssi:t.network.rssi},null,8,["rssi"])]))}}),Tf={},Mf={xmlns:"http://www.w3.org/2000/svg",width:"16",height:"16",viewBox:"0 0 16 16"};function $f(e,t){return B(),X("svg",Mf,t[0]||(t[0]=[T("path",{fill:"currentColor","fill-rule":"evenodd",d:"M8 3.5q-1.157 0-2.297.066a1.124 1.124 0 0 0-1.058 1.028l-.018.214a.75.75 0 1 1-1.495-.12l.018-.221a2.624 2.624 0 0 1 2.467-2.399a42 42 0 0 1 4.766 0a2.624 2.624 0 0 1 2.467 2.399q.084.993.122 2l.748-.748a.75.75 0 1 1 1.06 1.06l-2 2.001a.75.75 0 0 1-1.061 0l-2-1.999a.75.75 0 0 1 1.061-1.06l.689.688a40 40 0 0 0-.114-1.815a1.124 1.124 0 0 0-1.058-1.028A40 40 0 0 0 8 3.5M3.22 7.22a.75.75 0 0 1 1.061 0l2 2a.75.75 0 1 1-1.06 1.06l-.69-.69q.037.914.114 1.816c.048.56.496.996 1.058 1.028a40 40 0 0 0 4.594 0a1.124 1.124 0 0 0 1.058-1.028l.018-.219a.75.75 0 1 1 1.495.12l-.018.226a2.624 2.624 0 0 1-2.467 2.399a42 42 0 0 1-4.766 0a2.624 2.624 0 0 1-2.467-2.399a41 41 0 0 1-.122-2l-.748.748A.75.75 0 1 1 1.22 9.22z","clip-rule":"evenodd"},null,-1)]))}const Ur=hn(Tf,[["render",$f]]);function If(e){return{all:e=e||new Map,on:function(t,n){var s=e.get(t);s?s.push(n):e.set(t,[n])},off:function(t,n){var s=e.get(t);s&&(n?s.splice(s.indexOf(n)>>>0,1):e.set(t,[]))},emit:function(t,n){var s=e.get(t);s&&s.slice().map(function(r){r(n)}),(s=e.get("*"))&&s.slice().map(function(r){r(t,n)})}}}const Kr=If();function Us(){return{emitter:Kr.emit,listener:Kr.on}}const kf={class:"max-w-2xl mx-auto px-8"},Lf={class:"flex flex-col justify-center gap-y-5 md:gap-y-8"},Nf={key:0,class:"flex justify-center py-10"},Ff={key:1},jf={key:0,class:"flex flex-col gap-y-2"},Vf={class:"flex justify-between items-center"},Hf={class:"flex flex-col gap-y-2.5"},Df={key:1,class:"flex flex-col justify-center items-center text-center py-10 gap-y-1"},Bf={key:2,class:"flex flex-col gap-y-3.5"},Uf=ge({__name:"WiFiView",setup(e){const t=fn({ssid:"",password:""}),n=et(),s=et(!1),r=et(!1),o=Eo("passwordInput"),i=sf(),{emitter:l}=Us();async function c(){r.value=!0;try{{let h=await fetch("/scan");for(let a=0;h.status===202&&a<15;a++)await new Promise(q=>setTimeout(q,1e3*(+h.headers.get("Retry-After")||1))),h=await fetch("/scan");if(h.status!==200)throw new Error("scan");n.value=await h.json()}}catch{l("layout:error")}finally{r.value=!1}}async function d(){s.value=!0;try{await fetch("/setup/wifi",{method:"POST",body:JSON.stringify({ssid:t.ssid,password:t.password})}),Bs().setConfirmAccess(!0),await i.push({name:"confirm-challenge"})}catch{l("layout:error")}finally{s.value=!1}}function f(p){t.ssid=p,o.value&&o.value.focus()}return(p,h)=>(B(),X("div",kf,[T("div",Lf,[h[6]||(h[6]=T("section",null,[T("h1",{class:"text-size-3xl text-color-title font-bold"},"Configuración WiFi"),T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ")],-1)),T("form",{onSubmit:qc(d,["prevent"]),class:"flex flex-col gap-y-2.5"},[K(Br,{modelValue:t.ssid,"onUpdate:modelValue":h[0]||(h[0]=g=>t.ssid=g),type:"text",id:"ssidInput",label:"Nombre de la red"},null,8,["modelValue"]),K(Br,{ref:"passwordInput",modelValue:t.password,"onUpdate:modelValue":h[1]||(h[1]=g=>t.password=g),type:"password",id:"passwordInput",label:"Contraseña"},null,8,["modelValue"]),K(kn,{type:"submit",label:"Guardar",loading:s.value,disabled:s.value||r.value},null,8,["loading","disabled"])],32),T("section",null,[r.value?(B(),X("div",Nf,h[2]||(h[2]=[T("div",{class:"loader loader-color-primary h-5 md:h-6"},null,-1)]))):n.value?(B(),X("div",Ff,[n.value.length?(B(),X("div",jf,[T("aside",Vf,[h[3]||(h[3]=T("h3",{class:"text-size-2xl text-color-title font-bold"},"Redes encontradas:",-1)),T("button",{type:"button",onClick:c,class:"cursor-pointer"},[K(Ur,{class:"w-8 h-8 md:w-9 md:h-9 p-0.5 text-color-title"})])]),T("ul",Hf,[(B(!0),X(Ee,null,Pl(n.value,(g,C)=>(B(),X("li",{key:C},[K(Af,{network:g,onSelected:f},null,8,["network"])]))),128))])])):(B(),X("div",Df,[h[4]||(h[4]=T("span",{class:"text-color-title text-size-xl px-4 font-bold"},"No se encontró ninguna red",-1)),T("button",{type:"button",onClick:c,class:"cursor-pointer"},[K(Ur,{class:"w-8 h-8 md:w-9 md:h-9 p-0.5 text-color-title"})])]))])):(B(),X("div",Bf,[h[5]||(h[5]=T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ",-1)),K(kn,{onClick:c,type:"button",label:"Escanear",loading:!1,disabled:s.value||r.value},null,8,["disabled"])]))])])]))}}),Kf=["type","disabled"],zf={key:0,class:"py-1"},Wf={key:1,class:"text-zinc-500 dark:text-zinc-50 relative top-0.5 font-bold uppercase"},qf=ge({__name:"CancelButton",props:{type:{},label:{},loading:{type:Boolean},disabled:{type:Boolean}},setup(e){const t=e;return(n,s)=>(B(),X("button",{type:t.type,disabled:t.disabled,class:"flex justify-center py-2 mt-1 rounded-lg bg-zinc-300 dark:bg-zinc-700 cursor-pointer disabled:cursor-default"},[t.loading?(B(),X("div",zf,s[0]||(s[0]=[T("div",{class:"loader loader-color-cancel h-4 md:h-5"},null,-1)]))):(B(),X("span",Wf,St(t.label),1))],8,Kf))}}),Gf={class:"text-zinc-50 w-min text-nowrap dark:text-zinc-950 relative top-0.5 font-bold uppercase"},yi=ge({__name:"LinkButton",props:{to:{},label:{}},setup(e){const t=e;return(n,s)=>{const r=Un("RouterLink");return B(),ft(r,{to:t.to,class:"flex justify-center bg-primary-500 dark:bg-primary-400 py-2 px-6 mt-1 rounded-lg cursor-pointer disabled:cursor-default"},{default:dn(()=>[T("span",Gf,St(t.label),1)]),_:1},8,["to"])}}}),Yf={class:"max-w-2xl grow mx-auto px-8 flex flex-col justify-center gap-y-3 md:gap-y-6"},Jf={class:"flex gap-x-3"},Qf={class:"flex flex-col items-center gap-y-3 mt-6"},Xf=ge({__name:"ConfirmView",setup(e){const t=et(!1),n=et(!1),{emitter:s}=Us();async function r(){n.value=!0;try{await fetch("/close",{method:"POST"}),s("layout:end")}catch{s("layout:error")}finally{n.value=!1}}async function o(){t.value=!0;try{await fetch("/setup",{method:"POST"}),s("layout:end")}catch{s("layout:error")}finally{t.value=!1}}return qu(()=>{Bs().setConfirmAccess(!1)}),(i,l)=>(B(),X("div",Yf,[l[1]||(l[1]=T("section",null,[T("h1",{class:"text-size-3xl text-color-title font-bold"},"Confirmar cambios"),T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ")],-1)),T("div",Jf,[K(qf,{type:"button",label:"Cancelar",loading:n.value,disabled:n.value||t.value,class:"w-full",onClick:r},null,8,["loading","disabled"]),K(kn,{type:"button",label:"Confirmar",loading:t.value,disabled:n.value||t.value,class:"w-full",onClick:o},null,8,["loading","disabled"])]),T("section",Qf,[l[0]||(l[0]=T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ",-1)),K(yi,{to:{name:"home"},label:"Seguir editando",class:"self-center"})])]))}}),Zf={class:"max-w-2xl grow mx-auto px-8 flex flex-col justify-center gap-y-3 md:gap-y-6"},ea=ge({__name:"NotFoundView",setup(e){return(t,n)=>(B(),X("div",Zf,[n[0]||(n[0]=T("section",null,[T("h1",{class:"text-size-3xl text-color-title font-bold"},"Página no encontrada"),T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ")],-1)),K(yi,{to:{name:"home"},label:"Página principal",class:"self-center"})]))}}),ta=[{path:"/",name:"home",component:uf},{path:"/wifi",name:"wifi",component:Uf},{path:"/:pathMatch(.*)*",name:"404",component:ea},{path:"/confirm-challenge",name:"confirm-challenge",component:Xf,beforeEnter:function(e,t,n){Bs().confirmAccess.value?n():n({name:"home"})}}],na=tf({history:Au(),routes:ta}),sa={},ra={xmlns:"http://www.w3.org/2000/svg",width:"496",height:"512",viewBox:"0 0 496 512"};function oa(e,t){return B(),X("svg",ra,t[0]||(t[0]=[T("path",{fill:"currentColor",d:"M165.9 397.4c0 2-2.3 3.6-5.2 3.6c-3.3.3-5.6-1.3-5.6-3.6c0-2 2.3-3.6 5.2-3.6c3-.3 5.6 1.3 5.6 3.6m-31.1-4.5c-.7 2 1.3 4.3 4.3 4.9c2.6 1 5.6 0 6.2-2s-1.3-4.3-4.3-5.2c-2.6-.7-5.5.3-6.2 2.3m44.2-1.7c-2.9.7-4.9 2.6-4.6 4.9c.3 2 2.9 3.3 5.9 2.6c2.9-.7 4.9-2.6 4.6-4.6c-.3-1.9-3-3.2-5.9-2.9M244.8 8C106.1 8 0 113.3 0 252c0 110.9 69.8 205.8 169.5 239.2c12.8 2.3 17.3-5.6 17.3-12.1c0-6.2-.3-40.4-.3-61.4c0 0-70 15-84.7-29.8c0 0-11.4-29.1-27.8-36.6c0 0-22.9-15.7 1.6-15.4c0 0 24.9 2 38.6 25.8c21.9 38.6 58.6 27.5 72.9 20.9c2.3-16 8.8-27.1 16-33.7c-55.9-6.2-112.3-14.3-112.3-110.5c0-27.5 7.6-41.3 23.6-58.9c-2.6-6.5-11.1-33.3 2.6-67.9c20.9-6.5 69 27 69 27c20-5.6 41.5-8.5 62.8-8.5s42.8 2.9 62.8 8.5c0 0 48.1-33.6 69-27c13.7 34.7 5.2 61.4 2.6 67.9c16 17.7 25.8 31.5 25.8 58.9c0 96.5-58.9 104.2-114.8 110.5c9.2 7.9 17 22.9 17 46.4c0 33.7-.3 75.4-.3 83.6c0 6.5 4.6 14.4 17.3 12.1C428.2 457.8 496 362.9 496 252C496 113.3 383.5 8 244.8 8M97.2 352.9c-1.3 1-1 3.3.7 5.2c1.6 1.6 3.9 2.3 5.2 1c1.3-1 1-3.3-.7-5.2c-1.6-1.6-3.9-2.3-5.2-1m-10.8-8.1c-.7 1.3.3 2.9 2.3 3.9c1.6 1 3.6.7 4.3-.7c.7-1.3-.3-2.9-2.3-3.9c-2-.6-3.6-.3-4.3.7m32.4 35.6c-1.6 1.3-1 4.3 1.3 6.2c2.3 2.3 5.2 2.6 6.5 1c1.3-1.3.7-4.3-1.3-6.2c-2.2-2.3-5.2-2.6-6.5-1m-11.4-14.7c-1.6 1-1.6 3.6 0 5.9s4.3 3.3 5.6 2.3c1.6-1.3 1.6-3.9 0-6.2c-1.4-2.3-4-3.3-5.6-2"},null,-1)]))}const vi=hn(sa,[["render",oa]]),ia={class:"text-size-base text-color-body dark:bg-zinc-950 bg-zinc-50 font-display"},la={class:"min-h-dvh flex flex-col items-center"},ca={class:"divider flex justify-between items-center w-full px-6 h-14"},ua={href:"https://github.com/vircoding",target:"_blank"},fa={class:"divider flex flex-col grow w-full py-10"},aa={class:"text-center pt-3 pb-[10px]"},da={class:"text-color-title font-semibold"},pa=ge({__name:"Layout",setup(e){const t=new Date().getFullYear();return(n,s)=>{const r=Un("RouterLink");return B(),X("div",ia,[T("div",la,[T("header",ca,[K(r,{to:{name:"home"}},{default:dn(()=>s[0]||(s[0]=[T("h3",{class:"text-color-title text-2xl font-bold"},"HomeSphere",-1)])),_:1}),T("nav",null,[T("a",ua,[K(vi,{class:"icon-link w-6 h-6"})])])]),T("main",fa,[Ol(n.$slots,"default")]),T("footer",aa,[T("span",da,"© "+St(bt(t))+", La Habana, Cuba",1)])])])}}}),ha={class:"absolute top-0 left-0 right-0 bottom-0 text-size-base text-color-body dark:bg-zinc-950 bg-zinc-50 font-display"},ma={class:"min-h-dvh flex flex-col items-center"},ga={class:"divider flex flex-col grow w-full py-10"},_a={class:"max-w-2xl grow mx-auto px-8 flex flex-col justify-center items-center gap-y-3 md:gap-y-6"},ya={href:"https://github.com/vircoding",target:"_blank",class:"inline-block mt-5"},va=ge({__name:"SuccessModal",setup(e){return(t,n)=>(B(),X("div",ha,[T("div",ma,[T("main",ga,[T("div",_a,[n[0]||(n[0]=T("section",{class:"text-center"},[T("h1",{class:"text-size-3xl text-color-title font-bold mb-3"},"HomeSphere reinciado"),T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ")],-1)),T("a",ya,[K(vi,{class:"icon-link w-10 h-10"})])])])])]))}}),ba={class:"absolute top-0 left-0 right-0 bottom-0 text-size-base text-color-body dark:bg-zinc-950 bg-zinc-50 font-display"},xa={class:"min-h-dvh flex flex-col items-center"},wa={class:"divider flex flex-col grow w-full py-10"},Sa={class:"max-w-2xl grow mx-auto px-8 flex flex-col justify-center items-center gap-y-3 md:gap-y-6"},Ea=ge({__name:"ErrorModal",setup(e){function t(){window.location.reload()}return(n,s)=>(B(),X("div",ba,[T("div",xa,[T("main",wa,[T("div",Sa,[s[0]||(s[0]=T("section",null,[T("h1",{class:"text-size-3xl text-color-title font-bold"},"Error inesperado"),T("p",null," Lorem ipsum, dolor sit amet consectetur adipisicing elit. Omnis pariatur dolores commodi aperiam officia quaerat autem. ")],-1)),K(kn,{type:"button",label:"Refrescar",loading:!1,disabled:!1,class:"px-6",onClick:t})])])])]))}}),Ra={class:"relative"},Ca=ge({__name:"App",setup(e){const t=et(!1),n=et(!1),{listener:s}=Us();return s("layout:end",()=>{t.value=!0}),s("layout:error",()=>{n.value=!0}),(r,o)=>{const i=Un("RouterView");return B(),X("div",Ra,[K(pa,null,{default:dn(()=>[K(i)]),_:1}),t.value?(B(),ft(va,{key:0})):ir("",!0),n.value?(B(),ft(Ea,{key:1})):ir("",!0)])}}}),bi=Jc(Ca);bi.use(na);bi.mount("#app");
@@ -1,38 +1,104 @@
 #pragma once
 
 #include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
-#include <vector>
+#include "StaticAlloc.hpp"
+#include "Utils.hpp"
 
 class ConfigManager {
  public:
+  static constexpr uint8_t MAX_NODES = 12;
+  static constexpr uint8_t SSID_SIZE = 33;         // 32 + '\0'
+  static constexpr uint8_t PASSWORD_SIZE = 65;     // 64 + '\0'
+  static constexpr uint8_t DEVICE_NAME_SIZE = 25;  // 24 + '\0'
+  static constexpr uint16_t IMAGE_VERSION = 1;
+  static constexpr uint32_t FLUSH_DEBOUNCE = 2000;    // 2s
+  static constexpr uint32_t SLOT_MAGIC = 0x42435348;  // "HSCB"
+  static constexpr size_t MAX_JSON_SIZE = 4096;       // Entrada JSON maxima
+  static constexpr size_t JSON_POOL_SIZE = 6144;      // Memoria JSON maxima
+
   struct NetworkConfig {
     String ssid;
     String password;
   };
 
+  // Registro de tamano fijo: se guarda tal cual en flash
   struct NodeInfo {
-    uint8_t mac[6];              // Dirección MAC
-    uint8_t nodeType;            // Tipo de nodo
-    String deviceName;           // Nombre del nodo
-    uint8_t firmwareVersion[3];  // Version del firmware del nodo
+    uint32_t reportInterval;            // Intervalo de reporte (ms)
+    float reportThreshold;              // Umbral de cambio para reportar
+    uint8_t mac[6];                     // Dirección MAC
+    uint8_t nodeType;                   // Tipo de nodo
+    uint8_t firmwareVersion[3];         // Version del firmware del nodo
+    bool relay;                         // Reenvia tramas de otros nodos
+    char deviceName[DEVICE_NAME_SIZE];  // Nombre del nodo
   };
 
   bool init();
   bool saveSTAConfig(const String& ssid, const String& password);
   bool saveNodeConfig(const uint8_t* mac, const uint8_t nodeType,
                       const uint8_t* firmwareVersion);
-  NetworkConfig getAPConfig() const { return _apConfig; }
-  NetworkConfig getSTAConfig() const { return _staConfig; }
-  NodeInfo getNode(const uint8_t index) { return _nodes[index]; }
-  uint8_t getNodeLength() const { return _nodes.size(); }
-  void printConfig();
+  bool saveNodeReportConfig(const uint8_t* mac, const uint32_t interval,
+                            const float threshold);
+  bool saveNodeRelayRole(const uint8_t* mac, const bool enabled);
+  bool savePowerProfile(const uint8_t profile);
+  bool importJson(const char* json, size_t length);
+  bool exportJson(Print& output, const bool includeSecrets = false);
+  bool flush();
+  NetworkConfig getAPConfig();
+  NetworkConfig getSTAConfig();
+  bool getNode(const uint8_t index, NodeInfo& node);  // false fuera de rango
+  uint8_t getNodeLength();
+  uint8_t getPowerProfile();
 
  private:
-  NetworkConfig _apConfig;
-  NetworkConfig _staConfig;
-  std::vector<NodeInfo> _nodes;
+  struct NetworkRecord {
+    char ssid[SSID_SIZE];
+    char password[PASSWORD_SIZE];
+  };
+
+  // Imagen binaria versionada; se carga con una sola lectura
+  struct ConfigImage {
+    uint16_t version;
+    uint8_t nodeCount;
+    uint8_t powerProfile;  // PowerManager::Profile; 0 en imagenes antiguas
+    NetworkRecord ap;
+    NetworkRecord sta;
+    NodeInfo nodes[MAX_NODES];
+  };
+
+  // Cabecera de cada slot; le sigue la ConfigImage
+  struct SlotHeader {
+    uint32_t magic;
+    uint32_t generation;  // El slot valido con mayor generacion es el activo
+    uint32_t length;      // Bytes de la imagen
+    uint32_t crc;         // CRC32 de la imagen
+  };
+
+  static const char* const SLOT_PATHS[2];
+
+  ConfigImage _image;
+  bool _isDirty = false;
+  uint32_t _generation = 0;  // Generacion del slot activo
+  uint8_t _activeSlot = 1;   // La primera escritura va al slot 0
+  SemaphoreHandle_t _mutex = NULL;
+  TaskHandle_t _flushTaskHandler = NULL;
+  StaticMutex _mutexStorage;
+  StaticTask<4096> _flushTaskStorage;
+  JsonPool<JSON_POOL_SIZE> _jsonPool;  // Compartido bajo _mutex
 
+  static void _flushTask(void* parameter);
   bool _loadConfig();
-  bool _writeConfig(const JsonDocument& doc);
-};
\ No newline at end of file
+  bool _readSlotHeader(const uint8_t slot, SlotHeader& header);
+  bool _loadSlot(const uint8_t slot, const SlotHeader& header);
+  bool _loadLegacyConfig();
+  void _loadDefaults();
+  static void _buildFilter(JsonDocument& filter);
+  static bool _isValidDocument(const JsonDocument& doc);
+  void _parseDocument(const JsonDocument& doc);
+  void _buildDocument(JsonDocument& doc);
+  void _markDirty();
+  NodeInfo* _findNode(const uint8_t* mac);
+  bool _writeConfig();
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+// Entrada digital por interrupciones con antirrebote por timestamp. La ISR
+// encola cada flanco con su micros() y el consumidor lo filtra al leer la
+// cola. El primer flanco se acepta al instante; los del intervalo de rebote
+// se descartan y al terminar el intervalo se relee el pin, asi una
+// pulsacion corta no deja el nivel desincronizado
+class DebouncedInput {
+ public:
+  static constexpr uint8_t DEBOUNCE_INTERVAL = 50;  // ms
+
+  // Elemento de la cola del consumidor, que puede encolar tambien sus
+  // propias senales con otro id
+  struct Edge {
+    uint8_t id;  // Entrada de origen
+    uint8_t level;
+    uint32_t time;  // micros() en la ISR
+  };
+
+  DebouncedInput(const gpio_num_t pin, const uint8_t id)
+      : _pin(pin), _id(id) {}
+  bool begin(QueueHandle_t queue);  // Pull-up e interrupcion en cada flanco
+  bool accept(const Edge& edge);    // true si cambia el nivel estable
+  bool settle();  // Relectura tras el rebote; true si cambia el nivel
+  TickType_t nextCheck() const;  // Espera maxima hasta settle()
+  uint8_t getLevel() const { return _level; }
+  uint32_t getLastChange() const { return _lastChange; }  // micros()
+
+ private:
+  gpio_num_t _pin;
+  uint8_t _id;
+  QueueHandle_t _queue = NULL;
+  uint8_t _level = HIGH;     // Nivel estable aceptado
+  uint32_t _lastChange = 0;  // micros() del ultimo cambio aceptado
+  bool _needsCheck = false;  // Flancos descartados: releer tras el rebote
+
+  static void IRAM_ATTR _onEdge(void* arg);
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Arduino.h>
+#include <LiquidCrystal.h>
+
+// Framebuffer de caracteres para el LCD 16x2. Las pantallas se dibujan en
+// memoria y flushTo() solo envia al bus las celdas que han cambiado.
+class DisplayBuffer : public Print {
+ public:
+  static constexpr uint8_t COLS = 16;
+  static constexpr uint8_t ROWS = 2;
+
+  struct FlushStats {
+    uint8_t chars = 0;        // Caracteres enviados
+    uint8_t cursorMoves = 0;  // Comandos setCursor enviados
+    uint32_t busTime = 0;     // Duracion del flush (us)
+  };
+
+  DisplayBuffer();
+  void clear();
+  void setCursor(uint8_t col, uint8_t row);
+  size_t write(uint8_t c) override;
+  using Print::write;
+  void invalidate();
+  FlushStats flushTo(LiquidCrystal& lcd);
+
+ private:
+  char _next[ROWS][COLS];   // Fotograma en construccion
+  char _shown[ROWS][COLS];  // Contenido actual del LCD
+  uint8_t _col = 0;
+  uint8_t _row = 0;
+  bool _isValid = false;  // _shown refleja el LCD
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Asset web embebido en el firmware (modo EMBED_WEB_ASSETS)
+struct EmbeddedAsset {
+  const char* path;
+  const uint8_t* data;  // Contenido gzip, residente en flash
+  uint32_t length;
+  const char* mime;
+  const char* etag;  // Hash del contenido, entre comillas
+  bool immutable;    // Nombre con hash: cache de larga duracion
+};
+
+// strcmp evaluable en compilacion
+constexpr int compareAssetPaths(const char* a, const char* b) {
+  return (*a != *b || *a == '\0') ? (*a - *b) : compareAssetPaths(a + 1, b + 1);
+}
+
+// El manifiesto generado se comprueba en compilacion para la busqueda binaria
+constexpr bool isManifestSorted(const EmbeddedAsset* assets, size_t count) {
+  return count < 2 || (compareAssetPaths(assets[0].path, assets[1].path) < 0 &&
+                       isManifestSorted(assets + 1, count - 1));
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+#include "StaticAlloc.hpp"
+
+// Eventos publicados por los modulos; el orden indexa EVENT_NAMES
+enum class EventId : uint8_t {
+  STA_CONNECTING,
+  STA_CONNECTED,
+  STA_DISCONNECTED,
+  STA_FAILED,
+  CONFIG_ENTER,
+  CONFIG_EXIT,
+  SET_ACTUATOR,       // value: indice del actuador
+  SCHEDULE_ACTUATOR,  // value: indice del actuador
+  UPDATE_START,
+  UPDATE_PROGRESS,  // value: porcentaje
+  UPDATE_END,       // value: 1 si la actualizacion termino bien
+  SYNC_PRESS,
+  SYNC_LONG_PRESS,
+  SYNC_END,  // Fin del modo vinculacion (registro completo o timeout)
+  DATA_UPDATED,
+};
+
+// Donde se ejecuta un suscriptor
+enum class EventContext : uint8_t {
+  INLINE,  // En la tarea que publica: solo trabajo corto y no bloqueante
+  UI,      // Tarea "Bus UI": pantalla e indicadores
+  SYSTEM,  // Tarea "Bus System": radio, red y configuracion
+};
+
+struct BusEvent {
+  EventId id;
+  uint32_t value;
+  uint32_t time;  // micros() al publicar
+  bool isLatest;  // Publicado con publishLatest()
+};
+
+typedef void (*EventHandler)(const BusEvent& event);
+
+struct Subscriber {
+  EventId id;
+  EventContext context;
+  EventHandler handler;
+};
+
+// Bus publicacion/suscripcion sobre colas de FreeRTOS. La tabla de
+// suscriptores se fija al compilar y el despacho no reserva memoria.
+class EventBus {
+ public:
+  static constexpr uint8_t EVENT_COUNT = 15;
+  static constexpr uint8_t CONTEXT_COUNT = 3;
+  static constexpr uint8_t QUEUE_LENGTH = 16;
+
+  struct EventStats {
+    uint32_t published = 0;
+    uint32_t dispatched = 0;    // Eventos entregados a un contexto
+    uint32_t dropped = 0;       // Cola del contexto llena
+    uint32_t coalesced = 0;     // Sustituidos por un valor posterior en cola
+    uint32_t maxLatency = 0;    // Publicacion -> despacho (us)
+    uint64_t totalLatency = 0;  // us
+  };
+
+  struct QueueStats {
+    uint8_t depth = 0;
+    uint8_t maxDepth = 0;
+  };
+
+  template <size_t N>
+  bool begin(const Subscriber (&subscribers)[N]) {
+    return _begin(subscribers, N);
+  }
+  // wait: espera por hueco en las colas, para los eventos que no se pueden
+  // perder. Nunca desde la tarea del contexto que los recibe
+  bool publish(EventId id, uint32_t value = 0, TickType_t wait = 0);
+  // Como mucho uno en cola por contexto: el suscriptor recibe el ultimo
+  // valor publicado. Para progresos que se superan entre si
+  bool publishLatest(EventId id, uint32_t value);
+  EventStats getEventStats(EventId id);
+  QueueStats getQueueStats(EventContext context);
+  TaskHandle_t getTask(EventContext context) const;  // NULL en INLINE
+  static const char* eventToText(EventId id);
+  static const char* contextToText(EventContext context);
+
+ private:
+  struct Worker {
+    EventBus* bus;
+    EventContext context;
+    QueueHandle_t queue;
+    TaskHandle_t task;
+    uint8_t maxDepth;
+  };
+
+  const Subscriber* _subscribers = nullptr;
+  size_t _subscriberCount = 0;
+  uint8_t _contexts[EVENT_COUNT] = {};  // Mascara de contextos por evento
+  Worker _workers[CONTEXT_COUNT] = {};
+  StaticQueue<BusEvent, QUEUE_LENGTH> _queueStorage[CONTEXT_COUNT];
+  StaticTask<4096> _uiTask;      // Pantalla e indicadores
+  StaticTask<8192> _systemTask;  // Reinicio de ESP-NOW y portal web
+  EventStats _stats[EVENT_COUNT];
+  uint32_t _latest[EVENT_COUNT] = {};       // Ultimo valor de publishLatest()
+  uint8_t _latestQueued[EVENT_COUNT] = {};  // Contextos con uno en cola
+  portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+  bool _begin(const Subscriber* subscribers, size_t count);
+  bool _enqueue(Worker& worker, const BusEvent& event, TickType_t wait);
+  void _dispatch(const BusEvent& event, EventContext context);
+  static void _dispatchTask(void* parameter);
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stddef.h>
+
+// Vector de capacidad fija: los elementos viven dentro del objeto y nunca se
+// reserva memoria dinamica. push_back devuelve false si esta lleno.
+template <typename T, size_t N>
+class FixedVector {
+ public:
+  typedef T* iterator;
+  typedef const T* const_iterator;
+
+  static constexpr size_t capacity() { return N; }
+  size_t size() const { return _size; }
+  bool empty() const { return _size == 0; }
+  bool full() const { return _size >= N; }
+
+  T& operator[](size_t index) { return _items[index]; }
+  const T& operator[](size_t index) const { return _items[index]; }
+  T& back() { return _items[_size - 1]; }
+
+  iterator begin() { return _items; }
+  iterator end() { return _items + _size; }
+  const_iterator begin() const { return _items; }
+  const_iterator end() const { return _items + _size; }
+
+  bool push_back(const T& item) {
+    if (_size >= N) return false;
+
+    _items[_size++] = item;
+    return true;
+  }
+
+  void pop_back() {
+    if (_size > 0) _size--;
+  }
+
+  // Conserva el orden de los elementos restantes
+  iterator erase(iterator position) {
+    for (iterator it = position; it + 1 < end(); it++) *it = *(it + 1);
+    _size--;
+
+    return position;
+  }
+
+  void clear() { _size = 0; }
+
+ private:
+  T _items[N];
+  size_t _size = 0;
+};
@@ -1,26 +1,34 @@
 #pragma once
 
-#include <Bounce2.h>
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+#include "DebouncedInput.hpp"
+#include "StaticAlloc.hpp"
 
 enum class Key { UP, DOWN, BACK, ENTER, NONE };
 
+// Teclado por interrupciones: las cuatro teclas comparten una cola de
+// flancos filtrados con DebouncedInput. Cada tecla se identifica por su
+// posicion en Key
 class KeypadManager {
  public:
+  static constexpr uint8_t KEY_COUNT = 4;
+  static constexpr uint8_t QUEUE_LENGTH = 16;  // Flancos pendientes
+
   KeypadManager(const gpio_num_t upPin, const gpio_num_t downPin,
                 const gpio_num_t backPin, const gpio_num_t enterPin);
-  void begin();
-  Key getKey();
+  bool begin();
+  Key waitKey(TickType_t timeout);  // Key::NONE si vence el timeout
+  // micros() del flanco que produjo la ultima tecla
+  uint32_t getLastKeyTime() const { return _lastKeyTime; }
 
  private:
-  static constexpr uint8_t DEBOUNCE_INTERVAL = 50;
-
-  Bounce _upDebouncer;
-  Bounce _downDebouncer;
-  Bounce _backDebouncer;
-  Bounce _enterDebouncer;
+  DebouncedInput _inputs[KEY_COUNT];
+  QueueHandle_t _queue = NULL;
+  StaticQueue<DebouncedInput::Edge, QUEUE_LENGTH> _queueStorage;
+  uint32_t _lastKeyTime = 0;
 
-  const gpio_num_t _UP_PIN;
-  const gpio_num_t _DOWN_PIN;
-  const gpio_num_t _BACK_PIN;
-  const gpio_num_t _ENTER_PIN;
-};
\ No newline at end of file
+  TickType_t _nextCheck() const;
+};
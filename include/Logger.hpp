@@ -0,0 +1,116 @@
+#pragma once
+
+#include <Arduino.h>
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+// Nivel maximo compilado (-DLOG_LEVEL=...): los mensajes por encima
+// desaparecen del binario y sus argumentos no se evaluan
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) Logger::write(Logger::Level::ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) \
+  do {                 \
+  } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) Logger::write(Logger::Level::WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) \
+  do {                \
+  } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) Logger::write(Logger::Level::INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) \
+  do {                \
+  } while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Logger::write(Logger::Level::DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) \
+  do {                 \
+  } while (0)
+#endif
+
+// Registro diferido: quien escribe solo copia el formato y los argumentos a
+// un buffer circular sin bloqueos; la tarea "Log" los formatea y los saca por
+// la salida con prioridad minima. Formato estilo printf sin '\n' final.
+class Logger {
+ public:
+  static constexpr uint8_t MAX_ARGS = 8;
+  static constexpr uint8_t TEXT_SIZE = 48;        // Bytes de cadenas
+  static constexpr uint16_t BUFFER_SIZE = 64;     // Potencia de 2
+  static constexpr uint32_t DRAIN_INTERVAL = 20;  // 20ms
+  static constexpr size_t LINE_SIZE = 192;        // Linea formateada
+
+  enum class Level : uint8_t { ERROR = 1, WARN, INFO, DEBUG };
+
+  enum class ArgType : uint8_t { INT, UINT, FLOAT, TEXT };
+
+  // Registro binario: el literal del formato hace de identificador
+  struct Record {
+    const char* format;
+    uint32_t time;  // millis()
+    Level level;
+    uint8_t argCount;
+    uint8_t textLength;
+    ArgType types[MAX_ARGS];
+    union {
+      int32_t i;
+      uint32_t u;  // TEXT: desplazamiento en text
+      float f;
+    } args[MAX_ARGS];
+    char text[TEXT_SIZE];
+  };
+
+  struct Stats {
+    uint32_t written;  // Registros encolados
+    uint32_t dropped;  // Buffer lleno
+  };
+
+  static bool begin(Print& output);
+
+  template <typename... Args>
+  static void write(Level level, const char* format, Args... args) {
+    static_assert(sizeof...(Args) <= MAX_ARGS, "Demasiados argumentos de log");
+
+    Record record;
+    record.format = format;
+    record.time = millis();
+    record.level = level;
+    record.argCount = 0;
+    record.textLength = 0;
+
+    const int expand[] = {0, (_pack(record, args), 0)...};
+    (void)expand;
+
+    _push(record);
+  }
+
+  static Stats getStats();
+
+ private:
+  static void _pack(Record& record, int value);
+  static void _pack(Record& record, long value);
+  static void _pack(Record& record, unsigned value);
+  static void _pack(Record& record, unsigned long value);
+  static void _pack(Record& record, double value);
+  static void _pack(Record& record, const char* value);
+  static void _push(const Record& record);
+  static size_t _format(const Record& record, char* line, size_t size);
+  static void _task(void* parameter);
+};
@@ -1,16 +1,20 @@
 #pragma once
 
 #include <LiquidCrystal.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
-#include <functional>
-#include <map>
-
+#include "DisplayBuffer.hpp"
+#include "EventBus.hpp"
 #include "KeypadManager.hpp"
 #include "NowManager.hpp"
-#include "WebServerManager.hpp"
+#include "PowerManager.hpp"
+#include "StaticAlloc.hpp"
 
 class MenuManager {
  public:
+  static constexpr uint32_t FRAME_INTERVAL = 100;  // 10 Hz maximo
+
   enum class State {
     MAIN,
     STATUS,
@@ -27,27 +31,10 @@ class MenuManager {
     WELCOME,
   };
 
-  enum class Event {
-    CONFIG_ENTER,
-    CONFIG_EXIT,
-    SET_ACTUATOR,
-    SCHEDULE_ACTUATOR,
-  };
-
   struct Data {
     bool wifi;
     bool internet;
-    String ipAP;
-  };
-
-  struct MenuItem {
-    const char* text;
-    State nextState;
-  };
-
-  struct ScheduleActuatorTimeItem {
-    const char* text;
-    const uint32_t time;
+    char ipAP[16];  // "255.255.255.255"
   };
 
   struct ActuatorSchedule {
@@ -58,88 +45,231 @@ class MenuManager {
   MenuManager(const gpio_num_t lcdRS, const gpio_num_t lcdEN,
               const gpio_num_t lcdD4, const gpio_num_t lcdD5,
               const gpio_num_t lcdD6, const gpio_num_t lcdD7,
-              WebServerManager& server, Data& data, NowManager& now);
-  void begin();
-  void handleKey(Key key);
-  void updateDisplay();
-  void showCustomInfoScreen(const String& line1, const String& line2);
+              NowManager& now, PowerManager& power, EventBus& bus);
+  bool begin();
+  void handleKey(Key key, uint32_t keyTime);  // keyTime: micros() del flanco
+  void updateDisplay();  // Solo solicita el redibujado
+  void showCustomInfoScreen(const char* line1, const char* line2);
   void clearCustomInfoScreen();
-  void tryConnect(const String& ssid);
-  void on(Event event, std::function<void()> callback);
-  void updateData();
-  State getState() const { return _currentState; };
-  int getCurrentActuatorIndex() const { return _actuatorScreen; };
+  void updateData();  // Solo solicita el redibujado
+  void setWifiStatus(bool connected);
+  void setHotspotIp(const char* ip);
+  State getState() const;
+  int getCurrentActuatorIndex() const;
   ActuatorSchedule getActuatorSchedule() const { return _actuatorSchedule; };
+  DisplayBuffer::FlushStats getLastFlushStats() const {
+    return _lastFlushStats;
+  }
+  // Desde el flanco de la tecla hasta el LCD actualizado (us)
+  uint32_t getLastKeyLatency() const { return _lastKeyLatency; }
+  // Reservas de heap del ultimo redibujado y maximo observado; requiere
+  // STATIC_ALLOCATION (sin los wrappers siempre es 0)
+  uint32_t getLastRenderAllocations() const { return _lastRenderAllocations; }
+  uint32_t getMaxRenderAllocations() const { return _maxRenderAllocations; }
+  TaskHandle_t getDisplayTask() const { return _displayTaskHandler; }
 
  private:
   LiquidCrystal _lcd;
-  Data& _data;
+  DisplayBuffer _screen;  // Las pantallas se dibujan aqui, no en _lcd
+  DisplayBuffer::FlushStats _lastFlushStats;
+  TaskHandle_t _displayTaskHandler = NULL;
+  SemaphoreHandle_t _customMutex = NULL;
+  StaticTask<4096> _displayTaskStorage;
+  StaticMutex _customMutexStorage;
+  char _customLines[2][DisplayBuffer::COLS + 1];  // Pantalla informativa
+  volatile bool _isCustomScreen = false;
+  volatile uint32_t _keyTime = 0;  // Tecla pendiente de llegar al LCD
+  volatile bool _isKeyPending = false;
+  uint32_t _lastKeyLatency = 0;
+  uint32_t _lastRenderAllocations = 0;
+  uint32_t _maxRenderAllocations = 0;
+  Data _data = {};
   NowManager& _now;
+  PowerManager& _power;
+  EventBus& _bus;
   ActuatorSchedule _actuatorSchedule;
 
-  // Variables de estado
-  State _currentState = State::MAIN;
-  uint8_t _menuPosition = 0;
-  uint8_t _displayStart = 0;
-  uint8_t _sensorScreen = 0;
-  uint8_t _actuatorScreen = 0;
-  uint8_t _actuatorOption = 0;
-  uint8_t _scheduleActuatorConnectionOption = 0;
-  uint8_t _scheduleActuatorConnectionDisplayStart = 0;
-  uint8_t _scheduleActuatorDesconnectionOption = 0;
-  uint8_t _scheduleActuatorDesconnectionDisplayStart = 0;
-  uint8_t _confirmOption = 0;
-  bool _stopKeypad = false;
-
-  // Configuración del menu
-  static constexpr uint8_t MAIN_MENU_COUNT = 5;
-  static constexpr uint8_t SCHEDULE_ACTUATOR_CONNECTION_TIMES_COUNT = 8;
-  static constexpr uint8_t SCHEDULE_ACTUATOR_DESCONNECTION_TIMES_COUNT = 8;
-
-  const MenuItem _mainMenuItems[5] = {
-      {"Sensores", State::SENSOR}, {"Actuadores", State::ACTUATOR},
-      {"Estado", State::STATUS},   {"Configuracion", State::CONFIG_CONFIRM},
-      {"Acerca de", State::ABOUT},
-  };
-
-  const ScheduleActuatorTimeItem _scheduleActuatorConnectionTimes[8] = {
-      {"Ahora", 0},          {"15min", 1000 * 15}, {"30min", 1000 * 30},
-      {"45min", 1000 * 45},  {"1h", 1000 * 60},    {"2h", 1000 * 60 * 2},
-      {"4h", 1000 * 60 * 4}, {"8h", 1000 * 60 * 8}};
-
-  const ScheduleActuatorTimeItem _scheduleActuatorDesconnectionTimes[8] = {
-      {"Nunca", 0xFFFFFFFF}, {"5min", 1000 * 5},   {"15min", 1000 * 15},
-      {"30min", 1000 * 30},  {"45min", 1000 * 45}, {"1h", 1000 * 60},
-      {"2h", 1000 * 60 * 2}, {"4h", 1000 * 60 * 4}};
-
-  // const ScheduleActuatorTimeItem _scheduleActuatorConnectionTimes[8] = {
-  //     {"Ahora", 0},
-  //     {"15min", 1000 * 60 * 15},
-  //     {"30min", 1000 * 60 * 30},
-  //     {"45min", 1000 * 60 * 45},
-  //     {"1h", 1000 * 60 * 60},
-  //     {"2h", 1000 * 60 * 60 * 2},
-  //     {"4h", 1000 * 60 * 60 * 4},
-  //     {"8h", 1000 * 60 * 60 * 8}};
-
-  // const ScheduleActuatorTimeItem _scheduleActuatorDesconnectionTimes[8] = {
-  //     {"Nunca", 0xFFFFFFFF},      {"5min", 1000 * 60 * 5},
-  //     {"15min", 1000 * 60 * 15},  {"30min", 1000 * 60 * 30},
-  //     {"45min", 1000 * 60 * 45},  {"1h", 1000 * 60 * 60},
-  //     {"2h", 1000 * 60 * 60 * 2}, {"4h", 1000 * 60 * 60 * 4}};
-
-  // Callbacks de eventos
-  std::map<Event, std::function<void()>> _callbacks;
+  // Variables de estado: handleKey las cambia bajo _navMutex y _render
+  // dibuja una copia, nunca un estado a medio actualizar
+  struct Navigation {
+    State state = State::MAIN;
+    uint8_t cursor = 0;  // Opcion seleccionada en la pantalla actual
+    uint8_t scroll = 0;  // Primera opcion visible
+    uint8_t page = 0;    // Registro mostrado en las vistas paginadas
+  };
+
+  Navigation _nav;    // Tarea del menu
+  Navigation _shown;  // Copia de la tarea de pantalla
+  SemaphoreHandle_t _navMutex = NULL;
+  StaticMutex _navMutexStorage;
+  volatile bool _stopKeypad = false;
+
+  // Definicion de los menus: cada pantalla es una entrada de SCREENS y su
+  // comportamiento lo da el motor generico segun su tipo
+  typedef void (MenuManager::*Render)();
+  typedef size_t (NowManager::*ListSize)() const;
+
+  enum class ScreenType : uint8_t {
+    LIST,     // Opciones con cursor y desplazamiento
+    CONFIRM,  // Pregunta No/Si
+    VIEW,     // Dibujo propio, paginado si tiene lista de registros
+  };
+
+  struct MenuItem {
+    const char* text;
+    State next;      // Destino con ENTER
+    uint32_t value;  // Se guarda en ListScreen::field
+  };
+
+  struct ListScreen {
+    const MenuItem* items;
+    uint8_t count;
+    uint8_t columns;                    // Columnas de la rejilla en el LCD
+    uint32_t ActuatorSchedule::*field;  // Recibe el valor elegido o nullptr
+  };
+
+  struct ConfirmScreen {
+    const char* message;  // nullptr: lo dibuja render
+    State accept;
+    State cancel;
+    EventId event;  // Se publica al aceptar
+    Render render;
+  };
+
+  struct ViewScreen {
+    Render render;
+    ListSize source;        // Registros por los que se pagina o nullptr
+    const MenuItem* items;  // Opciones de cada pagina (las dibuja render)
+    uint8_t count;
+  };
+
+  struct Screen {
+    State state;  // Debe coincidir con su posicion en SCREENS
+    ScreenType type;
+    State back;     // Destino con BACK; el propio estado lo ignora
+    uint8_t index;  // Posicion en la tabla de su tipo
+  };
 
   // Métodos privados
-  void _trigger(Event event);
-  void _showMain();
+  static void _displayTask(void* parameter);
+  void _render();
+  void _goTo(State state);
+  void _moveCursor(Key key, uint8_t count, uint8_t visible);
+  void _movePage(Key key, const ViewScreen& view);
+  void _showList(const ListScreen& list);
+  void _showConfirm(const ConfirmScreen& confirm);
+  void _showSetActuatorMessage();
   void _showStatus();
   void _showSensor();
   void _showActuator();
-  void _showScheduleActuatorConnection();
-  void _showScheduleActuatorDesconnection();
   void _showConfig();
   void _showAbout();
-  void _showConfirm(const String& message);
+
+  // Tablas de menus: una pantalla nueva es una entrada mas, no codigo nuevo
+  static constexpr uint32_t NEVER = 0xFFFFFFFF;
+
+  static constexpr MenuItem MAIN_ITEMS[] = {
+      {"Sensores", State::SENSOR, 0},
+      {"Actuadores", State::ACTUATOR, 0},
+      {"Estado", State::STATUS, 0},
+      {"Configuracion", State::CONFIG_CONFIRM, 0},
+      {"Acerca de", State::ABOUT, 0},
+  };
+
+  static constexpr MenuItem CONNECTION_TIMES[] = {
+      {"Ahora", State::SCHEDULE_ACTUATOR_DESCONNECTION, 0},
+      {"15min", State::SCHEDULE_ACTUATOR_DESCONNECTION, 1000 * 15},
+      {"30min", State::SCHEDULE_ACTUATOR_DESCONNECTION, 1000 * 30},
+      {"45min", State::SCHEDULE_ACTUATOR_DESCONNECTION, 1000 * 45},
+      {"1h", State::SCHEDULE_ACTUATOR_DESCONNECTION, 1000 * 60},
+      {"2h", State::SCHEDULE_ACTUATOR_DESCONNECTION, 1000 * 60 * 2},
+      {"4h", State::SCHEDULE_ACTUATOR_DESCONNECTION, 1000 * 60 * 4},
+      {"8h", State::SCHEDULE_ACTUATOR_DESCONNECTION, 1000 * 60 * 8},
+  };
+
+  static constexpr MenuItem DESCONNECTION_TIMES[] = {
+      {"Nunca", State::SCHEDULE_ACTUATOR_CONFIRM, NEVER},
+      {"5min", State::SCHEDULE_ACTUATOR_CONFIRM, 1000 * 5},
+      {"15min", State::SCHEDULE_ACTUATOR_CONFIRM, 1000 * 15},
+      {"30min", State::SCHEDULE_ACTUATOR_CONFIRM, 1000 * 30},
+      {"45min", State::SCHEDULE_ACTUATOR_CONFIRM, 1000 * 45},
+      {"1h", State::SCHEDULE_ACTUATOR_CONFIRM, 1000 * 60},
+      {"2h", State::SCHEDULE_ACTUATOR_CONFIRM, 1000 * 60 * 2},
+      {"4h", State::SCHEDULE_ACTUATOR_CONFIRM, 1000 * 60 * 4},
+  };
+
+  // Tiempos reales (minutos) pendientes de activar:
+  // CONNECTION_TIMES: 0, 15, 30, 45, 60, 120, 240, 480 (x 1000 * 60)
+  // DESCONNECTION_TIMES: NEVER, 5, 15, 30, 45, 60, 120, 240 (x 1000 * 60)
+
+  static constexpr MenuItem ACTUATOR_ITEMS[] = {
+      {nullptr, State::ACTUATOR_SET_CONFIRM, 0},
+      {nullptr, State::SCHEDULE_ACTUATOR_CONNECTION, 0},
+  };
+
+  static constexpr ListScreen LISTS[] = {
+      {MAIN_ITEMS, sizeof(MAIN_ITEMS) / sizeof(MenuItem), 1, nullptr},
+      {CONNECTION_TIMES, sizeof(CONNECTION_TIMES) / sizeof(MenuItem), 2,
+       &ActuatorSchedule::offset},
+      {DESCONNECTION_TIMES, sizeof(DESCONNECTION_TIMES) / sizeof(MenuItem), 2,
+       &ActuatorSchedule::duration},
+  };
+
+  static constexpr ConfirmScreen CONFIRMS[] = {
+      {nullptr, State::ACTUATOR, State::ACTUATOR, EventId::SET_ACTUATOR,
+       &MenuManager::_showSetActuatorMessage},
+      {"Programar?", State::ACTUATOR, State::ACTUATOR,
+       EventId::SCHEDULE_ACTUATOR, nullptr},
+      {"Iniciar hotspot?", State::CONFIG, State::MAIN, EventId::CONFIG_ENTER,
+       nullptr},
+      {"Desea salir?", State::MAIN, State::CONFIG, EventId::CONFIG_EXIT,
+       nullptr},
+  };
+
+  static constexpr ViewScreen VIEWS[] = {
+      {&MenuManager::_showStatus, nullptr, nullptr, 0},
+      {&MenuManager::_showSensor, &NowManager::getSensorListSize, nullptr, 0},
+      {&MenuManager::_showActuator, &NowManager::getActuatorListSize,
+       ACTUATOR_ITEMS, 2},
+      {&MenuManager::_showConfig, nullptr, nullptr, 0},
+      {&MenuManager::_showAbout, nullptr, nullptr, 0},
+      {nullptr, nullptr, nullptr, 0},  // Bienvenida: pantalla informativa
+  };
+
+  // Mismo orden que State
+  static constexpr Screen SCREENS[] = {
+      {State::MAIN, ScreenType::LIST, State::MAIN, 0},
+      {State::STATUS, ScreenType::VIEW, State::MAIN, 0},
+      {State::SENSOR, ScreenType::VIEW, State::MAIN, 1},
+      {State::ACTUATOR, ScreenType::VIEW, State::MAIN, 2},
+      {State::ACTUATOR_SET_CONFIRM, ScreenType::CONFIRM, State::ACTUATOR, 0},
+      {State::SCHEDULE_ACTUATOR_CONNECTION, ScreenType::LIST, State::ACTUATOR,
+       1},
+      {State::SCHEDULE_ACTUATOR_DESCONNECTION, ScreenType::LIST,
+       State::SCHEDULE_ACTUATOR_CONNECTION, 2},
+      {State::SCHEDULE_ACTUATOR_CONFIRM, ScreenType::CONFIRM,
+       State::SCHEDULE_ACTUATOR_DESCONNECTION, 1},
+      {State::CONFIG, ScreenType::VIEW, State::CONFIG_EXIT_CONFIRM, 3},
+      {State::CONFIG_CONFIRM, ScreenType::CONFIRM, State::MAIN, 2},
+      {State::CONFIG_EXIT_CONFIRM, ScreenType::CONFIRM, State::CONFIG, 3},
+      {State::ABOUT, ScreenType::VIEW, State::MAIN, 4},
+      {State::WELCOME, ScreenType::VIEW, State::WELCOME, 5},
+  };
+
+  // Comprobacion de las tablas en tiempo de compilacion: orden de SCREENS e
+  // indices dentro de la tabla de cada tipo
+  static constexpr size_t _tableSize(ScreenType type) {
+    return type == ScreenType::LIST
+               ? sizeof(LISTS) / sizeof(ListScreen)
+               : (type == ScreenType::CONFIRM
+                      ? sizeof(CONFIRMS) / sizeof(ConfirmScreen)
+                      : sizeof(VIEWS) / sizeof(ViewScreen));
+  }
+
+  static constexpr bool _isTableValid(size_t i) {
+    return i >= sizeof(SCREENS) / sizeof(Screen) ||
+           (static_cast<size_t>(SCREENS[i].state) == i &&
+            SCREENS[i].index < _tableSize(SCREENS[i].type) &&
+            _isTableValid(i + 1));
+  }
 };
\ No newline at end of file
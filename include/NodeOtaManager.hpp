@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include "NowManager.hpp"
+#include "StaticAlloc.hpp"
+
+class NodeOtaManager {
+ public:
+  static constexpr const char* IMAGE_PATH = "/node_ota.bin";
+  static constexpr uint8_t WINDOW_SIZE = 16;          // Chunks en vuelo
+  static constexpr uint32_t ACK_TIMEOUT = 300;        // 300ms
+  static constexpr uint32_t RETRANSMIT_GUARD = 100;   // 100ms
+  static constexpr uint32_t RESULT_TIMEOUT = 10000;   // 10s
+  static constexpr uint8_t MAX_TIMEOUTS = 10;         // Timeouts seguidos
+  static constexpr uint8_t MAX_TARGETS = 12;
+
+  enum class Result { PENDING, IN_PROGRESS, SUCCESS, FAILED, TIMEOUT };
+
+  struct TargetStats {
+    uint8_t mac[6];
+    Result result = Result::PENDING;
+    uint32_t bytesSent = 0;    // Incluye retransmisiones
+    uint32_t chunksSent = 0;   // Incluye retransmisiones
+    uint32_t retransmits = 0;  // Chunks reenviados
+    uint32_t elapsed = 0;      // Duracion de la transferencia (ms)
+  };
+
+  NodeOtaManager(NowManager& now);
+  bool beginUpload();
+  bool writeUpload(const uint8_t* data, size_t length);
+  bool endUpload();
+  bool hasImage() const { return _imageSize > 0; }
+  uint32_t getImageSize() const { return _imageSize; }
+  uint32_t getImageCrc() const { return _imageCrc; }
+  bool start(const uint8_t nodeType, const uint8_t* firmwareVersion);
+  bool isRunning() const { return _taskHandler != NULL; }
+  bool handleMessage(const uint8_t* mac, const uint8_t* data, size_t length);
+  uint8_t getTargetCount() const { return _targetCount; }
+  TargetStats getTargetAt(const uint8_t index) const;
+
+ private:
+  struct AckEvent {
+    uint8_t mac[6];
+    uint8_t msgType;
+    uint16_t base;
+    uint32_t bitmap;
+    uint8_t status;
+  };
+
+  NowManager& _now;
+  File _uploadFile;
+  uint32_t _imageSize = 0;
+  uint32_t _imageCrc = 0;
+  uint32_t _uploadSize = 0;
+  uint8_t _firmwareVersion[3];
+  TaskHandle_t _taskHandler = NULL;
+  QueueHandle_t _ackQueue = NULL;
+  StaticQueue<AckEvent, WINDOW_SIZE> _ackQueueStorage;
+  TargetStats _targets[MAX_TARGETS];
+  uint8_t _targetCount = 0;
+  // Nodo en curso: lo escribe la tarea OTA y lo lee el callback de recepcion
+  uint8_t _activeMac[6];
+  bool _hasActiveTarget = false;
+  portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+  static void _task(void* parameter);
+  void _run();
+  Result _updateTarget(TargetStats& target, File& image);
+  bool _sendChunk(TargetStats& target, File& image, const uint16_t index);
+  bool _waitAck(const TargetStats& target, AckEvent& event,
+                const uint32_t timeout);
+  void _setActiveTarget(const uint8_t* mac);
+  bool _isActiveTarget(const uint8_t* mac);
+  void _printStats(const TargetStats& target);
+};
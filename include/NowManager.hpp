@@ -4,13 +4,33 @@
 #include <esp_now.h>
 
 #include <algorithm>
-#include <vector>
+
+#include "FixedVector.hpp"
+#include "StaticAlloc.hpp"
 
 class NowManager {
  public:
   static constexpr uint32_t SYNC_MODE_TIMEOUT = 30000;                // 30s
   static constexpr uint32_t SEND_SYNC_BROADCAST_MSG_INTERVAL = 5000;  // 5s
   static constexpr uint32_t PING_ALL_DEVICES_INTERVAL = 10000;        // 10s
+  static constexpr uint32_t DEFAULT_REPORT_INTERVAL = 10000;          // 10s
+  static constexpr float DEFAULT_REPORT_THRESHOLD = 0.5;  // 0 = solo por tiempo
+  static constexpr uint32_t MIN_REPORT_INTERVAL = 1000;     // 1s
+  static constexpr uint32_t MAX_REPORT_INTERVAL = 3600000;  // 1h
+  static constexpr float MAX_REPORT_THRESHOLD = 100;
+  static constexpr uint8_t DUPLICATE_WINDOW_SIZE = 32;    // Bits de la ventana
+  static constexpr uint8_t RATE_LIMIT_BURST = 8;          // Tokens maximos
+  static constexpr uint32_t RATE_LIMIT_REFILL_INTERVAL = 250;  // 1 token/250ms
+  static constexpr uint8_t OTA_CHUNK_SIZE = 200;  // Bytes de imagen por trama
+  static constexpr uint8_t RELAY_MAX_HOPS = 3;     // Saltos maximos por trama
+  static constexpr uint32_t ROUTE_TIMEOUT = 60000;  // 60s sin refrescar ruta
+  static constexpr uint8_t MAX_PENDING_SENDS = 16;  // Envios sin confirmar
+  static constexpr uint8_t MAX_DEVICES = 12;
+  static constexpr uint8_t MAX_SENSORS = MAX_DEVICES * 2;  // Temp y Hum
+  static constexpr uint8_t MAX_ACTUATORS = MAX_DEVICES;
+  static constexpr uint8_t DEVICE_NAME_SIZE = 25;  // 24 + '\0'
+  static constexpr uint8_t VARIABLE_SIZE = 8;      // 7 + '\0'
+  static constexpr uint8_t UNITS_SIZE = 4;         // 3 + '\0'
 
   enum class NodeType {
     TEMPERATURE_HUMIDITY = 0x1A,
@@ -25,7 +45,15 @@ class NowManager {
     SET_ACTUATOR = 0xB3,
     ACTUATOR_STATE = 0x26,
     SCHEDULE_ACTUATOR = 0x33,
-    PING = 0x11
+    PING = 0x11,
+    REPORT_CONFIG = 0x4C,
+    OTA_BEGIN = 0x70,
+    OTA_CHUNK = 0x71,
+    OTA_ACK = 0x72,
+    OTA_END = 0x73,
+    OTA_RESULT = 0x74,
+    RELAY_ROLE = 0x7B,
+    RELAY = 0x7E
   };
 
   enum class SensorValueType { FLOAT, INT, BOOL };
@@ -52,6 +80,7 @@ class NowManager {
 
   struct TemperatureHumidityMsg {
     uint8_t msgType = static_cast<uint8_t>(MessageType::TEMPERATURE_HUMIDITY);
+    uint16_t seq;  // Numero de secuencia de la trama
     float temp;
     float hum;
     uint8_t crc;
@@ -65,6 +94,7 @@ class NowManager {
 
   struct ActuatorStateMsg {
     uint8_t msgType = static_cast<uint8_t>(MessageType::ACTUATOR_STATE);
+    uint16_t seq;  // Numero de secuencia de la trama
     bool state;
     uint8_t crc;
   };
@@ -79,23 +109,103 @@ class NowManager {
   struct PingMsg {
     uint8_t msgType = static_cast<uint8_t>(MessageType::PING);
   };
+
+  struct ReportConfigMsg {
+    uint8_t msgType = static_cast<uint8_t>(MessageType::REPORT_CONFIG);
+    uint32_t interval;  // Intervalo maximo entre reportes (ms)
+    float threshold;    // Cambio minimo que fuerza un reporte
+    uint8_t crc;
+  };
+
+  struct OtaBeginMsg {
+    uint8_t msgType = static_cast<uint8_t>(MessageType::OTA_BEGIN);
+    uint32_t imageSize;
+    uint32_t imageCrc;  // CRC32 de la imagen completa
+    uint8_t firmwareVersion[3];
+    uint16_t chunkCount;
+    uint8_t crc;
+  };
+
+  struct OtaChunkMsg {
+    uint8_t msgType = static_cast<uint8_t>(MessageType::OTA_CHUNK);
+    uint16_t index;
+    uint8_t length;  // Bytes validos en data
+    uint8_t data[OTA_CHUNK_SIZE];
+    uint8_t crc;
+  };
+
+  struct OtaAckMsg {
+    uint8_t msgType = static_cast<uint8_t>(MessageType::OTA_ACK);
+    uint16_t base;    // Primer chunk no recibido (los anteriores estan OK)
+    uint32_t bitmap;  // Bit i = chunk base + i recibido
+    uint8_t crc;
+  };
+
+  struct OtaEndMsg {
+    uint8_t msgType = static_cast<uint8_t>(MessageType::OTA_END);
+    uint32_t imageCrc;
+    uint8_t crc;
+  };
+
+  struct OtaResultMsg {
+    uint8_t msgType = static_cast<uint8_t>(MessageType::OTA_RESULT);
+    uint8_t status;  // 0 = imagen verificada y aplicada
+    uint8_t crc;
+  };
+
+  struct RelayRoleMsg {
+    uint8_t msgType = static_cast<uint8_t>(MessageType::RELAY_ROLE);
+    bool enabled;  // El nodo reenvia tramas de otros nodos
+    uint8_t crc;
+  };
+
+  // Cabecera de enrutamiento; le sigue la trama original completa
+  struct RelayHeader {
+    uint8_t msgType = static_cast<uint8_t>(MessageType::RELAY);
+    uint8_t origin[6];       // Nodo que genero la trama
+    uint8_t destination[6];  // Nodo final (o broadcast)
+    uint8_t hops;            // Relays atravesados hasta ahora
+    uint16_t seq;            // Secuencia del origen para evitar tormentas
+  };
 #pragma pack(pop)
 
+  struct SequenceWindow {
+    bool hasSeq = false;     // Se ha recibido alguna secuencia
+    uint16_t lastSeq = 0;    // Secuencia mas reciente aceptada
+    uint32_t bitmap = 0;     // Bit i = lastSeq - i ya recibido
+  };
+
+  struct FrameFilter {
+    SequenceWindow frames;        // Secuencia de las tramas de datos
+    SequenceWindow relayed;       // Secuencia de la cabecera de relay
+    uint8_t tokens = RATE_LIMIT_BURST;  // Token bucket
+    uint32_t lastRefill = 0;      // Timestamp de la ultima recarga
+    uint32_t duplicateDrops = 0;  // Tramas duplicadas descartadas
+    uint32_t rateLimitDrops = 0;  // Tramas descartadas por exceso de tasa
+  };
+
   struct DeviceInfo {
     uint8_t mac[6];              // Dirección MAC
     uint8_t nodeType;            // Tipo de nodo
-    String deviceName;           // Nombre del nodo
+    char deviceName[DEVICE_NAME_SIZE];  // Nombre del nodo
     uint8_t firmwareVersion[3];  // Version del firmware del nodo
     uint8_t nodeId;              // ID asignado para la red
     uint32_t lastSeen;           // Timestamp de última comunicación
+    uint32_t reportInterval;     // Intervalo de reporte configurado (ms)
+    float reportThreshold;       // Umbral de cambio para reportar
+    FrameFilter filter;          // Duplicados y limite de tasa
+    bool isRelay;                // Rol de relay habilitado
+    uint8_t nextHop[6];          // Vecino por el que se alcanza el nodo
+    uint8_t hops;                // Relays hasta el nodo (0 = directo)
+    uint32_t routeUpdated;       // Timestamp de la ultima ruta aprendida
   };
 
   struct SensorData {
     uint8_t mac[6];
-    String deviceName;
+    char deviceName[DEVICE_NAME_SIZE];
     bool isConnected;
-    String variable;
-    String units;
+    char variable[VARIABLE_SIZE];
+    char units[UNITS_SIZE];
     SensorValueType type;
     union {
       float f;
@@ -106,11 +216,16 @@ class NowManager {
 
   struct ActuatorData {
     uint8_t mac[6];
-    String deviceName;
+    char deviceName[DEVICE_NAME_SIZE];
     bool isConnected;
     bool state;
   };
 
+  // Tablas de capacidad fija: no crecen ni fragmentan el heap
+  typedef FixedVector<DeviceInfo, MAX_DEVICES> DeviceList;
+  typedef FixedVector<SensorData, MAX_SENSORS> SensorList;
+  typedef FixedVector<ActuatorData, MAX_ACTUATORS> ActuatorList;
+
   bool init();
   bool stop();
   bool reset();
@@ -125,47 +240,99 @@ class NowManager {
   bool sendScheduleActuatorMsg(const uint8_t* mac, const uint32_t offset = 0,
                                const uint32_t duration = 0xFFFFFFFF);
   bool sendPingMsg(const uint8_t* mac);
+  bool sendReportConfigMsg(const uint8_t* mac, const uint32_t interval,
+                           const float threshold);
+  bool sendOtaBeginMsg(const uint8_t* mac, const uint32_t imageSize,
+                       const uint32_t imageCrc, const uint8_t* firmwareVersion,
+                       const uint16_t chunkCount);
+  bool sendOtaChunkMsg(const uint8_t* mac, const uint16_t index,
+                       const uint8_t* data, const uint8_t length);
+  bool sendOtaEndMsg(const uint8_t* mac, const uint32_t imageCrc);
+  bool sendRelayRoleMsg(const uint8_t* mac, const bool enabled);
   static bool validateMessage(MessageType expectedType, const uint8_t* data,
                               size_t length);
-  DeviceInfo* findDevice(const uint8_t* mac);
+  static bool isValidReportConfig(const uint32_t interval,
+                                  const float threshold);
+  // Token del vecino que entrega la trama; primero de todo en recepcion
+  bool admitSender(const uint8_t* mac);
+  // Duplicados del nodo de origen, ya resuelto el relay
+  bool acceptFrame(const uint8_t* mac, const uint8_t* data, size_t length);
+  void commitFrame(const uint8_t* mac, const uint8_t* data, size_t length);
+  bool resolveOrigin(const uint8_t* sender, const uint8_t*& data, int& length,
+                     const uint8_t*& origin);
+  // Tiempo desde el envio hasta su callback (us); 0 si no estaba anotado
+  uint32_t popSendDestination(const uint8_t* mac, uint8_t* destination);
   bool removeDevice(const uint8_t* mac);
-  bool removeSensor(const uint8_t* mac, const String& variable);
+  bool removeSensor(const uint8_t* mac, const char* variable);
   bool removeActuator(const uint8_t* mac);
   bool addDevice(const uint8_t* mac, const uint8_t nodeType,
-                 const String& deviceName, const uint8_t* firmwareVersion);
+                 const char* deviceName, const uint8_t* firmwareVersion,
+                 const uint32_t reportInterval = DEFAULT_REPORT_INTERVAL,
+                 const float reportThreshold = DEFAULT_REPORT_THRESHOLD,
+                 const bool isRelay = false);
   bool isDevicePaired(const uint8_t* mac);
   void updateDeviceLastSeen(const uint8_t* mac);
+  bool setReportConfig(const uint8_t* mac, const uint32_t interval,
+                       const float threshold);
+  bool setRelayRole(const uint8_t* mac, const bool enabled);
   void printAllDevices();
-  std::vector<DeviceInfo> getDeviceList() const { return _pairedDevices; }
-  std::vector<SensorData> getSensorList() const { return _sensors; }
-  std::vector<ActuatorData> getActuatorList() const { return _actuators; }
+  size_t getDeviceListSize() const { return _pairedDevices.size(); }
   size_t getSensorListSize() const { return _sensors.size(); }
   size_t getActuatorListSize() const { return _actuators.size(); }
-  SensorData getSensorAt(const int index) const;
-  ActuatorData getActuatorAt(const int index) const;
+  // Copia bajo el mutex de las tablas, para leer desde otras tareas; false
+  // si index esta fuera de rango, con el registro de reserva en la salida
+  bool copyDeviceAt(const size_t index, DeviceInfo& device);
+  bool copySensorAt(const size_t index, SensorData& sensor);
+  bool copyActuatorAt(const size_t index, ActuatorData& actuator);
+  bool getNodeType(const uint8_t* mac, NodeType& nodeType);  // Bajo el mutex
   bool getIsDataTransferEnabled() const { return _isDataTransferEnabled; }
   void setDataTransfer(const bool state);
   void updateSensorData(
-      const uint8_t* mac, const String& variable,
+      const uint8_t* mac, const char* variable,
       const bool value);  // Metodo sobrecargado para sensores binarios
   void updateSensorData(
-      const uint8_t* mac, const String& variable,
+      const uint8_t* mac, const char* variable,
       const int value);  // Metodo sobrecargado para sensores discretos
   void updateSensorData(
-      const uint8_t* mac, const String& variable,
+      const uint8_t* mac, const char* variable,
       const float value);  // Metodo sobrecargado para sensores continuos
   void updateActuatorState(const uint8_t* mac, const bool state);
-  void desconnectSensor(const uint8_t* mac, const String& variable);
+  void desconnectSensor(const uint8_t* mac, const char* variable);
   void desconnectActuator(const uint8_t* mac);
 
  private:
+  // Destino final de cada envio en vuelo, en el orden de los callbacks
+  struct PendingSend {
+    uint8_t nextHop[6];
+    uint8_t destination[6];
+    uint32_t sentAt;  // micros() al enviar
+  };
+
   bool _isDataTransferEnabled = false;
   uint8_t _broadcastMac[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
   bool _isBroadcastPeerRegistered = false;
-  std::vector<DeviceInfo> _pairedDevices;
-  std::vector<SensorData> _sensors;
-  std::vector<ActuatorData> _actuators;
+  uint8_t _ownMac[6];
+  uint16_t _relaySeq = 0;
+  DeviceList _pairedDevices;
+  SensorList _sensors;
+  ActuatorList _actuators;
+  PendingSend _pendingSends[MAX_PENDING_SENDS];
+  uint8_t _pendingHead = 0;
+  uint8_t _pendingCount = 0;
+  portMUX_TYPE _sendMux = portMUX_INITIALIZER_UNLOCKED;
+  SemaphoreHandle_t _mutex = NULL;  // Contenido de las tablas
+  StaticMutex _mutexStorage;
 
   static size_t _getMessageSize(MessageType type);
+  static bool _hasSequence(MessageType type);
+  static bool _isDuplicate(const SequenceWindow& window, const uint16_t seq);
+  static void _commitSequence(SequenceWindow& window, const uint16_t seq);
+  static bool _consumeToken(FrameFilter& filter);
   bool _registerPeer(const uint8_t* mac);
+  bool _send(const uint8_t* mac, const uint8_t* data, size_t length);
+  bool _transmit(const uint8_t* nextHop, const uint8_t* destination,
+                 const uint8_t* data, size_t length);
+  void _learnRoute(DeviceInfo& device, const uint8_t* nextHop,
+                   const uint8_t hops);
+  DeviceInfo* _findDevice(const uint8_t* mac);  // Con _mutex tomado
 };
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Arduino.h>
+#include <esp_pm.h>
+
+// Perfiles de energia sobre el gestor de ESP-IDF (DFS y light sleep
+// automatico). Sin CONFIG_PM_ENABLE se aplica una frecuencia fija.
+class PowerManager {
+ public:
+  static constexpr uint32_t RADIO_LATENCY_BUDGET = 2000;  // 2ms
+  static constexpr uint8_t LOCK_COUNT = 3;
+  static constexpr uint8_t PROFILE_COUNT = 3;
+
+  enum class Profile : uint8_t {
+    PERFORMANCE,  // 240 MHz fijos
+    BALANCED,     // DFS 80-240 MHz
+    LOW_POWER,    // DFS 80-160 MHz y light sleep con el Wi-Fi parado
+  };
+
+  enum class Lock : uint8_t {
+    RADIO_RX,      // Procesado de una trama ESP-NOW a maxima frecuencia
+    RADIO_LISTEN,  // Ventana de recepcion: sin light sleep
+    DISPLAY,       // Escritura en el LCD a maxima frecuencia
+  };
+
+  struct LockStats {
+    uint32_t acquisitions = 0;
+    uint64_t heldTime = 0;  // Tiempo total retenido (us)
+  };
+
+  struct LatencyStats {
+    uint32_t count = 0;
+    uint32_t maxLatency = 0;    // us
+    uint64_t totalLatency = 0;  // us
+    uint32_t overBudget = 0;    // Por encima de RADIO_LATENCY_BUDGET
+  };
+
+  struct RadioStats {
+    // Tramas recibidas: entrada al callback hasta el final del procesado
+    LatencyStats rx;
+    // Envios unicast entregados: esp_now_send() hasta el ACK del primer
+    // salto, con la cola, el aire y los reintentos
+    LatencyStats tx;
+    uint32_t sent = 0;  // Envios unicast, entregados o no
+  };
+
+  bool begin(Profile profile);
+  bool setProfile(Profile profile);
+  Profile getProfile() const { return _profile; }
+  bool isDynamic() const { return _isDynamic; }  // DFS activo
+  bool isLightSleepEnabled() const { return _isLightSleepEnabled; }
+  void acquire(Lock lock);
+  void release(Lock lock);
+  void recordRadioReceive(uint32_t latency);
+  void recordRadioSend(bool isDelivered, uint32_t latency);
+  LockStats getLockStats(Lock lock);
+  RadioStats getRadioStats();
+  uint64_t getUptime() const;  // us desde begin()
+  void printStats(Print& output);
+  static bool isValidProfile(const uint8_t profile) {
+    return profile < PROFILE_COUNT;
+  }
+  static const char* profileToText(Profile profile);
+  static const char* lockToText(Lock lock);
+
+ private:
+  struct LockState {
+    esp_pm_lock_handle_t handle;  // NULL sin soporte de PM
+    uint8_t depth;                // Adquisiciones anidadas
+    int64_t since;                // Inicio de la retencion actual
+    LockStats stats;
+  };
+
+  Profile _profile = Profile::PERFORMANCE;
+  bool _isDynamic = false;
+  bool _isLightSleepEnabled = false;
+  int64_t _startTime = 0;
+  LockState _locks[LOCK_COUNT] = {};
+  RadioStats _radioStats;
+  portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+  bool _configure(Profile profile);
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <freertos/timers.h>
+
+// Objetos de FreeRTOS con memoria reservada en el propio objeto. Con
+// STATIC_ALLOCATION se crean con las variantes *Static; sin ella, en el heap.
+
+template <uint32_t STACK_SIZE>
+class StaticTask {
+ public:
+  // handle puede ser nullptr
+  bool create(TaskFunction_t function, const char* name, void* parameter,
+              UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+#ifdef STATIC_ALLOCATION
+    const TaskHandle_t task = xTaskCreateStaticPinnedToCore(
+        function, name, STACK_SIZE, parameter, priority, _stack, &_tcb, core);
+    if (handle != nullptr) *handle = task;
+
+    return task != NULL;
+#else
+    return xTaskCreatePinnedToCore(function, name, STACK_SIZE, parameter,
+                                   priority, handle, core) == pdPASS;
+#endif
+  }
+
+ private:
+#ifdef STATIC_ALLOCATION
+  StackType_t _stack[STACK_SIZE];  // En ESP-IDF la pila se mide en bytes
+  StaticTask_t _tcb;
+#endif
+};
+
+template <typename T, UBaseType_t LENGTH>
+class StaticQueue {
+ public:
+  QueueHandle_t create() {
+#ifdef STATIC_ALLOCATION
+    return xQueueCreateStatic(LENGTH, sizeof(T), _storage, &_queue);
+#else
+    return xQueueCreate(LENGTH, sizeof(T));
+#endif
+  }
+
+ private:
+#ifdef STATIC_ALLOCATION
+  uint8_t _storage[LENGTH * sizeof(T)];
+  StaticQueue_t _queue;
+#endif
+};
+
+class StaticMutex {
+ public:
+  SemaphoreHandle_t create() {
+#ifdef STATIC_ALLOCATION
+    return xSemaphoreCreateMutexStatic(&_mutex);
+#else
+    return xSemaphoreCreateMutex();
+#endif
+  }
+
+ private:
+#ifdef STATIC_ALLOCATION
+  StaticSemaphore_t _mutex;
+#endif
+};
+
+class StaticTimer {
+ public:
+  TimerHandle_t create(const char* name, TickType_t period,
+                       UBaseType_t autoReload, void* id,
+                       TimerCallbackFunction_t callback) {
+#ifdef STATIC_ALLOCATION
+    return xTimerCreateStatic(name, period, autoReload, id, callback,
+                              &_timer);
+#else
+    return xTimerCreate(name, period, autoReload, id, callback);
+#endif
+  }
+
+ private:
+#ifdef STATIC_ALLOCATION
+  StaticTimer_t _timer;
+#endif
+};
+
+// Aborta ante cualquier malloc/calloc/realloc (y new) de una tarea vigilada
+// una vez armado. Requiere STATIC_ALLOCATION y -Wl,--wrap de las tres
+// funciones; sin ellas solo informa del estado del heap.
+class HeapGuard {
+ public:
+  static constexpr uint8_t MAX_TASKS = 8;
+
+  struct Stats {
+    uint32_t freeHeap;
+    uint32_t minFreeHeap;   // Minimo historico
+    uint32_t largestBlock;  // Indica la fragmentacion
+    bool isArmed;
+  };
+
+  // Reservas contadas por los wrappers desde el arranque, armado o no
+  struct TaskStats {
+    const char* name;
+    uint32_t allocations;
+  };
+
+  // Permite reservar memoria en la tarea actual mientras exista el objeto:
+  // portal de configuracion, modo vinculacion y similares
+  class Exempt {
+   public:
+    Exempt() { HeapGuard::_exempt(true); }
+    ~Exempt() { HeapGuard::_exempt(false); }
+  };
+
+  static bool watch(TaskHandle_t task);  // NULL: tarea actual
+  static void arm();                     // Al terminar setup()
+  static Stats getStats();
+  static uint8_t getTaskCount();
+  static TaskStats getTaskStats(uint8_t index);
+  static uint32_t getAllocations(TaskHandle_t task);  // NULL: tarea actual
+  static void check(size_t size);  // Desde los wrappers del heap
+
+ private:
+  static void _exempt(bool enter);
+};
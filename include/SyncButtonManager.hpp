@@ -1,37 +1,37 @@
 #pragma once
 
-#pragma once
-
-#include <Bounce2.h>
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/timers.h>
 
-#include <functional>
-#include <map>
+#include "DebouncedInput.hpp"
+#include "EventBus.hpp"
+#include "StaticAlloc.hpp"
 
 class SyncButtonManager {
  public:
-  enum class Event {
-    SIMPLE_PRESS,
-    LONG_PRESS,
-  };
-
-  SyncButtonManager(const gpio_num_t buttonPin);
-  void begin();
-  void update();
-  void on(Event event, std::function<void()> callback);
+  SyncButtonManager(const gpio_num_t buttonPin, EventBus& bus);
+  bool begin();
+  void update();  // Bloquea hasta el siguiente flanco o pulsacion larga
 
  private:
   static constexpr uint16_t LONG_PRESS_DURATION = 3000;
-  static constexpr uint8_t DEBOUNCE_INTERVAL = 50;
-
-  Bounce _debouncer;
+  static constexpr uint8_t QUEUE_LENGTH = 8;
 
-  const gpio_num_t _PIN;
-  unsigned long _pressStartTime;
-  bool _longPressDetected;
+  // Id de las entradas de la cola: flancos del boton o timer vencido
+  enum : uint8_t { BUTTON_EDGE, LONG_PRESS };
 
-  // Callbacks de eventos
-  std::map<Event, std::function<void()>> _callbacks;
+  DebouncedInput _input;
+  EventBus& _bus;
+  QueueHandle_t _queue = NULL;
+  TimerHandle_t _longPressTimer = NULL;
+  StaticQueue<DebouncedInput::Edge, QUEUE_LENGTH> _queueStorage;
+  StaticTimer _longPressTimerStorage;
+  uint32_t _pressStartTime = 0;
+  bool _longPressDetected = false;
 
   // Metodos privados
-  void _trigger(Event event);
-};
\ No newline at end of file
+  void _onChange(uint8_t level, uint32_t time);
+  static void _onLongPressTimer(TimerHandle_t timer);
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+// Tramo medido hasta el final del bloque; name debe ser un literal. Sin
+// -DTRACE_ENABLED no genera codigo
+#ifdef TRACE_ENABLED
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(_traceScope, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) \
+  do {                    \
+  } while (0)
+#endif
+
+#ifdef TRACE_ENABLED
+// Traza de las rutas criticas exportable a chrome://tracing o Perfetto. Cada
+// nucleo escribe eventos inicio/fin con el contador de ciclos en su propio
+// buffer circular; con la traza desactivada un tramo solo lee un bool.
+class Trace {
+ public:
+  static constexpr uint16_t CAPACITY = 256;   // Eventos por nucleo
+  static constexpr uint8_t MAX_THREADS = 16;  // Tareas nombradas al exportar
+  static constexpr uint8_t MAX_OPEN = 32;     // Tramos abiertos al emparejar
+
+  // Evento del formato Chrome trace: 'B' inicio, 'E' fin, 'M' nombre de tarea
+  struct Event {
+    const char* name;
+    char phase;
+    uint8_t core;
+    uint32_t tid;  // Handle de la tarea
+    double time;   // us desde la activacion
+  };
+
+  class Scope {
+   public:
+    explicit Scope(const char* name) : _name(_isEnabled ? name : nullptr) {
+      if (_name != nullptr) _record(_name, 'B');
+    }
+    ~Scope() {
+      if (_name != nullptr) _record(_name, 'E');
+    }
+
+   private:
+    const char* _name;
+  };
+
+  // Recorre los buffers con la grabacion en pausa mientras exista, para que
+  // la propia exportacion no desplace eventos. Solo salen los tramos con
+  // inicio y fin; una reactivacion termina la exportacion
+  class Export {
+   public:
+    Export();
+    ~Export();
+    bool next(Event& event);
+
+   private:
+    uint32_t _session;
+    uint32_t _position[portNUM_PROCESSORS];
+    uint32_t _end[portNUM_PROCESSORS];
+    uint32_t _matched[portNUM_PROCESSORS][CAPACITY / 32];  // Bit por hueco
+    uint8_t _core = 0;
+    TaskHandle_t _threads[MAX_THREADS];
+    uint8_t _threadCount = 0;
+    uint8_t _nextThread = 0;
+
+    void _match();
+    bool _isMatched(uint8_t core, uint32_t position) const;
+  };
+
+  static bool begin();
+  static bool setEnabled(bool enabled);
+  static bool isEnabled() { return _isEnabled; }
+
+ private:
+  static volatile bool _isEnabled;
+
+  static void _record(const char* name, char phase);
+  static bool _idleHook();
+};
+#endif
@@ -1,17 +1,55 @@
 #pragma once
 
+#include <ArduinoJson.h>
 #include <CRC8.h>
 #include <WiFi.h>
 
+#include "Trace.hpp"
+
+// Tamanos de buffer de texto, terminador incluido
+constexpr size_t MAC_TEXT_SIZE = 18;      // "AA:BB:CC:DD:EE:FF"
+constexpr size_t VERSION_TEXT_SIZE = 12;  // "255.255.255"
+constexpr size_t NUMBER_TEXT_SIZE = 24;   // Entero o decimal con signo
+
 void sanitizeInput(String& input, size_t maxLength = 32);
 bool isNetworkSecure(wifi_auth_mode_t ecryptionType);
-String formatBooleanToText(const bool data);
-String macToString(const uint8_t* mac);
+const char* formatBooleanToText(const bool data);
+
+// Las funciones format* escriben en un buffer del llamador sin usar el heap
+// y devuelven la longitud que tendria el texto completo, como snprintf
+size_t formatMac(char* dest, size_t size, const uint8_t* mac);
+size_t formatFirmwareVersion(char* dest, size_t size,
+                             const uint8_t* firmwareVersion);
+// Punto fijo: no depende del printf de coma flotante (que reserva memoria)
+size_t formatFixed(char* dest, size_t size, float value, uint8_t decimals);
 void stringToMac(const String& macStr, uint8_t* macDest);
-String firmwareVersionToString(const uint8_t* firmwareVersion);
 bool stringToFirmwareVersion(const String& firmwareVersionStr,
                              uint8_t* firmwareVersionDest);
 uint8_t calcCRC8(const uint8_t* data, size_t length);
+uint32_t calcCRC32(const uint8_t* data, size_t length, uint32_t crc = 0);
+
+// Texto en la pila, valido hasta el final de la expresion que lo crea:
+//   Serial.printf("%s", MacText(mac).c_str());
+template <size_t N>
+class FixedText {
+ public:
+  const char* c_str() const { return _text; }
+
+ protected:
+  char _text[N];
+};
+
+class MacText : public FixedText<MAC_TEXT_SIZE> {
+ public:
+  explicit MacText(const uint8_t* mac) { formatMac(_text, sizeof(_text), mac); }
+};
+
+class VersionText : public FixedText<VERSION_TEXT_SIZE> {
+ public:
+  explicit VersionText(const uint8_t* firmwareVersion) {
+    formatFirmwareVersion(_text, sizeof(_text), firmwareVersion);
+  }
+};
 
 template <typename T>
 void addCRC8(T& msg) {
@@ -21,6 +59,7 @@ void addCRC8(T& msg) {
 
 template <typename T>
 bool verifyCRC8(const T& msg) {
+  TRACE_SCOPE("crc8");
   CRC8 crc(CRC8_DALLAS_MAXIM_POLYNOME);
   crc.reset();
 
@@ -30,3 +69,67 @@ bool verifyCRC8(const T& msg) {
 
   return crc.calc() == data[sizeof(T) - 1];
 }
+
+// Allocator de ArduinoJson sobre un buffer fijo: el consumo maximo de memoria
+// de un documento queda acotado a N bytes y nunca toca el heap. Si el buffer
+// se agota la deserializacion falla con NoMemory.
+template <size_t N>
+class JsonPool : public ArduinoJson::Allocator {
+ public:
+  // Liberar todo el buffer antes de reutilizarlo con otro documento
+  void reset() {
+    _used = 0;
+    _last = N;
+  }
+
+  size_t getUsed() const { return _used; }
+
+  void* allocate(size_t size) override {
+    const size_t total = _align(sizeof(size_t) + size);
+    if (total > N - _used) return nullptr;
+
+    size_t* block = reinterpret_cast<size_t*>(_buffer + _used);
+    *block = size;
+    _last = _used;
+    _used += total;
+    return block + 1;
+  }
+
+  void deallocate(void* ptr) override {
+    // Solo se recupera el ultimo bloque; el resto vuelve con reset()
+    if (ptr != nullptr && _offsetOf(ptr) == _last) {
+      _used = _last;
+      _last = N;
+    }
+  }
+
+  void* reallocate(void* ptr, size_t size) override {
+    if (ptr == nullptr) return allocate(size);
+
+    size_t* block = static_cast<size_t*>(ptr) - 1;
+
+    // Encoger o crecer el ultimo bloque se hace en sitio
+    if (size <= *block || (_offsetOf(ptr) == _last &&
+                           _align(sizeof(size_t) + size) <= N - _last)) {
+      *block = size;
+      if (_offsetOf(ptr) == _last)
+        _used = _last + _align(sizeof(size_t) + size);
+      return ptr;
+    }
+
+    void* newPtr = allocate(size);
+    if (newPtr != nullptr) memcpy(newPtr, ptr, *block);
+    return newPtr;
+  }
+
+ private:
+  alignas(8) uint8_t _buffer[N];
+  size_t _used = 0;
+  size_t _last = N;  // Offset del ultimo bloque asignado
+
+  static size_t _align(const size_t size) { return (size + 7) & ~size_t(7); }
+
+  size_t _offsetOf(void* ptr) const {
+    return static_cast<uint8_t*>(ptr) - sizeof(size_t) - _buffer;
+  }
+};
@@ -2,21 +2,153 @@
 
 #include <ESPAsyncWebServer.h>
 
+#include <functional>
+#include <vector>
+
 #include "ConfigManager.hpp"
+#include "EmbeddedAssets.hpp"
+#include "EventBus.hpp"
+#include "NodeOtaManager.hpp"
+#include "NowManager.hpp"
+#include "PowerManager.hpp"
+#include "StaticAlloc.hpp"
 #include "WiFiManager.hpp"
 
 class WebServerManager {
  public:
-  WebServerManager(ConfigManager& config, WiFiManager& wifi);
-  String begin();
-  void end();
+  static constexpr size_t MAX_WIFI_BODY_SIZE = 256;  // Cuerpo de /setup/wifi
+  static constexpr size_t JSON_POOL_SIZE = 1024;     // Memoria JSON maxima
+  static constexpr const char* ASSET_MANIFEST_PATH = "/www/manifest.txt";
+  static constexpr size_t MAX_API_BODY_SIZE = 128;    // Cuerpo de /api/*
+  static constexpr size_t API_RECORD_SIZE = 384;      // Registro JSON maximo
+  static constexpr size_t API_RECORD_POOL_SIZE = 1024;
+  static constexpr uint32_t PUSH_COALESCE_WINDOW = 100;  // 100ms
+  static constexpr uint8_t MAX_WS_CLIENTS = 4;
+  static constexpr size_t MAX_WS_QUEUE = 8;  // Mensajes pendientes por cliente
+  static constexpr uint8_t MAX_PUSH_SENSORS = 32;
+  static constexpr uint8_t MAX_PUSH_ACTUATORS = 16;
+  static constexpr uint32_t REQUEST_RATE_WINDOW = 10000;  // 10s
+
+  // Tipos de trama y registro del protocolo binario de /ws
+  enum class PushFrame : uint8_t { DELTA = 1, SNAPSHOT = 2 };
+  enum class PushRecord : uint8_t { SENSOR = 1, ACTUATOR = 2 };
+
+#pragma pack(push, 1)  // Empaquetamiento estricto sin padding
+  struct PushHeader {
+    uint8_t frameType;  // PushFrame
+    uint8_t count;      // Registros que siguen a la cabecera
+  };
+
+  struct SensorRecord {
+    uint8_t recordType = static_cast<uint8_t>(PushRecord::SENSOR);
+    uint8_t mac[6];
+    char variable[8];
+    uint8_t connected;
+    uint8_t valueType;  // NowManager::SensorValueType
+    uint8_t value[4];   // float, int32 o bool (little endian)
+  };
+
+  struct ActuatorRecord {
+    uint8_t recordType = static_cast<uint8_t>(PushRecord::ACTUATOR);
+    uint8_t mac[6];
+    uint8_t connected;
+    uint8_t state;
+  };
+#pragma pack(pop)
+
+  struct UpdateStats {
+    size_t written = 0;          // Bytes escritos en la particion OTA
+    size_t total = 0;            // Tamano del fichero (o cota superior)
+    uint32_t startTime = 0;      // Timestamp de inicio (ms)
+    uint32_t elapsed = 0;        // Duracion de la subida (ms)
+    uint32_t startFreeHeap = 0;  // Heap libre al comenzar
+    uint32_t minFreeHeap = 0;    // Heap libre minimo durante la subida
+    bool success = false;
+  };
+
+  // Escribe el registro index en record; false si no quedan registros
+  typedef std::function<bool(size_t index, JsonObject record)> RecordWriter;
+
+  WebServerManager(ConfigManager& config, WiFiManager& wifi, NowManager& now,
+                   NodeOtaManager& nodeOta, PowerManager& power,
+                   EventBus& bus);
+  // Rutas y servidor se crean una vez y escuchan en AP y STA; el portal
+  // solo levanta el punto de acceso y habilita las rutas de configuracion
   void setupRoutes();
-  bool getIsListening() const { return _isListening; }
+  void begin();
+  String openPortal();
+  void closePortal();
+  bool isPortalOpen() const { return _isPortalOpen; }
+  UpdateStats getUpdateStats() const { return _updateStats; }
+  void notifyDataChanged();
 
  private:
-  bool _isListening;
+  struct Asset {
+    String url;
+    String etag;  // Hash del contenido, entre comillas
+    String mime;
+    bool immutable;  // Nombre con hash: cache de larga duracion
+  };
+
+  volatile bool _isPortalOpen = false;
   AsyncWebServer _server{80};
+  AsyncWebSocket _ws{"/ws"};
   ConfigManager& _config;
   WiFiManager& _wifi;
+  NowManager& _now;
+  NodeOtaManager& _nodeOta;
+  PowerManager& _power;
+  EventBus& _bus;
   ConfigManager::NetworkConfig _partialConfig;
+  UpdateStats _updateStats;
+  uint8_t _updateProgress = 0;
+  AsyncWebServerRequest* _nodeUploadRequest = nullptr;  // Subida en curso
+  bool _isNodeUploadOk = false;
+  JsonPool<JSON_POOL_SIZE> _jsonPool;  // Las peticiones se atienden en serie
+
+  // Tasa de peticiones a la API, medida por ventanas
+  uint32_t _apiRequests = 0;
+  uint32_t _rateWindowStart = 0;
+  uint32_t _rateWindowRequests = 0;
+  float _requestRate = 0;  // Peticiones/s en la ultima ventana completa
+#ifndef EMBED_WEB_ASSETS
+  std::vector<Asset> _assets;
+#endif
+
+  // Push de cambios por WebSocket
+  TaskHandle_t _pushTaskHandler = NULL;
+  SemaphoreHandle_t _wsMutex = NULL;
+  StaticTask<4096> _pushTaskStorage;
+  StaticMutex _wsMutexStorage;
+  uint32_t _wsClientIds[MAX_WS_CLIENTS] = {};  // 0 = libre
+  volatile bool _needsSnapshot = false;  // Cliente nuevo: enviar todo
+  uint32_t _droppedClients = 0;          // Clientes lentos desconectados
+  SensorRecord _sentSensors[MAX_PUSH_SENSORS];  // Ultimo estado enviado
+  ActuatorRecord _sentActuators[MAX_PUSH_ACTUATORS];
+  uint8_t _sentSensorCount = 0;
+  uint8_t _sentActuatorCount = 0;
+
+  // Métodos privados
+  static void _receiveBody(AsyncWebServerRequest* request, uint8_t* data,
+                           size_t len, size_t index, size_t total,
+                           size_t maxSize);
+  static void _releaseBody(AsyncWebServerRequest* request);
+  bool _checkPortal(AsyncWebServerRequest* request);
+  void _countRequest();
+#ifdef EMBED_WEB_ASSETS
+  static const EmbeddedAsset* _findAsset(const char* path);
+#else
+  void _loadAssetManifest();
+  const Asset* _findAsset(const char* path);
+#endif
+  void _handleAsset(AsyncWebServerRequest* request);
+  void _setupApiRoutes();
+  void _onWsEvent(AsyncWebSocketClient* client, AwsEventType type);
+  static void _pushTask(void* parameter);
+  void _pushUpdates();
+  static void _sendJsonArray(AsyncWebServerRequest* request,
+                             RecordWriter writer);
+  void _handleUpdateUpload(AsyncWebServerRequest* request, size_t index,
+                           uint8_t* data, size_t len, bool final);
+  bool _finishUpdate(AsyncWebServerRequest* request);
 };
\ No newline at end of file
@@ -2,24 +2,98 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/timers.h>
 
-#include <vector>
+#include "EventBus.hpp"
+#include "StaticAlloc.hpp"
 
 class WiFiManager {
  public:
+  static constexpr uint8_t MAX_SCAN_RESULTS = 20;
+  static constexpr uint32_t SCAN_CACHE_TTL = 30000;  // 30s
+  static constexpr uint32_t SCAN_CHANNEL_TIME = 300;  // 300ms por canal
+  static constexpr uint32_t STA_CONNECT_TIMEOUT = 15000;  // 15s
+  static constexpr uint32_t STA_BACKOFF_BASE = 1000;      // 1s
+  static constexpr uint32_t STA_BACKOFF_MAX = 60000;      // 60s
+  static constexpr uint8_t STA_MAX_AUTH_FAILURES = 3;     // Clave incorrecta
+  static constexpr uint8_t STA_QUEUE_LENGTH = 8;  // Entradas sin atender
+
+  enum class ScanState { SCANNING, READY, FAILED };
+
+  enum class StaState { IDLE, CONNECTING, CONNECTED, BACKOFF, FAILED };
+
   struct ScanResult {
-    String ssid;
+    char ssid[33];  // 32 + '\0'
     int32_t rssi;
     bool secure;
   };
 
+  explicit WiFiManager(EventBus& bus) : _bus(bus) {}
+  bool init();
   void modeAPSTA();
   String startAP(const String& ssid, const String& password);
   void closeAP();
-  bool connectSTA(const String& ssid, const String& password);
-  void scanNetworks();
-  const std::vector<ScanResult>& getScanResults() const;
+  bool startSTA(const String& ssid, const String& password);
+  StaState getStaState() const { return _staState; }
+  uint32_t getLastReconnectTime() const { return _lastReconnectTime; }
+  uint32_t getReconnectCount() const { return _reconnects; }
+  static const char* staStateToText(StaState state);
+  ScanState requestScan();
+  uint8_t getScanResults(ScanResult* results, const uint8_t maxResults);
 
  private:
-  std::vector<ScanResult> _scanResults;
-};
\ No newline at end of file
+  // Entradas de la maquina de estados STA; solo su tarea las atiende
+  enum class StaInput : uint8_t { START, TIMER, GOT_IP, DISCONNECTED };
+
+  struct StaMessage {
+    StaInput input;
+    uint8_t reason;      // DISCONNECTED: motivo del driver
+    esp_ip4_addr_t ip;   // GOT_IP: direccion asignada
+  };
+
+  EventBus& _bus;
+
+  // Almacenamiento fijo: cada escaneo lo reescribe sin reservar memoria
+  ScanResult _scanResults[MAX_SCAN_RESULTS];
+  uint8_t _scanCount = 0;
+  uint32_t _scanTime = 0;  // Timestamp del ultimo escaneo completo (ms)
+  bool _hasScan = false;
+  bool _isScanning = false;
+  bool _scanFailed = false;
+  SemaphoreHandle_t _mutex = NULL;
+  TaskHandle_t _scanTaskHandler = NULL;
+  StaticMutex _mutexStorage;
+  StaticTask<4096> _scanTaskStorage;
+
+  // Conexion STA dirigida por eventos
+  char _staSsid[33];      // 32 + '\0'
+  char _staPassword[65];  // 64 + '\0'
+  volatile StaState _staState = StaState::IDLE;
+  uint8_t _staAttempts = 0;      // Intentos fallidos seguidos
+  uint8_t _authFailures = 0;     // Rechazos de autenticacion seguidos
+  uint32_t _disconnectedAt = 0;  // Timestamp de la perdida de conexion
+  uint32_t _lastReconnectTime = 0;  // Duracion de la ultima reconexion (ms)
+  uint32_t _reconnects = 0;         // Reconexiones tras perder la conexion
+  TickType_t _staDeadline = 0;      // Vencimiento del plazo armado (ticks)
+  TimerHandle_t _staTimer = NULL;
+  QueueHandle_t _staQueue = NULL;
+  TaskHandle_t _staTaskHandler = NULL;
+  StaticTimer _staTimerStorage;
+  StaticQueue<StaMessage, STA_QUEUE_LENGTH> _staQueueStorage;
+  StaticTask<4096> _staTaskStorage;
+
+  // Métodos privados
+  static void _scanTask(void* parameter);
+  void _scanNetworks();
+  static void _staTimerCallback(TimerHandle_t timer);
+  static void _staTask(void* parameter);
+  void _onWiFiEvent(arduino_event_id_t event, arduino_event_info_t info);
+  void _postSta(const StaMessage& message);
+  void _handleSta(const StaMessage& message);
+  void _connectSTA();
+  void _scheduleReconnect();
+  void _armStaTimer(const uint32_t timeout);
+};
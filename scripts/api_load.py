@@ -0,0 +1,80 @@
+# Generador de carga para la API REST del master: lanza peticiones GET
+# concurrentes contra /api/devices, /api/sensors y /api/actuators y mide la
+# tasa sostenida y la latencia. Al terminar lee /api/http para comparar con
+# la tasa que mide el propio master.
+#
+# Uso: python scripts/api_load.py <ip> [segundos] [conexiones]
+
+import json
+import sys
+import threading
+import time
+import urllib.request
+
+ROUTES = ["/api/devices", "/api/sensors", "/api/actuators"]
+TIMEOUT = 5  # s por peticion
+
+
+def worker(base, deadline, results, lock):
+    count = 0
+    errors = 0
+    latencies = []
+
+    while time.monotonic() < deadline:
+        route = ROUTES[count % len(ROUTES)]
+        start = time.monotonic()
+        try:
+            with urllib.request.urlopen(base + route, timeout=TIMEOUT) as r:
+                json.load(r)  # La respuesta completa debe ser JSON valido
+            latencies.append(time.monotonic() - start)
+        except Exception:
+            errors += 1
+        count += 1
+
+    with lock:
+        results["requests"] += count
+        results["errors"] += errors
+        results["latencies"] += latencies
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("Uso: api_load.py <ip> [segundos] [conexiones]")
+        sys.exit(1)
+
+    base = "http://" + sys.argv[1]
+    duration = float(sys.argv[2]) if len(sys.argv) > 2 else 30
+    connections = int(sys.argv[3]) if len(sys.argv) > 3 else 2
+
+    results = {"requests": 0, "errors": 0, "latencies": []}
+    lock = threading.Lock()
+    deadline = time.monotonic() + duration
+    threads = [
+        threading.Thread(target=worker, args=(base, deadline, results, lock))
+        for _ in range(connections)
+    ]
+
+    start = time.monotonic()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.monotonic() - start
+
+    latencies = sorted(results["latencies"])
+    ok = len(latencies)
+    print("Peticiones: %d (%d errores) en %.1f s" %
+          (results["requests"], results["errors"], elapsed))
+    print("Tasa: %.1f peticiones/s correctas" % (ok / elapsed))
+    if ok > 0:
+        print("Latencia: media %.1f ms, p95 %.1f ms, max %.1f ms" %
+              (1000 * sum(latencies) / ok,
+               1000 * latencies[min(ok - 1, int(ok * 0.95))],
+               1000 * latencies[-1]))
+
+    with urllib.request.urlopen(base + "/api/http", timeout=TIMEOUT) as r:
+        print("Master: %s" % json.load(r))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,137 @@
+# Genera la imagen de LittleFS a partir de data/: los ficheros de www/ se
+# guardan comprimidos con gzip y se anaden a www/manifest.txt con su ETag,
+# tipo MIME y politica de cache. El resto de ficheros se copia sin cambios.
+#
+# Con -DEMBED_WEB_ASSETS los assets comprimidos no van a LittleFS: se genera
+# WebAssetData.hpp con los datos como arrays en flash y un manifiesto
+# ordenado por ruta para buscarlo con busqueda binaria.
+#
+# Uso como script de PlatformIO (extra_scripts = pre:...) o a mano:
+#   python scripts/build_assets.py [origen] [destino] [dir_cabecera]
+
+import gzip
+import hashlib
+import os
+import re
+import shutil
+import sys
+
+MIME_TYPES = {
+    ".html": "text/html",
+    ".js": "application/javascript",
+    ".css": "text/css",
+    ".svg": "image/svg+xml",
+    ".ttf": "font/ttf",
+    ".woff2": "font/woff2",
+    ".png": "image/png",
+    ".ico": "image/x-icon",
+    ".json": "application/json",
+}
+
+# Nombres con hash de contenido generados por Vite: nunca cambian
+HASHED_NAME = re.compile(r"-[A-Za-z0-9_-]{8}\.[a-z0-9]+$")
+
+
+def write_header(path, assets):
+    # El orden debe coincidir con strcmp en el firmware (bytes, no locale)
+    assets = sorted(assets, key=lambda asset: asset[0].encode())
+
+    with open(path, "w") as f:
+        f.write("// Generado por scripts/build_assets.py. No editar.\n")
+        f.write("#pragma once\n\n#include \"EmbeddedAssets.hpp\"\n\n")
+        f.write("namespace WebAssetData {\n\n")
+
+        for i, (_, _, _, _, compressed) in enumerate(assets):
+            f.write("static const uint8_t DATA_%d[] PROGMEM = {\n" % i)
+            for start in range(0, len(compressed), 16):
+                line = compressed[start:start + 16]
+                f.write("    %s,\n" % ", ".join("0x%02x" % b for b in line))
+            f.write("};\n\n")
+
+        f.write("static constexpr EmbeddedAsset MANIFEST[] = {\n")
+        for i, (url, etag, mime, immutable, compressed) in enumerate(assets):
+            f.write("    {\"%s\", DATA_%d, %d, \"%s\", \"\\\"%s\\\"\", %s},\n"
+                    % (url, i, len(compressed), mime, etag,
+                       "true" if immutable else "false"))
+        f.write("};\n\n")
+
+        f.write("static_assert(isManifestSorted(MANIFEST, %d),\n" % len(assets))
+        f.write("              \"Manifest must be sorted by path\");\n\n")
+        f.write("}  // namespace WebAssetData\n")
+
+
+def build_assets(source_dir, output_dir, header_dir=None):
+    if os.path.isdir(output_dir):
+        shutil.rmtree(output_dir)
+
+    web_dir = os.path.join(source_dir, "www")
+    assets = []
+    raw_total = 0
+    gzip_total = 0
+
+    for root, _, files in os.walk(source_dir):
+        for name in sorted(files):
+            path = os.path.join(root, name)
+            rel = os.path.relpath(path, source_dir).replace(os.sep, "/")
+            dest = os.path.join(output_dir, rel)
+
+            if not path.startswith(web_dir + os.sep):
+                os.makedirs(os.path.dirname(dest), exist_ok=True)
+                shutil.copyfile(path, dest)
+                continue
+
+            with open(path, "rb") as f:
+                data = f.read()
+
+            # mtime fijo: la misma entrada genera siempre los mismos bytes
+            compressed = gzip.compress(data, compresslevel=9, mtime=0)
+
+            if header_dir is None:
+                os.makedirs(os.path.dirname(dest), exist_ok=True)
+                with open(dest + ".gz", "wb") as f:
+                    f.write(compressed)
+
+            url = "/" + os.path.relpath(path, web_dir).replace(os.sep, "/")
+            ext = os.path.splitext(name)[1].lower()
+            etag = hashlib.sha256(data).hexdigest()[:16]
+            immutable = 1 if HASHED_NAME.search(name) else 0
+            mime = MIME_TYPES.get(ext, "application/octet-stream")
+            assets.append((url, etag, mime, immutable, compressed))
+
+            raw_total += len(data)
+            gzip_total += len(compressed)
+            print("  %-40s %7d -> %7d bytes"
+                  % (url, len(data), len(compressed)))
+
+    if header_dir is None:
+        with open(os.path.join(output_dir, "www", "manifest.txt"), "w") as f:
+            for url, etag, mime, immutable, _ in assets:
+                f.write("%s %s %s %d\n" % (url, etag, mime, immutable))
+    else:
+        os.makedirs(header_dir, exist_ok=True)
+        write_header(os.path.join(header_dir, "WebAssetData.hpp"), assets)
+
+    print("Web assets: %d -> %d bytes (gzip)" % (raw_total, gzip_total))
+
+
+def is_embedded(env):
+    defines = env.ParseFlags(env.get("BUILD_FLAGS", [])).get("CPPDEFINES", [])
+    return any((d[0] if isinstance(d, (list, tuple)) else d) ==
+               "EMBED_WEB_ASSETS" for d in defines)
+
+
+if __name__ == "__main__":
+    build_assets(sys.argv[1] if len(sys.argv) > 1 else "data",
+                 sys.argv[2] if len(sys.argv) > 2 else ".pio/data",
+                 sys.argv[3] if len(sys.argv) > 3 else None)
+else:
+    Import("env")  # noqa: F821
+
+    header_dir = None
+    if is_embedded(env):  # noqa: F821
+        header_dir = os.path.join(env.subst("$PROJECT_BUILD_DIR"),  # noqa
+                                  "web_assets")
+        env.Append(CPPPATH=[header_dir])  # noqa: F821
+
+    build_assets(os.path.join(env["PROJECT_DIR"], "data"),  # noqa: F821
+                 env["PROJECT_DATA_DIR"], header_dir)  # noqa: F821
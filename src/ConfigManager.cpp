@@ -2,123 +2,496 @@
 
 #include <LittleFS.h>
 
+#include <algorithm>
+
+#include "Logger.hpp"
+#include "NowManager.hpp"
+#include "PowerManager.hpp"
+#include "Trace.hpp"
 #include "Utils.hpp"
 
+// Cualquier cambio de disposicion debe ir acompanado de IMAGE_VERSION
+static_assert(sizeof(ConfigManager::NodeInfo) == 44,
+              "NodeInfo layout changed: bump IMAGE_VERSION");
+
+const char* const ConfigManager::SLOT_PATHS[2] = {"/config_a.dat",
+                                                   "/config_b.dat"};
+
 bool ConfigManager::init() {
   if (!LittleFS.begin()) return false;
-  return _loadConfig();
+
+  _mutex = _mutexStorage.create();
+  if (_mutex == NULL) return false;
+
+  const uint32_t start = micros();
+
+  // El fichero solo se lee al arrancar; despues manda el modelo en memoria
+  if (!_loadConfig()) {
+    // Sin configuracion valida: arrancar con valores por defecto
+    _loadDefaults();
+    _isDirty = true;
+  }
+
+  LOG_INFO("Config cargada en %lu us (%d nodos)", micros() - start,
+           _image.nodeCount);
+
+  if (!_flushTaskStorage.create(_flushTask, "Config Flush", this, 1,
+                                &_flushTaskHandler, 1))
+    return false;
+
+  if (_isDirty) xTaskNotifyGive(_flushTaskHandler);
+
+  return true;
 }
 
 bool ConfigManager::_loadConfig() {
-  File configFile = LittleFS.open("/config.json", "r");
-  if (!configFile) return false;
+  SlotHeader headers[2];
+  const bool isValid[2] = {_readSlotHeader(0, headers[0]),
+                           _readSlotHeader(1, headers[1])};
 
-  JsonDocument doc;
-  if (deserializeJson(doc, configFile)) {
-    configFile.close();
-    return false;
+  // Probar primero el slot mas reciente y despues el otro
+  uint8_t order[2] = {0, 1};
+  if (isValid[1] &&
+      (!isValid[0] || headers[1].generation > headers[0].generation)) {
+    order[0] = 1;
+    order[1] = 0;
   }
 
-  _apConfig.ssid = doc["ap_ssid"].as<String>();
-  _apConfig.password = doc["ap_password"].as<String>();
-  _staConfig.ssid = doc["sta_ssid"].as<String>();
-  _staConfig.password = doc["sta_password"].as<String>();
-
-  JsonArray nodes = doc["nodes"].as<JsonArray>();
-  for (JsonObject node : nodes) {
-    NodeInfo newNode;
-    stringToMac(node["mac"], newNode.mac);
-    newNode.nodeType = node["node_type"].as<uint8_t>();
-    newNode.deviceName = node["device_name"].as<String>();
-    if (!stringToFirmwareVersion(node["firmware_version"],
-                                 newNode.firmwareVersion)) {
-      newNode.firmwareVersion[0] = 0;
-      newNode.firmwareVersion[1] = 0;
-      newNode.firmwareVersion[2] = 0;
+  for (const uint8_t slot : order) {
+    if (isValid[slot] && _loadSlot(slot, headers[slot])) {
+      _activeSlot = slot;
+      _generation = headers[slot].generation;
+      return true;
     }
+  }
 
-    _nodes.push_back(newNode);
+  // Primer arranque: importar el /config.json de fabrica a los slots
+  if (_loadLegacyConfig()) {
+    _isDirty = true;
+    return true;
   }
 
-  configFile.close();
+  return false;
+}
+
+bool ConfigManager::_readSlotHeader(const uint8_t slot, SlotHeader& header) {
+  File slotFile = LittleFS.open(SLOT_PATHS[slot], "r");
+  if (!slotFile) return false;
+
+  const bool isValid =
+      slotFile.read((uint8_t*)&header, sizeof(header)) == sizeof(header) &&
+      header.magic == SLOT_MAGIC && header.length == sizeof(ConfigImage);
+
+  slotFile.close();
+  return isValid;
+}
+
+bool ConfigManager::_loadSlot(const uint8_t slot, const SlotHeader& header) {
+  File slotFile = LittleFS.open(SLOT_PATHS[slot], "r");
+  if (!slotFile) return false;
+
+  // Una sola lectura directa a la imagen preasignada, sin parseo
+  ConfigImage image;
+  slotFile.seek(sizeof(SlotHeader));
+  const bool isRead =
+      slotFile.read((uint8_t*)&image, sizeof(image)) == sizeof(image);
+  slotFile.close();
+
+  if (!isRead || calcCRC32((uint8_t*)&image, sizeof(image)) != header.crc ||
+      image.version != IMAGE_VERSION || image.nodeCount > MAX_NODES)
+    return false;
+
+  _image = image;
   return true;
 }
 
-bool ConfigManager::saveSTAConfig(const String& ssid, const String& password) {
+bool ConfigManager::_loadLegacyConfig() {
   File configFile = LittleFS.open("/config.json", "r");
-  JsonDocument doc;
+  if (!configFile) return false;
 
-  if (deserializeJson(doc, configFile)) {
+  // Rechazar ficheros que no caben antes de empezar a parsear
+  if (configFile.size() > MAX_JSON_SIZE) {
     configFile.close();
     return false;
   }
 
+  _jsonPool.reset();
+  JsonDocument filter(&_jsonPool);
+  JsonDocument doc(&_jsonPool);
+  _buildFilter(filter);
+
+  const DeserializationError error = deserializeJson(
+      doc, configFile, DeserializationOption::Filter(filter));
   configFile.close();
-  doc["sta_ssid"] = ssid;
-  doc["sta_password"] = password;
 
-  return _writeConfig(doc);
+  if (error || !_isValidDocument(doc)) return false;
+
+  _loadDefaults();
+  _parseDocument(doc);
+  return true;
+}
+
+void ConfigManager::_loadDefaults() {
+  memset(&_image, 0, sizeof(_image));
+  _image.version = IMAGE_VERSION;
+  strlcpy(_image.ap.ssid, "HomeSphere Config", SSID_SIZE);
+  strlcpy(_image.ap.password, "123456789", PASSWORD_SIZE);
+}
+
+bool ConfigManager::saveSTAConfig(const String& ssid, const String& password) {
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  strlcpy(_image.sta.ssid, ssid.c_str(), SSID_SIZE);
+  strlcpy(_image.sta.password, password.c_str(), PASSWORD_SIZE);
+  _markDirty();
+  xSemaphoreGive(_mutex);
+
+  return true;
 }
 
 bool ConfigManager::saveNodeConfig(const uint8_t* mac, const uint8_t nodeType,
                                    const uint8_t* firmwareVersion) {
-  File configFile = LittleFS.open("/config.json", "r");
-  JsonDocument doc;
+  bool saved = true;
 
-  if (deserializeJson(doc, configFile)) {
-    configFile.close();
-    return false;
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+
+  // Buscar si ya existe el nodo
+  NodeInfo* node = _findNode(mac);
+
+  if (node != nullptr) {
+    memcpy(node->firmwareVersion, firmwareVersion, 3);
+  } else if (_image.nodeCount < MAX_NODES) {
+    NodeInfo& newNode = _image.nodes[_image.nodeCount++];
+    memset(&newNode, 0, sizeof(newNode));
+    memcpy(newNode.mac, mac, 6);
+    newNode.nodeType = nodeType;
+    strlcpy(newNode.deviceName, "Nodo Secundario", DEVICE_NAME_SIZE);
+    memcpy(newNode.firmwareVersion, firmwareVersion, 3);
+    newNode.reportInterval = NowManager::DEFAULT_REPORT_INTERVAL;
+    newNode.reportThreshold = NowManager::DEFAULT_REPORT_THRESHOLD;
+    newNode.relay = false;
+  } else {
+    saved = false;
   }
 
-  configFile.close();
-  JsonArray nodes = doc["nodes"].as<JsonArray>();
+  if (saved) _markDirty();
+  xSemaphoreGive(_mutex);
 
-  // Buscar si ya existe el nodo
-  bool exists = false;
-  String macStr = macToString(mac);
-
-  for (JsonObject node : nodes) {
-    if (node["mac"] == macStr) {
-      exists = true;
-      node["firmware_version"] = firmwareVersionToString(firmwareVersion);
-      break;
-    }
+  return saved;
+}
+
+bool ConfigManager::saveNodeReportConfig(const uint8_t* mac,
+                                         const uint32_t interval,
+                                         const float threshold) {
+  if (!NowManager::isValidReportConfig(interval, threshold)) return false;
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+
+  NodeInfo* node = _findNode(mac);
+
+  if (node != nullptr) {
+    node->reportInterval = interval;
+    node->reportThreshold = threshold;
+    _markDirty();
   }
 
-  // Add new node (max 12)
-  if (!exists && nodes.size() < 12) {
-    JsonObject newNode = nodes.add<JsonObject>();
-    newNode["mac"] = macStr;
-    newNode["node_type"] = nodeType;
-    newNode["device_name"] = "Nodo Secundario";
-    newNode["firmware_version"] = firmwareVersionToString(firmwareVersion);
+  xSemaphoreGive(_mutex);
+
+  return node != nullptr;
+}
+
+bool ConfigManager::saveNodeRelayRole(const uint8_t* mac, const bool enabled) {
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+
+  NodeInfo* node = _findNode(mac);
+
+  if (node != nullptr) {
+    node->relay = enabled;
+    _markDirty();
   }
 
-  if (!_writeConfig(doc)) return false;
+  xSemaphoreGive(_mutex);
 
-  return _loadConfig();
+  return node != nullptr;
 }
 
-void ConfigManager::printConfig() {
-  File configFile = LittleFS.open("/config.json", "r");
-  if (!configFile) return;
+bool ConfigManager::savePowerProfile(const uint8_t profile) {
+  if (!PowerManager::isValidProfile(profile)) return false;
 
-  JsonDocument doc;
-  if (deserializeJson(doc, configFile)) {
-    configFile.close();
-    return;
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  _image.powerProfile = profile;
+  _markDirty();
+  xSemaphoreGive(_mutex);
+
+  return true;
+}
+
+bool ConfigManager::importJson(const char* json, size_t length) {
+  if (length > MAX_JSON_SIZE) return false;
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+
+  _jsonPool.reset();
+  JsonDocument filter(&_jsonPool);
+  JsonDocument doc(&_jsonPool);
+  _buildFilter(filter);
+
+  const DeserializationError error = deserializeJson(
+      doc, json, length, DeserializationOption::Filter(filter));
+  const bool isValid =
+      !error && doc["ap_ssid"].is<const char*>() && _isValidDocument(doc);
+
+  if (isValid) {
+    // Una exportacion sin contrasenas no borra las guardadas
+    const NetworkRecord ap = _image.ap;
+    const NetworkRecord sta = _image.sta;
+
+    _loadDefaults();
+    _parseDocument(doc);
+
+    if (!doc["ap_password"].is<const char*>())
+      strlcpy(_image.ap.password, ap.password, PASSWORD_SIZE);
+    if (!doc["sta_password"].is<const char*>())
+      strlcpy(_image.sta.password, sta.password, PASSWORD_SIZE);
+
+    _markDirty();
   }
 
-  Serial.print("Config File: ");
-  serializeJsonPretty(doc, Serial);
-  Serial.println();
+  xSemaphoreGive(_mutex);
+
+  return isValid;
 }
 
-bool ConfigManager::_writeConfig(const JsonDocument& doc) {
-  File configFile = LittleFS.open("/config.json", "w");
-  if (!configFile) return false;
+bool ConfigManager::exportJson(Print& output, const bool includeSecrets) {
+  xSemaphoreTake(_mutex, portMAX_DELAY);
 
-  serializeJsonPretty(doc, configFile);
-  configFile.close();
+  _jsonPool.reset();
+  JsonDocument doc(&_jsonPool);
+  _buildDocument(doc);
+
+  // Sin las contrasenas; importJson conserva las actuales si faltan
+  if (!includeSecrets) {
+    doc.remove("ap_password");
+    doc.remove("sta_password");
+  }
+
+  const bool isComplete = !doc.overflowed();
+  if (isComplete) serializeJson(doc, output);
+
+  xSemaphoreGive(_mutex);
+
+  return isComplete;
+}
+
+bool ConfigManager::flush() {
+  // El mutex tambien serializa las escrituras de la tarea y de flush()
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+
+  if (!_isDirty) {
+    xSemaphoreGive(_mutex);
+    return true;
+  }
+
+  const bool isWritten = _writeConfig();
+  if (isWritten) _isDirty = false;
+
+  xSemaphoreGive(_mutex);
+
+  return isWritten;
+}
+
+ConfigManager::NetworkConfig ConfigManager::getAPConfig() {
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  const NetworkConfig apConfig = {_image.ap.ssid, _image.ap.password};
+  xSemaphoreGive(_mutex);
+
+  return apConfig;
+}
+
+ConfigManager::NetworkConfig ConfigManager::getSTAConfig() {
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  const NetworkConfig staConfig = {_image.sta.ssid, _image.sta.password};
+  xSemaphoreGive(_mutex);
+
+  return staConfig;
+}
+
+bool ConfigManager::getNode(const uint8_t index, NodeInfo& node) {
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  const bool isValid = index < _image.nodeCount;
+  if (isValid) node = _image.nodes[index];
+  xSemaphoreGive(_mutex);
+
+  return isValid;
+}
+
+uint8_t ConfigManager::getNodeLength() {
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  const uint8_t length = _image.nodeCount;
+  xSemaphoreGive(_mutex);
+
+  return length;
+}
+
+uint8_t ConfigManager::getPowerProfile() {
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  const uint8_t profile = _image.powerProfile;
+  xSemaphoreGive(_mutex);
+
+  return profile;
+}
+
+void ConfigManager::_flushTask(void* parameter) {
+  ConfigManager* config = static_cast<ConfigManager*>(parameter);
+
+  while (1) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    // Agrupar todos los cambios de la ventana en una sola escritura
+    vTaskDelay(pdMS_TO_TICKS(FLUSH_DEBOUNCE));
+
+    config->flush();
+  }
+}
+
+void ConfigManager::_buildFilter(JsonDocument& filter) {
+  // Solo se conservan los campos que usa la imagen binaria
+  filter["ap_ssid"] = true;
+  filter["ap_password"] = true;
+  filter["sta_ssid"] = true;
+  filter["sta_password"] = true;
+  filter["power_profile"] = true;
+
+  JsonObject node = filter["nodes"][0].to<JsonObject>();
+  node["mac"] = true;
+  node["node_type"] = true;
+  node["device_name"] = true;
+  node["firmware_version"] = true;
+  node["report_interval"] = true;
+  node["report_threshold"] = true;
+  node["relay"] = true;
+}
+
+bool ConfigManager::_isValidDocument(const JsonDocument& doc) {
+  // Los mismos limites que la API: los valores importados se envian a los
+  // nodos en el siguiente arranque
+  const int profile = doc["power_profile"] | 0;
+  if (profile < 0 || profile >= PowerManager::PROFILE_COUNT) return false;
+
+  JsonArrayConst nodes = doc["nodes"].as<JsonArrayConst>();
+  if (nodes.size() > MAX_NODES) return false;
+
+  for (JsonObjectConst node : nodes) {
+    if (!NowManager::isValidReportConfig(
+            node["report_interval"] | NowManager::DEFAULT_REPORT_INTERVAL,
+            node["report_threshold"] | NowManager::DEFAULT_REPORT_THRESHOLD))
+      return false;
+  }
+
+  return true;
+}
+
+void ConfigManager::_parseDocument(const JsonDocument& doc) {
+  strlcpy(_image.ap.ssid, doc["ap_ssid"] | "", SSID_SIZE);
+  strlcpy(_image.ap.password, doc["ap_password"] | "", PASSWORD_SIZE);
+  strlcpy(_image.sta.ssid, doc["sta_ssid"] | "", SSID_SIZE);
+  strlcpy(_image.sta.password, doc["sta_password"] | "", PASSWORD_SIZE);
+  _image.powerProfile = doc["power_profile"] | 0;
+
+  _image.nodeCount = 0;
+
+  JsonArrayConst nodes = doc["nodes"].as<JsonArrayConst>();
+  for (JsonObjectConst node : nodes) {
+    if (_image.nodeCount >= MAX_NODES) break;
+
+    NodeInfo& newNode = _image.nodes[_image.nodeCount++];
+    memset(&newNode, 0, sizeof(newNode));
+    stringToMac(node["mac"], newNode.mac);
+    newNode.nodeType = node["node_type"].as<uint8_t>();
+    strlcpy(newNode.deviceName, node["device_name"] | "Nodo Secundario",
+            DEVICE_NAME_SIZE);
+    if (!stringToFirmwareVersion(node["firmware_version"],
+                                 newNode.firmwareVersion)) {
+      newNode.firmwareVersion[0] = 0;
+      newNode.firmwareVersion[1] = 0;
+      newNode.firmwareVersion[2] = 0;
+    }
+    newNode.reportInterval =
+        node["report_interval"] | NowManager::DEFAULT_REPORT_INTERVAL;
+    newNode.reportThreshold =
+        node["report_threshold"] | NowManager::DEFAULT_REPORT_THRESHOLD;
+    newNode.relay = node["relay"] | false;
+  }
+}
+
+void ConfigManager::_buildDocument(JsonDocument& doc) {
+  doc["ap_ssid"] = _image.ap.ssid;
+  doc["ap_password"] = _image.ap.password;
+  doc["sta_ssid"] = _image.sta.ssid;
+  doc["sta_password"] = _image.sta.password;
+  doc["power_profile"] = _image.powerProfile;
+
+  JsonArray nodes = doc["nodes"].to<JsonArray>();
+  for (uint8_t i = 0; i < _image.nodeCount; i++) {
+    const NodeInfo& node = _image.nodes[i];
+    JsonObject newNode = nodes.add<JsonObject>();
+    newNode["mac"] = MacText(node.mac).c_str();
+    newNode["node_type"] = node.nodeType;
+    newNode["device_name"] = node.deviceName;
+    newNode["firmware_version"] =
+        VersionText(node.firmwareVersion).c_str();
+    newNode["report_interval"] = node.reportInterval;
+    newNode["report_threshold"] = node.reportThreshold;
+    newNode["relay"] = node.relay;
+  }
+}
+
+void ConfigManager::_markDirty() {
+  _isDirty = true;
+
+  if (_flushTaskHandler != NULL) xTaskNotifyGive(_flushTaskHandler);
+}
+
+ConfigManager::NodeInfo* ConfigManager::_findNode(const uint8_t* mac) {
+  NodeInfo* end = _image.nodes + _image.nodeCount;
+  NodeInfo* it = std::find_if(
+      _image.nodes, end,
+      [&mac](const NodeInfo& n) { return memcmp(n.mac, mac, 6) == 0; });
+
+  return (it != end) ? it : nullptr;
+}
+
+bool ConfigManager::_writeConfig() {
+  TRACE_SCOPE("config_write");
+
+  // Siempre se escribe el slot inactivo; el activo queda intacto si se corta
+  // la alimentacion a mitad de la escritura
+  const uint8_t slot = 1 - _activeSlot;
+  const char* path = SLOT_PATHS[slot];
+
+  // Sobrescribir en sitio evita truncar y reasignar bloques en LittleFS
+  File slotFile = LittleFS.open(path, LittleFS.exists(path) ? "r+" : "w");
+  if (!slotFile) return false;
+
+  SlotHeader header;
+  header.magic = 0;  // Invalido hasta completar la escritura
+  header.generation = _generation + 1;
+  header.length = sizeof(ConfigImage);
+  header.crc = calcCRC32((uint8_t*)&_image, sizeof(ConfigImage));
+
+  slotFile.write((uint8_t*)&header, sizeof(header));
+  const bool isImageWritten = slotFile.write((uint8_t*)&_image,
+                                             sizeof(_image)) == sizeof(_image);
+
+  // La cabecera valida se escribe al final: es el commit
+  header.magic = SLOT_MAGIC;
+  const bool isWritten = isImageWritten && slotFile.seek(0) &&
+                         slotFile.write((uint8_t*)&header, sizeof(header)) ==
+                             sizeof(header);
+  slotFile.close();
+
+  if (!isWritten) return false;
+
+  _activeSlot = slot;
+  _generation = header.generation;
   return true;
-}
\ No newline at end of file
+}
@@ -0,0 +1,66 @@
+#include "DebouncedInput.hpp"
+
+#include <driver/gpio.h>
+
+bool DebouncedInput::begin(QueueHandle_t queue) {
+  if (queue == NULL) return false;
+
+  _queue = queue;
+  pinMode(_pin, INPUT_PULLUP);
+  _level = digitalRead(_pin);
+  _lastChange = micros();
+  attachInterruptArg(_pin, _onEdge, this, CHANGE);
+
+  return true;
+}
+
+bool DebouncedInput::accept(const Edge& edge) {
+  // Rebote o flanco perdido: el nivel real se lee al acabar el intervalo
+  if (edge.level == _level ||
+      edge.time - _lastChange < DEBOUNCE_INTERVAL * 1000UL) {
+    _needsCheck = true;
+    return false;
+  }
+
+  _level = edge.level;
+  _lastChange = edge.time;
+  _needsCheck = false;
+  return true;
+}
+
+bool DebouncedInput::settle() {
+  const uint32_t now = micros();
+  if (!_needsCheck || now - _lastChange < DEBOUNCE_INTERVAL * 1000UL)
+    return false;
+
+  // Pulsacion corta soltada dentro del intervalo, o pulsada justo despues
+  // de soltar: el pin dice como quedo
+  _needsCheck = false;
+  const uint8_t level = gpio_get_level(_pin);
+  if (level == _level) return false;
+
+  _level = level;
+  _lastChange = now;
+  return true;
+}
+
+TickType_t DebouncedInput::nextCheck() const {
+  if (!_needsCheck) return portMAX_DELAY;
+
+  const uint32_t elapsed = micros() - _lastChange;
+  if (elapsed >= DEBOUNCE_INTERVAL * 1000UL) return 0;
+
+  return pdMS_TO_TICKS((DEBOUNCE_INTERVAL * 1000UL - elapsed) / 1000 + 1);
+}
+
+void IRAM_ATTR DebouncedInput::_onEdge(void* arg) {
+  const DebouncedInput* input = static_cast<const DebouncedInput*>(arg);
+  const Edge edge = {input->_id,
+                     static_cast<uint8_t>(gpio_get_level(input->_pin)),
+                     static_cast<uint32_t>(micros())};
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+  // Cola llena: el flanco se pierde y el siguiente resincroniza el estado
+  xQueueSendFromISR(input->_queue, &edge, &higherPriorityTaskWoken);
+  if (higherPriorityTaskWoken) portYIELD_FROM_ISR();
+}
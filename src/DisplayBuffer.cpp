@@ -0,0 +1,62 @@
+#include "DisplayBuffer.hpp"
+
+DisplayBuffer::DisplayBuffer() {
+  clear();
+  invalidate();
+}
+
+void DisplayBuffer::clear() {
+  memset(_next, ' ', sizeof(_next));
+  _col = 0;
+  _row = 0;
+}
+
+void DisplayBuffer::setCursor(uint8_t col, uint8_t row) {
+  _col = col;
+  _row = row;
+}
+
+size_t DisplayBuffer::write(uint8_t c) {
+  // Lo que queda fuera de la pantalla no es visible: se descarta
+  if (_row >= ROWS || _col >= COLS) return 0;
+
+  _next[_row][_col++] = c;
+  return 1;
+}
+
+void DisplayBuffer::invalidate() { _isValid = false; }
+
+DisplayBuffer::FlushStats DisplayBuffer::flushTo(LiquidCrystal& lcd) {
+  FlushStats stats;
+  const uint32_t start = micros();
+
+  // Sin estado conocido del LCD se escribe todo sin usar clear() (1.5ms)
+  if (!_isValid) {
+    memset(_shown, 0, sizeof(_shown));
+    _isValid = true;
+  }
+
+  for (uint8_t row = 0; row < ROWS; row++) {
+    int8_t cursor = -1;  // Columna del cursor del LCD en esta fila
+
+    for (uint8_t col = 0; col < COLS; col++) {
+      if (_next[row][col] == _shown[row][col]) continue;
+
+      // Un hueco de una celda cuesta lo mismo reescribirlo que saltarlo
+      if (cursor >= 0 && col - cursor == 1) {
+        lcd.write(_shown[row][cursor] = _next[row][cursor]);
+        stats.chars++;
+      } else if (cursor != col) {
+        lcd.setCursor(col, row);
+        stats.cursorMoves++;
+      }
+
+      lcd.write(_shown[row][col] = _next[row][col]);
+      stats.chars++;
+      cursor = col + 1;
+    }
+  }
+
+  stats.busTime = micros() - start;
+  return stats;
+}
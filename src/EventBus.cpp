@@ -0,0 +1,213 @@
+#include "EventBus.hpp"
+
+namespace {
+
+const char* const EVENT_NAMES[] = {
+    "sta_connecting",  "sta_connected",     "sta_disconnected",
+    "sta_failed",      "config_enter",      "config_exit",
+    "set_actuator",    "schedule_actuator", "update_start",
+    "update_progress", "update_end",        "sync_press",
+    "sync_long_press", "sync_end",          "data_updated",
+};
+
+const char* const CONTEXT_NAMES[] = {"inline", "ui", "system"};
+
+static_assert(sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0]) ==
+                  EventBus::EVENT_COUNT,
+              "EVENT_NAMES no cubre todos los eventos");
+
+}  // namespace
+
+bool EventBus::_begin(const Subscriber* subscribers, size_t count) {
+  _subscribers = subscribers;
+  _subscriberCount = count;
+
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t id = static_cast<uint8_t>(subscribers[i].id);
+    const uint8_t context = static_cast<uint8_t>(subscribers[i].context);
+    if (id >= EVENT_COUNT || context >= CONTEXT_COUNT) return false;
+
+    _contexts[id] |= 1 << context;
+  }
+
+  // INLINE no tiene cola ni tarea
+  for (uint8_t i = 1; i < CONTEXT_COUNT; i++) {
+    Worker& worker = _workers[i];
+    worker.bus = this;
+    worker.context = static_cast<EventContext>(i);
+
+    worker.queue = _queueStorage[i].create();
+    if (worker.queue == NULL) return false;
+  }
+
+  const uint8_t ui = static_cast<uint8_t>(EventContext::UI);
+  const uint8_t system = static_cast<uint8_t>(EventContext::SYSTEM);
+
+  return _uiTask.create(_dispatchTask, "Bus UI", &_workers[ui], 1,
+                        &_workers[ui].task, 1) &&
+         _systemTask.create(_dispatchTask, "Bus System", &_workers[system], 1,
+                            &_workers[system].task, 1);
+}
+
+bool EventBus::publish(EventId id, uint32_t value, TickType_t wait) {
+  const uint8_t index = static_cast<uint8_t>(id);
+  if (index >= EVENT_COUNT) return false;
+
+  const BusEvent event = {id, value, static_cast<uint32_t>(micros()), false};
+  const uint8_t contexts = _contexts[index];
+  bool delivered = true;
+
+  portENTER_CRITICAL(&_mux);
+  _stats[index].published++;
+  portEXIT_CRITICAL(&_mux);
+
+  // Primero los contextos en cola para no retrasarlos con los INLINE
+  for (uint8_t i = 1; i < CONTEXT_COUNT; i++) {
+    if ((contexts & (1 << i)) == 0) continue;
+    if (!_enqueue(_workers[i], event, wait)) delivered = false;
+  }
+
+  if (contexts & 1) _dispatch(event, EventContext::INLINE);
+
+  return delivered;
+}
+
+bool EventBus::publishLatest(EventId id, uint32_t value) {
+  const uint8_t index = static_cast<uint8_t>(id);
+  if (index >= EVENT_COUNT) return false;
+
+  const BusEvent event = {id, value, static_cast<uint32_t>(micros()), true};
+  const uint8_t contexts = _contexts[index];
+  bool delivered = true;
+
+  // Los contextos que ya tienen uno en cola lo despacharan con este valor
+  portENTER_CRITICAL(&_mux);
+  _stats[index].published++;
+  _latest[index] = value;
+  const uint8_t queued = _latestQueued[index];
+  _latestQueued[index] |= contexts & ~1;
+  portEXIT_CRITICAL(&_mux);
+
+  for (uint8_t i = 1; i < CONTEXT_COUNT; i++) {
+    const uint8_t mask = 1 << i;
+    if ((contexts & mask) == 0) continue;
+
+    if (queued & mask) {
+      portENTER_CRITICAL(&_mux);
+      _stats[index].coalesced++;
+      portEXIT_CRITICAL(&_mux);
+      continue;
+    }
+
+    if (!_enqueue(_workers[i], event, 0)) {
+      portENTER_CRITICAL(&_mux);
+      _latestQueued[index] &= ~mask;
+      portEXIT_CRITICAL(&_mux);
+      delivered = false;
+    }
+  }
+
+  if (contexts & 1) _dispatch(event, EventContext::INLINE);
+
+  return delivered;
+}
+
+EventBus::EventStats EventBus::getEventStats(EventId id) {
+  const uint8_t index = static_cast<uint8_t>(id);
+  if (index >= EVENT_COUNT) return EventStats();
+
+  portENTER_CRITICAL(&_mux);
+  const EventStats stats = _stats[index];
+  portEXIT_CRITICAL(&_mux);
+
+  return stats;
+}
+
+EventBus::QueueStats EventBus::getQueueStats(EventContext context) {
+  const uint8_t index = static_cast<uint8_t>(context);
+  QueueStats stats;
+  if (index >= CONTEXT_COUNT || _workers[index].queue == NULL) return stats;
+
+  stats.depth = uxQueueMessagesWaiting(_workers[index].queue);
+
+  portENTER_CRITICAL(&_mux);
+  stats.maxDepth = _workers[index].maxDepth;
+  portEXIT_CRITICAL(&_mux);
+
+  return stats;
+}
+
+TaskHandle_t EventBus::getTask(EventContext context) const {
+  const uint8_t index = static_cast<uint8_t>(context);
+  return index < CONTEXT_COUNT ? _workers[index].task : NULL;
+}
+
+const char* EventBus::eventToText(EventId id) {
+  const uint8_t index = static_cast<uint8_t>(id);
+  return index < EVENT_COUNT ? EVENT_NAMES[index] : "";
+}
+
+const char* EventBus::contextToText(EventContext context) {
+  const uint8_t index = static_cast<uint8_t>(context);
+  return index < CONTEXT_COUNT ? CONTEXT_NAMES[index] : "";
+}
+
+bool EventBus::_enqueue(Worker& worker, const BusEvent& event,
+                        TickType_t wait) {
+  const uint8_t index = static_cast<uint8_t>(event.id);
+
+  if (xQueueSend(worker.queue, &event, wait) != pdTRUE) {
+    portENTER_CRITICAL(&_mux);
+    _stats[index].dropped++;
+    portEXIT_CRITICAL(&_mux);
+    return false;
+  }
+
+  const uint8_t depth = uxQueueMessagesWaiting(worker.queue);
+  portENTER_CRITICAL(&_mux);
+  if (depth > worker.maxDepth) worker.maxDepth = depth;
+  portEXIT_CRITICAL(&_mux);
+
+  return true;
+}
+
+void EventBus::_dispatch(const BusEvent& event, EventContext context) {
+  const uint8_t index = static_cast<uint8_t>(event.id);
+  const uint32_t latency = static_cast<uint32_t>(micros()) - event.time;
+
+  portENTER_CRITICAL(&_mux);
+  EventStats& stats = _stats[index];
+  stats.dispatched++;
+  stats.totalLatency += latency;
+  if (latency > stats.maxLatency) stats.maxLatency = latency;
+  portEXIT_CRITICAL(&_mux);
+
+  for (size_t i = 0; i < _subscriberCount; i++) {
+    const Subscriber& subscriber = _subscribers[i];
+    if (subscriber.id == event.id && subscriber.context == context)
+      subscriber.handler(event);
+  }
+}
+
+void EventBus::_dispatchTask(void* parameter) {
+  Worker* worker = static_cast<Worker*>(parameter);
+  EventBus* bus = worker->bus;
+  const uint8_t mask = 1 << static_cast<uint8_t>(worker->context);
+  BusEvent event;
+
+  while (1) {
+    if (xQueueReceive(worker->queue, &event, portMAX_DELAY) != pdTRUE)
+      continue;
+
+    // Se libera el hueco antes de leer: lo publicado despues vuelve a encolar
+    if (event.isLatest) {
+      const uint8_t index = static_cast<uint8_t>(event.id);
+      portENTER_CRITICAL(&bus->_mux);
+      bus->_latestQueued[index] &= ~mask;
+      event.value = bus->_latest[index];
+      portEXIT_CRITICAL(&bus->_mux);
+    }
+
+    bus->_dispatch(event, worker->context);
+  }
+}
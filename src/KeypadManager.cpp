@@ -1,35 +1,58 @@
 #include <KeypadManager.hpp>
 
+#include <algorithm>
+
 KeypadManager::KeypadManager(const gpio_num_t upPin, const gpio_num_t downPin,
                              const gpio_num_t backPin,
                              const gpio_num_t enterPin)
-    : _UP_PIN(upPin),
-      _DOWN_PIN(downPin),
-      _BACK_PIN(backPin),
-      _ENTER_PIN(enterPin) {}
-
-void KeypadManager::begin() {
-  _upDebouncer.attach(_UP_PIN, INPUT_PULLUP);
-  _downDebouncer.attach(_DOWN_PIN, INPUT_PULLUP);
-  _backDebouncer.attach(_BACK_PIN, INPUT_PULLUP);
-  _enterDebouncer.attach(_ENTER_PIN, INPUT_PULLUP);
-
-  _upDebouncer.interval(DEBOUNCE_INTERVAL);
-  _downDebouncer.interval(DEBOUNCE_INTERVAL);
-  _backDebouncer.interval(DEBOUNCE_INTERVAL);
-  _enterDebouncer.interval(DEBOUNCE_INTERVAL);
+    : _inputs{{upPin, static_cast<uint8_t>(Key::UP)},
+              {downPin, static_cast<uint8_t>(Key::DOWN)},
+              {backPin, static_cast<uint8_t>(Key::BACK)},
+              {enterPin, static_cast<uint8_t>(Key::ENTER)}} {}
+
+bool KeypadManager::begin() {
+  _queue = _queueStorage.create();
+  if (_queue == NULL) return false;
+
+  for (uint8_t i = 0; i < KEY_COUNT; i++) {
+    if (!_inputs[i].begin(_queue)) return false;
+  }
+
+  return true;
 }
 
-Key KeypadManager::getKey() {
-  _upDebouncer.update();
-  _downDebouncer.update();
-  _backDebouncer.update();
-  _enterDebouncer.update();
+Key KeypadManager::waitKey(TickType_t timeout) {
+  const TickType_t start = xTaskGetTickCount();
+  DebouncedInput::Edge edge;
+
+  while (1) {
+    for (uint8_t i = 0; i < KEY_COUNT; i++) {
+      DebouncedInput& input = _inputs[i];
+      if (input.settle() && input.getLevel() == LOW) {
+        _lastKeyTime = input.getLastChange();
+        return static_cast<Key>(i);
+      }
+    }
+
+    const TickType_t elapsed = xTaskGetTickCount() - start;
+    if (elapsed >= timeout) return Key::NONE;
 
-  if (_upDebouncer.fell()) return Key::UP;
-  if (_downDebouncer.fell()) return Key::DOWN;
-  if (_backDebouncer.fell()) return Key::BACK;
-  if (_enterDebouncer.fell()) return Key::ENTER;
+    // Se despierta tambien al acabar un intervalo de rebote pendiente
+    const TickType_t wait = std::min(timeout - elapsed, _nextCheck());
+    if (xQueueReceive(_queue, &edge, wait) != pdTRUE) continue;
 
-  return Key::NONE;
-}
\ No newline at end of file
+    if (_inputs[edge.id].accept(edge) && edge.level == LOW) {
+      _lastKeyTime = edge.time;
+      return static_cast<Key>(edge.id);
+    }
+  }
+}
+
+TickType_t KeypadManager::_nextCheck() const {
+  TickType_t wait = portMAX_DELAY;
+
+  for (uint8_t i = 0; i < KEY_COUNT; i++)
+    wait = std::min(wait, _inputs[i].nextCheck());
+
+  return wait;
+}
@@ -0,0 +1,260 @@
+#include "Logger.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include "StaticAlloc.hpp"
+
+namespace {
+
+static_assert((Logger::BUFFER_SIZE & (Logger::BUFFER_SIZE - 1)) == 0,
+              "BUFFER_SIZE debe ser potencia de 2");
+
+// Cola MPSC acotada: cada hueco lleva una secuencia que indica si esta libre
+// para el productor de la vuelta actual o listo para el consumidor
+struct Slot {
+  std::atomic<uint32_t> sequence;
+  Logger::Record record;
+};
+
+Slot slots[Logger::BUFFER_SIZE];
+std::atomic<uint32_t> head(0);  // Siguiente posicion a reservar
+uint32_t tail = 0;              // Solo la usa la tarea de log
+std::atomic<uint32_t> written(0);
+std::atomic<uint32_t> dropped(0);
+
+Print* output = nullptr;
+StaticTask<4096> taskStorage;
+
+const char LEVEL_CODES[] = {'?', 'E', 'W', 'I', 'D'};
+
+void addArg(Logger::Record& record, Logger::ArgType type, uint32_t value) {
+  if (record.argCount >= Logger::MAX_ARGS) return;
+
+  record.types[record.argCount] = type;
+  record.args[record.argCount].u = value;
+  record.argCount++;
+}
+
+}  // namespace
+
+bool Logger::begin(Print& destination) {
+  // Huecos libres para la primera vuelta
+  for (uint16_t i = 0; i < BUFFER_SIZE; i++) slots[i].sequence.store(i);
+
+  output = &destination;
+
+  return taskStorage.create(_task, "Log", NULL, tskIDLE_PRIORITY, NULL, 1);
+}
+
+Logger::Stats Logger::getStats() {
+  Stats stats;
+  stats.written = written.load();
+  stats.dropped = dropped.load();
+
+  return stats;
+}
+
+void Logger::_pack(Record& record, int value) {
+  addArg(record, ArgType::INT, static_cast<uint32_t>(value));
+}
+
+void Logger::_pack(Record& record, long value) {
+  addArg(record, ArgType::INT, static_cast<uint32_t>(value));
+}
+
+void Logger::_pack(Record& record, unsigned value) {
+  addArg(record, ArgType::UINT, value);
+}
+
+void Logger::_pack(Record& record, unsigned long value) {
+  addArg(record, ArgType::UINT, value);
+}
+
+void Logger::_pack(Record& record, double value) {
+  if (record.argCount >= MAX_ARGS) return;
+
+  record.types[record.argCount] = ArgType::FLOAT;
+  record.args[record.argCount].f = static_cast<float>(value);
+  record.argCount++;
+}
+
+void Logger::_pack(Record& record, const char* value) {
+  // La cadena se copia: el puntero puede no existir al formatear
+  const uint8_t offset = record.textLength;
+
+  if (offset >= TEXT_SIZE) {
+    // Sin sitio: el ultimo byte siempre es el '\0' de la cadena anterior
+    addArg(record, ArgType::TEXT, TEXT_SIZE - 1);
+    return;
+  }
+
+  const size_t room = TEXT_SIZE - offset;
+  const size_t length =
+      strlcpy(record.text + offset, value != nullptr ? value : "", room);
+
+  addArg(record, ArgType::TEXT, offset);
+  record.textLength = offset + std::min(length + 1, room);
+}
+
+void Logger::_push(const Record& record) {
+  // Antes de begin() el buffer no esta inicializado
+  if (output == nullptr) {
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  uint32_t position = head.load(std::memory_order_relaxed);
+  Slot* slot;
+
+  while (1) {
+    slot = &slots[position & (BUFFER_SIZE - 1)];
+    const uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const int32_t difference =
+        static_cast<int32_t>(sequence) - static_cast<int32_t>(position);
+
+    if (difference == 0) {
+      if (head.compare_exchange_weak(position, position + 1,
+                                     std::memory_order_relaxed))
+        break;
+    } else if (difference < 0) {
+      // Lleno: se descarta el registro nuevo, nunca se bloquea
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    } else {
+      position = head.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->record = record;
+  slot->sequence.store(position + 1, std::memory_order_release);
+  written.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t Logger::_format(const Record& record, char* line, size_t size) {
+  const uint8_t level = static_cast<uint8_t>(record.level);
+  int length = snprintf(line, size, "%8lu %c ",
+                        static_cast<unsigned long>(record.time),
+                        level < sizeof(LEVEL_CODES) ? LEVEL_CODES[level] : '?');
+  size_t used = length > 0 ? length : 0;
+  uint8_t arg = 0;
+
+  for (const char* p = record.format; *p != '\0' && used + 2 < size; p++) {
+    if (*p != '%') {
+      line[used++] = *p;
+      continue;
+    }
+
+    if (p[1] == '%') {
+      line[used++] = '%';
+      p++;
+      continue;
+    }
+
+    // Flags, ancho y precision se conservan; la longitud se normaliza a 'l'
+    char spec[16] = "%";
+    size_t specLength = 1;
+
+    for (p++; *p != '\0' && strchr("-+ #0123456789.", *p) != nullptr; p++) {
+      if (specLength < sizeof(spec) - 3) spec[specLength++] = *p;
+    }
+    while (*p == 'l' || *p == 'h' || *p == 'z') p++;
+    if (*p == '\0' || arg >= record.argCount) break;
+
+    const ArgType type = record.types[arg];
+    const uint32_t raw = record.args[arg].u;
+    const float real = record.args[arg].f;
+    arg++;
+
+    char* out = line + used;
+    const size_t room = size - used - 1;  // Reserva para '\n'
+    length = 0;
+
+    switch (*p) {
+      case 'd':
+      case 'i':
+        spec[specLength++] = 'l';
+        spec[specLength++] = 'd';
+        spec[specLength] = '\0';
+        length = snprintf(out, room, spec,
+                          type == ArgType::FLOAT
+                              ? static_cast<long>(real)
+                              : static_cast<long>(static_cast<int32_t>(raw)));
+        break;
+
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'o':
+        spec[specLength++] = 'l';
+        spec[specLength++] = *p;
+        spec[specLength] = '\0';
+        length = snprintf(out, room, spec,
+                          type == ArgType::FLOAT
+                              ? static_cast<unsigned long>(real)
+                              : static_cast<unsigned long>(raw));
+        break;
+
+      case 'f':
+      case 'e':
+      case 'g':
+        spec[specLength++] = *p;
+        spec[specLength] = '\0';
+        length = snprintf(out, room, spec,
+                          type == ArgType::FLOAT
+                              ? static_cast<double>(real)
+                              : static_cast<double>(static_cast<int32_t>(raw)));
+        break;
+
+      case 'c':
+        spec[specLength++] = 'c';
+        spec[specLength] = '\0';
+        length = snprintf(out, room, spec, static_cast<int>(raw));
+        break;
+
+      case 's':
+        spec[specLength++] = 's';
+        spec[specLength] = '\0';
+        length = snprintf(out, room, spec,
+                          type == ArgType::TEXT ? record.text + raw : "?");
+        break;
+
+      default:
+        break;
+    }
+
+    if (length > 0) used += std::min<size_t>(length, room - 1);
+  }
+
+  line[used++] = '\n';
+  return used;
+}
+
+void Logger::_task(void* parameter) {
+  char line[LINE_SIZE];
+  uint32_t reportedDrops = 0;
+
+  while (1) {
+    Slot& slot = slots[tail & (BUFFER_SIZE - 1)];
+
+    if (slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+      // Vacio: se avisa de las perdidas y se espera sin consumir CPU
+      const uint32_t drops = dropped.load(std::memory_order_relaxed);
+      if (drops != reportedDrops) {
+        output->printf("Log: %lu registros perdidos\n",
+                       static_cast<unsigned long>(drops - reportedDrops));
+        reportedDrops = drops;
+      }
+
+      vTaskDelay(pdMS_TO_TICKS(DRAIN_INTERVAL));
+      continue;
+    }
+
+    // Se copia y se libera el hueco antes de la escritura lenta
+    const size_t length = _format(slot.record, line, sizeof(line));
+    slot.sequence.store(tail + BUFFER_SIZE, std::memory_order_release);
+    tail++;
+
+    output->write(reinterpret_cast<const uint8_t*>(line), length);
+  }
+}
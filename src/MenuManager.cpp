@@ -3,427 +3,384 @@
 #include <cmath>
 
 #include "KeypadManager.hpp"
+#include "Logger.hpp"
+#include "Trace.hpp"
 #include "Utils.hpp"
 
 MenuManager::MenuManager(const gpio_num_t lcdRS, const gpio_num_t lcdEN,
                          const gpio_num_t lcdD4, const gpio_num_t lcdD5,
                          const gpio_num_t lcdD6, const gpio_num_t lcdD7,
-                         WebServerManager& server, Data& data, NowManager& now)
-    : _lcd(lcdRS, lcdEN, lcdD4, lcdD5, lcdD6, lcdD7), _data(data), _now(now) {}
+                         NowManager& now, PowerManager& power, EventBus& bus)
+    : _lcd(lcdRS, lcdEN, lcdD4, lcdD5, lcdD6, lcdD7),
+      _now(now),
+      _power(power),
+      _bus(bus) {}
+
+bool MenuManager::begin() {
+  _lcd.begin(DisplayBuffer::COLS, DisplayBuffer::ROWS);
+
+  _customMutex = _customMutexStorage.create();
+  _navMutex = _navMutexStorage.create();
+  if (_customMutex == NULL || _navMutex == NULL) return false;
+
+  // Unico escritor del LCD: el resto de tareas solo solicitan redibujados
+  return _displayTaskStorage.create(_displayTask, "Display", this, 1,
+                                    &_displayTaskHandler, 0);
+}
+
+// Definiciones de las tablas (ODR en C++11)
+constexpr MenuManager::MenuItem MenuManager::MAIN_ITEMS[];
+constexpr MenuManager::MenuItem MenuManager::CONNECTION_TIMES[];
+constexpr MenuManager::MenuItem MenuManager::DESCONNECTION_TIMES[];
+constexpr MenuManager::MenuItem MenuManager::ACTUATOR_ITEMS[];
+constexpr MenuManager::ListScreen MenuManager::LISTS[];
+constexpr MenuManager::ConfirmScreen MenuManager::CONFIRMS[];
+constexpr MenuManager::ViewScreen MenuManager::VIEWS[];
+constexpr MenuManager::Screen MenuManager::SCREENS[];
 
-void MenuManager::begin() { _lcd.begin(16, 2); }
+void MenuManager::handleKey(Key key, uint32_t keyTime) {
+  static_assert(_isTableValid(0), "Tabla de pantallas inconsistente");
 
-void MenuManager::handleKey(Key key) {
   if (_stopKeypad) return;
 
-  switch (_currentState) {
-    case State::MAIN:
-      if (key == Key::UP && _menuPosition > 0) {
-        _menuPosition--;
-        if (_menuPosition < _displayStart) _displayStart--;
-      } else if (key == Key::DOWN && _menuPosition < MAIN_MENU_COUNT - 1) {
-        _menuPosition++;
-        if (_menuPosition - _displayStart >= 2) _displayStart++;
-      } else if (key == Key::ENTER) {
-        _currentState = _mainMenuItems[_menuPosition].nextState;
-      }
-      break;
+  _keyTime = keyTime;
+  _isKeyPending = true;
 
-    case State::CONFIG_CONFIRM:
-      if (key == Key::UP) {
-        _confirmOption = (_confirmOption > 0) ? _confirmOption - 1 : 0;
-      } else if (key == Key::DOWN) {
-        _confirmOption = (_confirmOption < 1) ? _confirmOption + 1 : 1;
-      } else if (key == Key::ENTER) {
-        if (_confirmOption == 1) {
-          _currentState = State::CONFIG;
+  // El evento de una confirmacion se publica fuera del mutex
+  const ConfirmScreen* accepted = nullptr;
+  uint8_t page = 0;
 
-          _trigger(Event::CONFIG_ENTER);
-        } else {
-          _currentState = State::MAIN;
-        }
+  xSemaphoreTake(_navMutex, portMAX_DELAY);
+  const Screen& screen = SCREENS[static_cast<uint8_t>(_nav.state)];
+
+  if (key == Key::BACK) {
+    // Al salir de una vista paginada se vuelve al primer registro
+    if (screen.type == ScreenType::VIEW) _nav.page = 0;
+    if (screen.back != screen.state) _goTo(screen.back);
+    xSemaphoreGive(_navMutex);
+    return;
+  }
 
-        _confirmOption = 0;
-      } else if (key == Key::BACK) {
-        _currentState = State::MAIN;
-        _confirmOption = 0;
+  switch (screen.type) {
+    case ScreenType::LIST: {
+      const ListScreen& list = LISTS[screen.index];
+
+      if (key == Key::UP || key == Key::DOWN) {
+        _moveCursor(key, list.count, DisplayBuffer::ROWS * list.columns);
+      } else if (key == Key::ENTER) {
+        const MenuItem& item = list.items[_nav.cursor];
+        if (list.field != nullptr) _actuatorSchedule.*list.field = item.value;
+        _goTo(item.next);
       }
       break;
+    }
+
+    case ScreenType::CONFIRM: {
+      const ConfirmScreen& confirm = CONFIRMS[screen.index];
 
-    case State::CONFIG_EXIT_CONFIRM:
       if (key == Key::UP) {
-        _confirmOption = (_confirmOption > 0) ? _confirmOption - 1 : 0;
+        _nav.cursor = 0;
       } else if (key == Key::DOWN) {
-        _confirmOption = (_confirmOption < 1) ? _confirmOption + 1 : 1;
+        _nav.cursor = 1;
       } else if (key == Key::ENTER) {
-        if (_confirmOption == 1) {
-          _currentState = State::MAIN;
-
-          _trigger(Event::CONFIG_EXIT);
+        if (_nav.cursor == 1) {
+          _goTo(confirm.accept);
+          accepted = &confirm;
+          page = _nav.page;
         } else {
-          _currentState = State::CONFIG;
+          _goTo(confirm.cancel);
         }
-        _confirmOption = 0;
-      } else if (key == Key::BACK) {
-        _currentState = State::CONFIG;
-        _confirmOption = 0;
-      }
-      break;
-
-    case State::CONFIG:
-      if (key == Key::BACK) {
-        _currentState = State::CONFIG_EXIT_CONFIRM;
       }
       break;
+    }
 
-    case State::STATUS:
-    case State::ABOUT:
-      if (key == Key::BACK) _currentState = State::MAIN;
-      break;
+    case ScreenType::VIEW: {
+      const ViewScreen& view = VIEWS[screen.index];
+      if (view.source == nullptr || (_now.*view.source)() == 0) break;
 
-    case State::SENSOR:
       if (key == Key::UP || key == Key::DOWN) {
-        const size_t size = _now.getSensorListSize();
-
-        if (size > 0) {
-          _sensorScreen = (_sensorScreen + 1) % size;
-        }
-      } else if (key == Key::BACK) {
-        _currentState = State::MAIN;
-        _sensorScreen = 0;
+        _movePage(key, view);
+      } else if (key == Key::ENTER && view.count > 0) {
+        _goTo(view.items[_nav.cursor].next);
       }
       break;
+    }
+  }
 
-    case State::ACTUATOR:
-      if (key == Key::UP) {
-        if (_actuatorOption > 0)
-          _actuatorOption--;
-        else {
-          const size_t size = _now.getActuatorListSize();
-
-          if (size > 0) {
-            _actuatorScreen = (_actuatorScreen - 1) % size;
-            _actuatorOption = 1;
-          }
-        }
-      } else if (key == Key::DOWN) {
-        if (_actuatorOption < 1)
-          _actuatorOption++;
-        else {
-          const size_t size = _now.getActuatorListSize();
-
-          if (size > 0) {
-            _actuatorScreen = (_actuatorScreen + 1) % size;
-            _actuatorOption = 0;
-          }
-        }
-      } else if (key == Key::ENTER) {
-        if (_actuatorOption == 1) {
-          _currentState = State::SCHEDULE_ACTUATOR_CONNECTION;
-          _actuatorOption = 0;
-        } else if (_actuatorOption == 0) {
-          _currentState = State::ACTUATOR_SET_CONFIRM;
-        }
-      } else if (key == Key::BACK) {
-        _currentState = State::MAIN;
-        _actuatorScreen = 0;
-        _actuatorOption = 0;
-      }
+  xSemaphoreGive(_navMutex);
 
-      break;
+  // value: actuador seleccionado al confirmar
+  if (accepted != nullptr) _bus.publish(accepted->event, page);
+}
 
-    case State::ACTUATOR_SET_CONFIRM:
-      if (key == Key::UP) {
-        _confirmOption = (_confirmOption > 0) ? _confirmOption - 1 : 0;
-      } else if (key == Key::DOWN) {
-        _confirmOption = (_confirmOption < 1) ? _confirmOption + 1 : 1;
-      } else if (key == Key::ENTER) {
-        if (_confirmOption == 1) {
-          _currentState = State::ACTUATOR;
+void MenuManager::updateDisplay() {
+  if (_displayTaskHandler != NULL) xTaskNotifyGive(_displayTaskHandler);
+}
 
-          _trigger(Event::SET_ACTUATOR);
-        } else {
-          _currentState = State::ACTUATOR;
-        }
-        _confirmOption = 0;
-      } else if (key == Key::BACK) {
-        _currentState = State::ACTUATOR;
-        _confirmOption = 0;
-      }
+void MenuManager::showCustomInfoScreen(const char* line1, const char* line2) {
+  xSemaphoreTake(_customMutex, portMAX_DELAY);
+  strlcpy(_customLines[0], line1, sizeof(_customLines[0]));
+  strlcpy(_customLines[1], line2, sizeof(_customLines[1]));
+  xSemaphoreGive(_customMutex);
 
-      break;
+  _stopKeypad = true;
+  _isCustomScreen = true;
+  updateDisplay();
+}
 
-    case State::SCHEDULE_ACTUATOR_CONNECTION:
-      if (key == Key::UP) {
-        if (_scheduleActuatorConnectionOption == 0 &&
-            _scheduleActuatorConnectionDisplayStart > 0)
-          _scheduleActuatorConnectionDisplayStart--;
+void MenuManager::clearCustomInfoScreen() {
+  _stopKeypad = false;
+  _isCustomScreen = false;
+  updateDisplay();
+}
 
-        if (_scheduleActuatorConnectionOption > 0)
-          _scheduleActuatorConnectionOption--;
-      } else if (key == Key::DOWN) {
-        if (_scheduleActuatorConnectionOption == 3 &&
-            _scheduleActuatorConnectionDisplayStart <
-                SCHEDULE_ACTUATOR_CONNECTION_TIMES_COUNT - 4)
-          _scheduleActuatorConnectionDisplayStart++;
+void MenuManager::setWifiStatus(bool connected) {
+  _data.wifi = connected;
+  updateDisplay();
+}
 
-        if (_scheduleActuatorConnectionOption < 3)
-          _scheduleActuatorConnectionOption++;
-      } else if (key == Key::ENTER) {
-        _actuatorSchedule.offset =
-            _scheduleActuatorConnectionTimes
-                [_scheduleActuatorConnectionDisplayStart +
-                 _scheduleActuatorConnectionOption]
-                    .time;
-
-        _currentState = State::SCHEDULE_ACTUATOR_DESCONNECTION;
-        _scheduleActuatorConnectionOption = 0;
-        _scheduleActuatorConnectionDisplayStart = 0;
-      } else if (key == Key::BACK) {
-        _currentState = State::ACTUATOR;
-        _scheduleActuatorConnectionOption = 0;
-        _scheduleActuatorConnectionDisplayStart = 0;
-      }
+void MenuManager::setHotspotIp(const char* ip) {
+  strlcpy(_data.ipAP, ip, sizeof(_data.ipAP));
+  updateDisplay();
+}
 
-      break;
+void MenuManager::updateData() {
+  // Solo las vistas paginadas dependen de las lecturas. Desde la recepcion
+  // basta una lectura atomica del estado, sin esperar al mutex
+  const Screen& screen = SCREENS[static_cast<uint8_t>(_nav.state)];
+  if (screen.type == ScreenType::VIEW && VIEWS[screen.index].source != nullptr)
+    updateDisplay();
+}
 
-    case State::SCHEDULE_ACTUATOR_DESCONNECTION:
-      if (key == Key::UP) {
-        if (_scheduleActuatorDesconnectionOption == 0 &&
-            _scheduleActuatorDesconnectionDisplayStart > 0)
-          _scheduleActuatorDesconnectionDisplayStart--;
+void MenuManager::_displayTask(void* parameter) {
+  MenuManager* menu = static_cast<MenuManager*>(parameter);
+  uint32_t lastFrame = 0;
 
-        if (_scheduleActuatorDesconnectionOption > 0)
-          _scheduleActuatorDesconnectionOption--;
-      } else if (key == Key::DOWN) {
-        if (_scheduleActuatorDesconnectionOption == 3 &&
-            _scheduleActuatorDesconnectionDisplayStart <
-                SCHEDULE_ACTUATOR_DESCONNECTION_TIMES_COUNT - 4)
-          _scheduleActuatorDesconnectionDisplayStart++;
+  while (1) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
 
-        if (_scheduleActuatorDesconnectionOption < 3)
-          _scheduleActuatorDesconnectionOption++;
-      } else if (key == Key::ENTER) {
-        _actuatorSchedule.duration =
-            _scheduleActuatorDesconnectionTimes
-                [_scheduleActuatorDesconnectionDisplayStart +
-                 _scheduleActuatorDesconnectionOption]
-                    .time;
-
-        _currentState = State::SCHEDULE_ACTUATOR_CONFIRM;
-        _scheduleActuatorDesconnectionOption = 0;
-        _scheduleActuatorDesconnectionDisplayStart = 0;
-      } else if (key == Key::BACK) {
-        _currentState = State::SCHEDULE_ACTUATOR_CONNECTION;
-        _scheduleActuatorDesconnectionOption = 0;
-        _scheduleActuatorDesconnectionDisplayStart = 0;
-      }
+    // Limitar la tasa de refresco y agrupar las solicitudes en un fotograma
+    const uint32_t elapsed = millis() - lastFrame;
+    if (elapsed < FRAME_INTERVAL)
+      vTaskDelay(pdMS_TO_TICKS(FRAME_INTERVAL - elapsed));
+    ulTaskNotifyTake(pdTRUE, 0);
 
-      break;
+    menu->_render();
+    lastFrame = millis();
+  }
+}
 
-    case State::SCHEDULE_ACTUATOR_CONFIRM:
-      if (key == Key::UP) {
-        _confirmOption = (_confirmOption > 0) ? _confirmOption - 1 : 0;
-      } else if (key == Key::DOWN) {
-        _confirmOption = (_confirmOption < 1) ? _confirmOption + 1 : 1;
-      } else if (key == Key::ENTER) {
-        if (_confirmOption == 1) {
-          _currentState = State::ACTUATOR;
+void MenuManager::_render() {
+  TRACE_SCOPE("menu_render");
+  const uint32_t allocations = HeapGuard::getAllocations(NULL);
+  _screen.clear();
+
+  if (_isCustomScreen) {
+    xSemaphoreTake(_customMutex, portMAX_DELAY);
+    _screen.setCursor(0, 0);
+    _screen.print(_customLines[0]);
+    _screen.setCursor(0, 1);
+    _screen.print(_customLines[1]);
+    xSemaphoreGive(_customMutex);
+  } else {
+    // Se dibuja una copia: handleKey puede cambiar la navegacion entre tanto
+    xSemaphoreTake(_navMutex, portMAX_DELAY);
+    _shown = _nav;
+    xSemaphoreGive(_navMutex);
+
+    const Screen& screen = SCREENS[static_cast<uint8_t>(_shown.state)];
+
+    switch (screen.type) {
+      case ScreenType::LIST:
+        _showList(LISTS[screen.index]);
+        break;
+      case ScreenType::CONFIRM:
+        _showConfirm(CONFIRMS[screen.index]);
+        break;
+      case ScreenType::VIEW:
+        if (VIEWS[screen.index].render != nullptr)
+          (this->*VIEWS[screen.index].render)();
+        break;
+    }
+  }
 
-          _trigger(Event::SCHEDULE_ACTUATOR);
-        } else {
-          _currentState = State::ACTUATOR;
-        }
-        _confirmOption = 0;
-      } else if (key == Key::BACK) {
-        _currentState = State::SCHEDULE_ACTUATOR_DESCONNECTION;
-        _confirmOption = 0;
-      }
+  // El bus del LCD se escribe a maxima frecuencia y sin light sleep
+  {
+    TRACE_SCOPE("lcd_flush");
+    _power.acquire(PowerManager::Lock::DISPLAY);
+    _lastFlushStats = _screen.flushTo(_lcd);
+    _power.release(PowerManager::Lock::DISPLAY);
+  }
 
-      break;
+  if (_isKeyPending) {
+    _lastKeyLatency = micros() - _keyTime;
+    _isKeyPending = false;
   }
-};
 
-void MenuManager::updateDisplay() {
-  _lcd.clear();
-  switch (_currentState) {
-    case State::MAIN:
-      _showMain();
-      break;
-    case State::STATUS:
-      _showStatus();
-      break;
-    case State::SENSOR:
-      _showSensor();
-      break;
-    case State::ACTUATOR:
-      _showActuator();
-      break;
-    case State::ACTUATOR_SET_CONFIRM:
-      _showConfirm(_now.getActuatorAt(_actuatorScreen).state ? "Apagar?"
-                                                             : "Encender?");
-      break;
-    case State::SCHEDULE_ACTUATOR_CONNECTION:
-      _showScheduleActuatorConnection();
-      break;
-    case State::SCHEDULE_ACTUATOR_DESCONNECTION:
-      _showScheduleActuatorDesconnection();
-      break;
-    case State::SCHEDULE_ACTUATOR_CONFIRM:
-      _showConfirm("Programar?");
-      break;
-    case State::CONFIG:
-      _showConfig();
-      break;
-    case State::CONFIG_CONFIRM:
-      _showConfirm("Iniciar hotspot?");
-      break;
-    case State::CONFIG_EXIT_CONFIRM:
-      _showConfirm("Desea salir?");
-      break;
-    case State::ABOUT:
-      _showAbout();
-      break;
+  // Un redibujado no deberia reservar memoria: se avisa del nuevo maximo
+  _lastRenderAllocations = HeapGuard::getAllocations(NULL) - allocations;
+  if (_lastRenderAllocations > _maxRenderAllocations) {
+    _maxRenderAllocations = _lastRenderAllocations;
+    LOG_WARN("Redibujado con %lu reservas de heap", _lastRenderAllocations);
   }
 }
 
-void MenuManager::showCustomInfoScreen(const String& line1,
-                                       const String& line2) {
-  _stopKeypad = true;
-  _lcd.clear();
-  _lcd.setCursor(0, 0);
-  _lcd.print(line1.c_str());
-  _lcd.setCursor(0, 1);
-  _lcd.print(line2.c_str());
-}
+MenuManager::State MenuManager::getState() const {
+  xSemaphoreTake(_navMutex, portMAX_DELAY);
+  const State state = _nav.state;
+  xSemaphoreGive(_navMutex);
 
-void MenuManager::clearCustomInfoScreen() {
-  _stopKeypad = false;
-  updateDisplay();
+  return state;
 }
 
-void MenuManager::tryConnect(const String& ssid) {
-  _lcd.clear();
+int MenuManager::getCurrentActuatorIndex() const {
+  xSemaphoreTake(_navMutex, portMAX_DELAY);
+  const int page = _nav.page;
+  xSemaphoreGive(_navMutex);
 
-  _lcd.setCursor(0, 0);
-  _lcd.print("Conectando a");
+  return page;
+}
 
-  for (int i = 0; i < 16; i++) {
-    _lcd.setCursor(i, 1);
+void MenuManager::_goTo(State state) {
+  _nav.state = state;
+  _nav.cursor = 0;
+  _nav.scroll = 0;
+}
 
-    if (ssid.length() > 16 && (i == 13 || i == 14 || i == 15)) {
-      _lcd.print(".");
-    } else
-      _lcd.print(ssid.charAt(i));
+void MenuManager::_moveCursor(Key key, uint8_t count, uint8_t visible) {
+  if (key == Key::UP && _nav.cursor > 0) {
+    _nav.cursor--;
+    if (_nav.cursor < _nav.scroll) _nav.scroll--;
+  } else if (key == Key::DOWN && _nav.cursor + 1 < count) {
+    _nav.cursor++;
+    if (_nav.cursor - _nav.scroll >= visible) _nav.scroll++;
   }
 }
 
-void MenuManager::on(Event event, std::function<void()> callback) {
-  _callbacks[event] = callback;
+void MenuManager::_movePage(Key key, const ViewScreen& view) {
+  const size_t records = (_now.*view.source)();
+  if (records == 0) return;
+
+  // Se recorren las opciones de cada registro y luego el siguiente registro
+  const size_t options = view.count > 0 ? view.count : 1;
+  const size_t total = records * options;
+  size_t position = (_nav.page * options + _nav.cursor) % total;
+
+  if (key == Key::UP)
+    position = (position + total - 1) % total;
+  else
+    position = (position + 1) % total;
+
+  _nav.page = position / options;
+  _nav.cursor = position % options;
 }
 
-void MenuManager::updateData() {
-  switch (_currentState) {
-    case State::SENSOR:
-      _lcd.clear();
-      _showSensor();
-      break;
-    case State::ACTUATOR:
-      _lcd.clear();
-      _showActuator();
+void MenuManager::_showList(const ListScreen& list) {
+  const uint8_t visible = DisplayBuffer::ROWS * list.columns;
+  const uint8_t width = DisplayBuffer::COLS / list.columns;
 
-    default:
-      break;
+  for (uint8_t slot = 0; slot < visible; slot++) {
+    const uint8_t index = _shown.scroll + slot;
+    if (index >= list.count) break;
+
+    _screen.setCursor((slot % list.columns) * width, slot / list.columns);
+    _screen.print(index == _shown.cursor ? ">" : " ");
+    _screen.print(list.items[index].text);
   }
 }
 
-void MenuManager::_trigger(Event event) {
-  auto it = _callbacks.find(event);
+void MenuManager::_showConfirm(const ConfirmScreen& confirm) {
+  _screen.setCursor(0, 0);
+  if (confirm.render != nullptr)
+    (this->*confirm.render)();
+  else
+    _screen.print(confirm.message);
 
-  if (it != _callbacks.end() && it->second) {
-    it->second();
-  }
+  _screen.setCursor(0, 1);
+  _screen.print("    No     Si  ");
+
+  // Cursor dinámico
+  _screen.setCursor(3, 1);
+  _screen.print(_shown.cursor == 0 ? ">" : " ");
+
+  _screen.setCursor(10, 1);
+  _screen.print(_shown.cursor == 1 ? ">" : " ");
 }
 
-void MenuManager::_showMain() {
-  for (int i = 0; i < 2; i++) {
-    int idx = _displayStart + i;
-    if (idx >= MAIN_MENU_COUNT) break;
+void MenuManager::_showSetActuatorMessage() {
+  NowManager::ActuatorData actuator;
+  const bool state =
+      _now.copyActuatorAt(_shown.page, actuator) && actuator.state;
 
-    _lcd.setCursor(0, i);
-    _lcd.print(idx == _menuPosition ? ">" : " ");
-    _lcd.setCursor(1, i);
-    _lcd.print(_mainMenuItems[idx].text);
-  }
+  _screen.print(state ? "Apagar?" : "Encender?");
 }
 
 void MenuManager::_showStatus() {
-  _lcd.setCursor(0, 0);
-  _lcd.printf("Wifi: %s", formatBooleanToText(_data.wifi).c_str());
-  _lcd.setCursor(0, 1);
-  _lcd.printf("Internet: %s", formatBooleanToText(_data.internet).c_str());
+  _screen.setCursor(0, 0);
+  _screen.printf("Wifi: %s", formatBooleanToText(_data.wifi));
+  _screen.setCursor(0, 1);
+  _screen.printf("Internet: %s", formatBooleanToText(_data.internet));
 }
 
 void MenuManager::_showConfig() {
-  _lcd.setCursor(0, 0);
-  _lcd.print("Hotspot");
-  _lcd.setCursor(0, 1);
-  _lcd.printf("IP: %s", _data.ipAP.c_str());
+  _screen.setCursor(0, 0);
+  _screen.print("Hotspot");
+  _screen.setCursor(0, 1);
+  _screen.printf("IP: %s", _data.ipAP);
 }
 
 void MenuManager::_showAbout() {
-  _lcd.setCursor(0, 0);
-  _lcd.print("ESP32 System");
-  _lcd.setCursor(0, 1);
-  _lcd.print("@vircoding");
+  _screen.setCursor(0, 0);
+  _screen.print("ESP32 System");
+  _screen.setCursor(0, 1);
+  _screen.print("@vircoding");
 }
 
 void MenuManager::_showSensor() {
   const size_t sensorListSize = _now.getSensorListSize();
 
   if (sensorListSize > 0) {
-    if (_sensorScreen >= 0 && _sensorScreen < sensorListSize) {
-      NowManager::SensorData data = _now.getSensorAt(_sensorScreen);
-      bool isValid;
-
-      _lcd.setCursor(0, 0);
-      _lcd.print(data.deviceName.c_str());
-      _lcd.setCursor(0, 1);
-
-      switch (data.type) {
-        case NowManager::SensorValueType::BOOL:
-          _lcd.printf("%s: %s", data.variable.c_str(),
-                      data.isConnected
-                          ? formatBooleanToText(data.value.b).c_str()
-                          : "Desc");
-          break;
-
-        case NowManager::SensorValueType::INT:
-          isValid = !isnan(data.value.i);
-          _lcd.printf(
-              "%s: %s%s", data.variable.c_str(),
-              data.isConnected ? (isValid ? String(data.value.i).c_str() : "")
-                               : "Desc",
-              data.isConnected ? (isValid ? data.units.c_str() : "") : "");
-          break;
-
-        case NowManager::SensorValueType::FLOAT:
-          isValid = !isnan(data.value.f);
-          _lcd.printf(
-              "%s: %s%s", data.variable.c_str(),
-              data.isConnected
-                  ? (isValid ? String(round(data.value.f * 10) / 10).c_str()
-                             : "")
-                  : "Desc",
-              data.isConnected ? (isValid ? data.units.c_str() : "") : "");
-          break;
+    if (_shown.page >= 0 && _shown.page < sensorListSize) {
+      // Copia: la tarea de recepcion modifica la tabla mientras se dibuja
+      NowManager::SensorData data;
+      if (!_now.copySensorAt(_shown.page, data)) return;
+
+      char value[NUMBER_TEXT_SIZE] = "";
+      const char* units = "";
+
+      _screen.setCursor(0, 0);
+      _screen.print(data.deviceName);
+      _screen.setCursor(0, 1);
+
+      if (!data.isConnected) {
+        strlcpy(value, "Desc", sizeof(value));
+      } else {
+        switch (data.type) {
+          case NowManager::SensorValueType::BOOL:
+            strlcpy(value, formatBooleanToText(data.value.b), sizeof(value));
+            break;
+
+          case NowManager::SensorValueType::INT:
+            snprintf(value, sizeof(value), "%d", data.value.i);
+            units = data.units;
+            break;
+
+          case NowManager::SensorValueType::FLOAT:
+            if (!isnan(data.value.f)) {
+              formatFixed(value, sizeof(value), data.value.f, 1);
+              units = data.units;
+            }
+            break;
+        }
       }
+
+      _screen.printf("%s: %s%s", data.variable, value, units);
     }
   } else {
-    _lcd.setCursor(0, 0);
-    _lcd.print("Sin sensores");
-    _lcd.setCursor(0, 1);
-    _lcd.print("vinculados");
+    _screen.setCursor(0, 0);
+    _screen.print("Sin sensores");
+    _screen.setCursor(0, 1);
+    _screen.print("vinculados");
   }
 }
 
@@ -431,119 +388,34 @@ void MenuManager::_showActuator() {
   const size_t actuatorListSize = _now.getActuatorListSize();
 
   if (actuatorListSize > 0) {
-    if (_actuatorScreen >= 0 && _actuatorScreen < actuatorListSize) {
-      NowManager::ActuatorData data = _now.getActuatorAt(_actuatorScreen);
+    if (_shown.page >= 0 && _shown.page < actuatorListSize) {
+      NowManager::ActuatorData data;
+      if (!_now.copyActuatorAt(_shown.page, data)) return;
 
-      _lcd.setCursor(0, 0);
-      _lcd.print(data.deviceName.c_str());
+      _screen.setCursor(0, 0);
+      _screen.print(data.deviceName);
 
       if (data.isConnected) {
-        _lcd.setCursor(1, 1);
-        _lcd.printf("%s", data.state ? "ON" : "OFF");
-        _lcd.setCursor(7, 1);
-        _lcd.print("Programar");
+        _screen.setCursor(1, 1);
+        _screen.printf("%s", data.state ? "ON" : "OFF");
+        _screen.setCursor(7, 1);
+        _screen.print("Programar");
 
         // Cursor dinámico
-        _lcd.setCursor(0, 1);
-        _lcd.print(_actuatorOption == 0 ? ">" : " ");
+        _screen.setCursor(0, 1);
+        _screen.print(_shown.cursor == 0 ? ">" : " ");
 
-        _lcd.setCursor(6, 1);
-        _lcd.print(_actuatorOption == 1 ? ">" : " ");
+        _screen.setCursor(6, 1);
+        _screen.print(_shown.cursor == 1 ? ">" : " ");
       } else {
-        _lcd.setCursor(0, 1);
-        _lcd.print("Desconectado");
+        _screen.setCursor(0, 1);
+        _screen.print("Desconectado");
       }
     }
   } else {
-    _lcd.setCursor(0, 0);
-    _lcd.print("Sin actuadores");
-    _lcd.setCursor(0, 1);
-    _lcd.print("vinculados");
+    _screen.setCursor(0, 0);
+    _screen.print("Sin actuadores");
+    _screen.setCursor(0, 1);
+    _screen.print("vinculados");
   }
 }
-
-void MenuManager::_showScheduleActuatorConnection() {
-  _lcd.setCursor(1, 0);
-  _lcd.printf(
-      "%s",
-      _scheduleActuatorConnectionTimes[_scheduleActuatorConnectionDisplayStart]
-          .text);
-  _lcd.setCursor(8, 0);
-  _lcd.printf(
-      "%s",
-      _scheduleActuatorConnectionTimes[_scheduleActuatorConnectionDisplayStart +
-                                       1]
-          .text);
-  _lcd.setCursor(1, 1);
-  _lcd.printf(
-      "%s",
-      _scheduleActuatorConnectionTimes[_scheduleActuatorConnectionDisplayStart +
-                                       2]
-          .text);
-  _lcd.setCursor(8, 1);
-  _lcd.printf(
-      "%s",
-      _scheduleActuatorConnectionTimes[_scheduleActuatorConnectionDisplayStart +
-                                       3]
-          .text);
-
-  // Cursor dinámico
-  _lcd.setCursor(0, 0);
-  _lcd.print(_scheduleActuatorConnectionOption == 0 ? ">" : " ");
-
-  _lcd.setCursor(7, 0);
-  _lcd.print(_scheduleActuatorConnectionOption == 1 ? ">" : " ");
-
-  _lcd.setCursor(0, 1);
-  _lcd.print(_scheduleActuatorConnectionOption == 2 ? ">" : " ");
-
-  _lcd.setCursor(7, 1);
-  _lcd.print(_scheduleActuatorConnectionOption == 3 ? ">" : " ");
-}
-
-void MenuManager::_showScheduleActuatorDesconnection() {
-  _lcd.setCursor(1, 0);
-  _lcd.printf("%s", _scheduleActuatorDesconnectionTimes
-                        [_scheduleActuatorDesconnectionDisplayStart]
-                            .text);
-  _lcd.setCursor(8, 0);
-  _lcd.printf("%s", _scheduleActuatorDesconnectionTimes
-                        [_scheduleActuatorDesconnectionDisplayStart + 1]
-                            .text);
-  _lcd.setCursor(1, 1);
-  _lcd.printf("%s", _scheduleActuatorDesconnectionTimes
-                        [_scheduleActuatorDesconnectionDisplayStart + 2]
-                            .text);
-  _lcd.setCursor(8, 1);
-  _lcd.printf("%s", _scheduleActuatorDesconnectionTimes
-                        [_scheduleActuatorDesconnectionDisplayStart + 3]
-                            .text);
-
-  // Cursor dinámico
-  _lcd.setCursor(0, 0);
-  _lcd.print(_scheduleActuatorDesconnectionOption == 0 ? ">" : " ");
-
-  _lcd.setCursor(7, 0);
-  _lcd.print(_scheduleActuatorDesconnectionOption == 1 ? ">" : " ");
-
-  _lcd.setCursor(0, 1);
-  _lcd.print(_scheduleActuatorDesconnectionOption == 2 ? ">" : " ");
-
-  _lcd.setCursor(7, 1);
-  _lcd.print(_scheduleActuatorDesconnectionOption == 3 ? ">" : " ");
-}
-
-void MenuManager::_showConfirm(const String& message) {
-  _lcd.setCursor(0, 0);
-  _lcd.print(message.c_str());
-
-  _lcd.setCursor(0, 1);
-  _lcd.print("    No     Si  ");
-
-  // Cursor dinámico
-  _lcd.setCursor(3, 1);
-  _lcd.print(_confirmOption == 0 ? ">" : " ");
-
-  _lcd.setCursor(10, 1);
-  _lcd.print(_confirmOption == 1 ? ">" : " ");
-}
\ No newline at end of file
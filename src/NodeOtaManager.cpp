@@ -0,0 +1,320 @@
+#include "NodeOtaManager.hpp"
+
+#include "Logger.hpp"
+#include "Utils.hpp"
+
+NodeOtaManager::NodeOtaManager(NowManager& now) : _now(now) {}
+
+bool NodeOtaManager::beginUpload() {
+  // No sobrescribir la imagen mientras se distribuye
+  if (isRunning()) return false;
+
+  _imageSize = 0;
+  _imageCrc = 0;
+  _uploadSize = 0;
+
+  _uploadFile = LittleFS.open(IMAGE_PATH, "w");
+  return (bool)_uploadFile;
+}
+
+bool NodeOtaManager::writeUpload(const uint8_t* data, size_t length) {
+  if (!_uploadFile) return false;
+
+  // La imagen va directa a flash; el CRC se calcula al vuelo
+  if (_uploadFile.write(data, length) != length) {
+    _uploadFile.close();
+    return false;
+  }
+
+  _imageCrc = calcCRC32(data, length, _imageCrc);
+  _uploadSize += length;
+  return true;
+}
+
+bool NodeOtaManager::endUpload() {
+  if (!_uploadFile) return false;
+
+  _uploadFile.close();
+  _imageSize = _uploadSize;
+
+  LOG_INFO("Imagen OTA de nodo: %lu bytes, CRC32 %08lX", _imageSize,
+           _imageCrc);
+
+  return _imageSize > 0;
+}
+
+bool NodeOtaManager::start(const uint8_t nodeType,
+                           const uint8_t* firmwareVersion) {
+  if (isRunning() || !hasImage() || !_now.getIsDataTransferEnabled())
+    return false;
+
+  if (_ackQueue == NULL) {
+    _ackQueue = _ackQueueStorage.create();
+    if (_ackQueue == NULL) return false;
+  }
+
+  // Todos los nodos del tipo indicado forman parte de la sesion
+  _targetCount = 0;
+  NowManager::DeviceInfo device;
+  for (size_t i = 0; _now.copyDeviceAt(i, device); i++) {
+    if (device.nodeType != nodeType || _targetCount >= MAX_TARGETS) continue;
+
+    TargetStats& target = _targets[_targetCount++];
+    target = TargetStats();
+    memcpy(target.mac, device.mac, 6);
+  }
+
+  if (_targetCount == 0) return false;
+
+  memcpy(_firmwareVersion, firmwareVersion, 3);
+
+  return xTaskCreatePinnedToCore(_task, "Node OTA", 4096, this, 1,
+                                 &_taskHandler, 1) == pdPASS;
+}
+
+bool NodeOtaManager::handleMessage(const uint8_t* mac, const uint8_t* data,
+                                   size_t length) {
+  if (length < 1) return false;
+
+  const auto msgType = static_cast<NowManager::MessageType>(data[0]);
+  if (msgType != NowManager::MessageType::OTA_ACK &&
+      msgType != NowManager::MessageType::OTA_RESULT)
+    return false;
+
+  // Mensaje OTA consumido aunque no haya sesion activa
+  if (!_isActiveTarget(mac)) return true;
+
+  AckEvent event;
+  memcpy(event.mac, mac, 6);
+  event.msgType = data[0];
+
+  if (NowManager::validateMessage(NowManager::MessageType::OTA_ACK, data,
+                                  length)) {
+    const NowManager::OtaAckMsg* msg =
+        reinterpret_cast<const NowManager::OtaAckMsg*>(data);
+
+    if (!verifyCRC8(*msg)) return true;
+
+    event.base = msg->base;
+    event.bitmap = msg->bitmap;
+  } else if (NowManager::validateMessage(NowManager::MessageType::OTA_RESULT,
+                                         data, length)) {
+    const NowManager::OtaResultMsg* msg =
+        reinterpret_cast<const NowManager::OtaResultMsg*>(data);
+
+    if (!verifyCRC8(*msg)) return true;
+
+    event.status = msg->status;
+  } else {
+    return true;
+  }
+
+  xQueueSend(_ackQueue, &event, 0);
+  return true;
+}
+
+NodeOtaManager::TargetStats NodeOtaManager::getTargetAt(
+    const uint8_t index) const {
+  if (index < _targetCount) return _targets[index];
+
+  return TargetStats();
+}
+
+void NodeOtaManager::_task(void* parameter) {
+  static_cast<NodeOtaManager*>(parameter)->_run();
+}
+
+void NodeOtaManager::_run() {
+  // La imagen se lee de flash chunk a chunk, nunca completa en RAM
+  File image = LittleFS.open(IMAGE_PATH, "r");
+
+  for (uint8_t i = 0; i < _targetCount; i++) {
+    TargetStats& target = _targets[i];
+
+    if (!image) {
+      target.result = Result::FAILED;
+      continue;
+    }
+
+    const uint32_t start = millis();
+    target.result = Result::IN_PROGRESS;
+    _setActiveTarget(target.mac);
+    target.result = _updateTarget(target, image);
+    _setActiveTarget(nullptr);
+    target.elapsed = millis() - start;
+
+    _printStats(target);
+  }
+
+  if (image) image.close();
+
+  _taskHandler = NULL;
+  vTaskDelete(NULL);
+}
+
+NodeOtaManager::Result NodeOtaManager::_updateTarget(TargetStats& target,
+                                                     File& image) {
+  const uint16_t chunkCount = (_imageSize + NowManager::OTA_CHUNK_SIZE - 1) /
+                              NowManager::OTA_CHUNK_SIZE;
+  uint32_t sentAt[WINDOW_SIZE];
+  uint16_t base = 0;   // Primer chunk sin confirmar
+  uint16_t next = 0;   // Siguiente chunk nunca enviado
+  uint32_t acked = 0;  // Bit i = chunk base + i confirmado
+  uint8_t timeouts = 0;
+  AckEvent event;
+
+  xQueueReset(_ackQueue);
+
+  // Anunciar la imagen; la primera confirmacion indica desde donde seguir
+  while (true) {
+    _now.sendOtaBeginMsg(target.mac, _imageSize, _imageCrc, _firmwareVersion,
+                         chunkCount);
+
+    if (_waitAck(target, event, ACK_TIMEOUT)) {
+      if (event.msgType ==
+          static_cast<uint8_t>(NowManager::MessageType::OTA_ACK))
+        break;
+
+      if (event.status != 0) return Result::FAILED;
+    }
+
+    if (++timeouts >= MAX_TIMEOUTS) return Result::TIMEOUT;
+  }
+
+  base = next = std::min(event.base, chunkCount);
+  timeouts = 0;
+
+  while (base < chunkCount) {
+    // Llenar la ventana con chunks nuevos
+    while (next < chunkCount && next < base + WINDOW_SIZE) {
+      if (!_sendChunk(target, image, next)) break;
+
+      sentAt[next % WINDOW_SIZE] = millis();
+      next++;
+    }
+
+    if (!_waitAck(target, event, ACK_TIMEOUT)) {
+      if (++timeouts >= MAX_TIMEOUTS) return Result::TIMEOUT;
+
+      // Sin noticias del nodo: reenviar todo lo pendiente de la ventana
+      for (uint16_t i = base; i < next; i++) {
+        if (acked & (1UL << (i - base))) continue;
+
+        if (_sendChunk(target, image, i)) {
+          target.retransmits++;
+          sentAt[i % WINDOW_SIZE] = millis();
+        }
+      }
+
+      continue;
+    }
+
+    if (event.msgType ==
+        static_cast<uint8_t>(NowManager::MessageType::OTA_RESULT)) {
+      // El nodo aborto la actualizacion
+      if (event.status != 0) return Result::FAILED;
+      continue;
+    }
+
+    // Confirmacion atrasada
+    if (event.base < base) continue;
+
+    timeouts = 0;
+    base = std::min(event.base, chunkCount);
+    if (next < base) next = base;
+    acked = event.bitmap;
+
+    // Reenvio selectivo: huecos por debajo del ultimo chunk confirmado
+    if (acked != 0) {
+      const uint16_t highest = base + (31 - __builtin_clz(acked));
+      const uint32_t now = millis();
+
+      for (uint16_t i = base; i < highest && i < next; i++) {
+        if (acked & (1UL << (i - base))) continue;
+        if (now - sentAt[i % WINDOW_SIZE] < RETRANSMIT_GUARD) continue;
+
+        if (_sendChunk(target, image, i)) {
+          target.retransmits++;
+          sentAt[i % WINDOW_SIZE] = now;
+        }
+      }
+    }
+  }
+
+  // Imagen completa: el nodo verifica el CRC32 antes de aplicarla
+  for (timeouts = 0; timeouts < MAX_TIMEOUTS; timeouts++) {
+    _now.sendOtaEndMsg(target.mac, _imageCrc);
+
+    if (_waitAck(target, event, RESULT_TIMEOUT / MAX_TIMEOUTS) &&
+        event.msgType ==
+            static_cast<uint8_t>(NowManager::MessageType::OTA_RESULT))
+      return event.status == 0 ? Result::SUCCESS : Result::FAILED;
+  }
+
+  return Result::TIMEOUT;
+}
+
+bool NodeOtaManager::_sendChunk(TargetStats& target, File& image,
+                                const uint16_t index) {
+  uint8_t buffer[NowManager::OTA_CHUNK_SIZE];
+  const uint32_t offset = index * NowManager::OTA_CHUNK_SIZE;
+  const uint8_t length =
+      std::min<uint32_t>(NowManager::OTA_CHUNK_SIZE, _imageSize - offset);
+
+  if (!image.seek(offset) || image.read(buffer, length) != length) return false;
+
+  if (!_now.sendOtaChunkMsg(target.mac, index, buffer, length)) return false;
+
+  target.chunksSent++;
+  target.bytesSent += length;
+  return true;
+}
+
+bool NodeOtaManager::_waitAck(const TargetStats& target, AckEvent& event,
+                              const uint32_t timeout) {
+  const uint32_t start = millis();
+  uint32_t elapsed = 0;
+
+  while (elapsed < timeout) {
+    if (xQueueReceive(_ackQueue, &event, pdMS_TO_TICKS(timeout - elapsed)) !=
+        pdPASS)
+      return false;
+
+    if (memcmp(event.mac, target.mac, 6) == 0) return true;
+
+    elapsed = millis() - start;
+  }
+
+  return false;
+}
+
+void NodeOtaManager::_setActiveTarget(const uint8_t* mac) {
+  portENTER_CRITICAL(&_mux);
+  if (mac != nullptr) memcpy(_activeMac, mac, 6);
+  _hasActiveTarget = mac != nullptr;
+  portEXIT_CRITICAL(&_mux);
+}
+
+bool NodeOtaManager::_isActiveTarget(const uint8_t* mac) {
+  portENTER_CRITICAL(&_mux);
+  const bool isActive = _hasActiveTarget && memcmp(mac, _activeMac, 6) == 0;
+  portEXIT_CRITICAL(&_mux);
+
+  return isActive;
+}
+
+void NodeOtaManager::_printStats(const TargetStats& target) {
+  const float seconds = target.elapsed / 1000.0;
+  const float throughput = seconds > 0 ? (_imageSize / 1024.0) / seconds : 0;
+  const float retransmitRate =
+      target.chunksSent > 0 ? 100.0 * target.retransmits / target.chunksSent
+                            : 0;
+
+  LOG_INFO(
+      "OTA nodo %s: %s, %lu bytes en %lu ms (%.2f KB/s), retransmisiones "
+      "%lu/%lu (%.1f%%)",
+      MacText(target.mac).c_str(),
+      target.result == Result::SUCCESS ? "OK" : "Error", _imageSize,
+      target.elapsed, throughput, target.retransmits, target.chunksSent,
+      retransmitRate);
+}
@@ -2,11 +2,63 @@
 
 #include <WiFi.h>
 
+#include "Trace.hpp"
 #include "Utils.hpp"
 
+namespace {
+
+// Mutex de las tablas tomado hasta el final del bloque
+class TableLock {
+ public:
+  explicit TableLock(SemaphoreHandle_t mutex) : _mutex(mutex) {
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+  }
+  ~TableLock() { xSemaphoreGive(_mutex); }
+
+ private:
+  SemaphoreHandle_t _mutex;
+};
+
+// Registros copiados con un indice fuera de rango. Se construyen una vez,
+// antes de setup(), y son de solo lectura
+NowManager::DeviceInfo makeFallbackDevice() {
+  NowManager::DeviceInfo data = NowManager::DeviceInfo();
+  strlcpy(data.deviceName, "Nodo secundario", sizeof(data.deviceName));
+
+  return data;
+}
+
+NowManager::SensorData makeFallbackSensor() {
+  NowManager::SensorData data = NowManager::SensorData();
+  strlcpy(data.deviceName, "Nodo secundario", sizeof(data.deviceName));
+  data.type = NowManager::SensorValueType::BOOL;
+  data.value.b = false;
+
+  return data;
+}
+
+NowManager::ActuatorData makeFallbackActuator() {
+  NowManager::ActuatorData data = NowManager::ActuatorData();
+  strlcpy(data.deviceName, "Nodo secundario", sizeof(data.deviceName));
+  data.state = false;
+
+  return data;
+}
+
+const NowManager::DeviceInfo FALLBACK_DEVICE = makeFallbackDevice();
+const NowManager::SensorData FALLBACK_SENSOR = makeFallbackSensor();
+const NowManager::ActuatorData FALLBACK_ACTUATOR = makeFallbackActuator();
+
+}  // namespace
+
 bool NowManager::init() {
+  if (_mutex == NULL) _mutex = _mutexStorage.create();
+  if (_mutex == NULL) return false;
+
   if (esp_now_init() != ESP_OK) return false;
 
+  WiFi.macAddress(_ownMac);
+
   return true;
 }
 
@@ -17,13 +69,18 @@ bool NowManager::stop() {
 }
 
 bool NowManager::reset() {
-  // Eliminar todos los peers
-  for (auto& device : _pairedDevices) {
-    if (!removeDevice(device.mac)) return false;
-  }
+  // Eliminar todos los peers y vaciar las listas en un solo paso: ninguna
+  // tarea ve la tabla a medias. Se vuelven a registrar desde la configuracion
+  {
+    TableLock lock(_mutex);
+    for (const auto& device : _pairedDevices) {
+      if (esp_now_del_peer(device.mac) != ESP_OK) return false;
+    }
 
-  // Vaciar sensor list
-  _sensors.clear();
+    _pairedDevices.clear();
+    _sensors.clear();
+    _actuators.clear();
+  }
 
   // Eliminar broadcast peer si existe
   if (_isBroadcastPeerRegistered) {
@@ -86,13 +143,13 @@ bool NowManager::sendSyncBroadcastMsg() {
   // Generate CRC8
   addCRC8(msg);
 
-  return esp_now_send(_broadcastMac, (uint8_t*)&msg, sizeof(msg)) == ESP_OK;
+  return _transmit(_broadcastMac, _broadcastMac, (uint8_t*)&msg, sizeof(msg));
 }
 
 bool NowManager::sendConfirmRegistrationMsg(const uint8_t* mac) {
   NowManager::ConfirmRegistrationMsg msg;
 
-  return esp_now_send(mac, (uint8_t*)&msg, sizeof(msg)) == ESP_OK;
+  return _send(mac, (uint8_t*)&msg, sizeof(msg));
 }
 
 bool NowManager::sendSetActuatorMsg(const uint8_t* mac, const bool state) {
@@ -104,7 +161,7 @@ bool NowManager::sendSetActuatorMsg(const uint8_t* mac, const bool state) {
   // Generate CRC8
   addCRC8(msg);
 
-  return esp_now_send(mac, (uint8_t*)&msg, sizeof(msg)) == ESP_OK;
+  return _send(mac, (uint8_t*)&msg, sizeof(msg));
 }
 
 bool NowManager::sendScheduleActuatorMsg(const uint8_t* mac,
@@ -119,7 +176,7 @@ bool NowManager::sendScheduleActuatorMsg(const uint8_t* mac,
   // Generate CRC8
   addCRC8(msg);
 
-  return esp_now_send(mac, (uint8_t*)&msg, sizeof(msg)) == ESP_OK;
+  return _send(mac, (uint8_t*)&msg, sizeof(msg));
 }
 
 bool NowManager::sendPingMsg(const uint8_t* mac) {
@@ -127,7 +184,178 @@ bool NowManager::sendPingMsg(const uint8_t* mac) {
 
   NowManager::PingMsg msg;
 
-  return esp_now_send(mac, (uint8_t*)&msg, sizeof(msg)) == ESP_OK;
+  return _send(mac, (uint8_t*)&msg, sizeof(msg));
+}
+
+bool NowManager::sendReportConfigMsg(const uint8_t* mac,
+                                     const uint32_t interval,
+                                     const float threshold) {
+  if (!_isDataTransferEnabled) return false;
+
+  NowManager::ReportConfigMsg msg;
+  msg.interval = interval;
+  msg.threshold = threshold;
+
+  // Generate CRC8
+  addCRC8(msg);
+
+  return _send(mac, (uint8_t*)&msg, sizeof(msg));
+}
+
+bool NowManager::sendOtaBeginMsg(const uint8_t* mac, const uint32_t imageSize,
+                                 const uint32_t imageCrc,
+                                 const uint8_t* firmwareVersion,
+                                 const uint16_t chunkCount) {
+  if (!_isDataTransferEnabled) return false;
+
+  NowManager::OtaBeginMsg msg;
+  msg.imageSize = imageSize;
+  msg.imageCrc = imageCrc;
+  memcpy(msg.firmwareVersion, firmwareVersion, 3);
+  msg.chunkCount = chunkCount;
+
+  // Generate CRC8
+  addCRC8(msg);
+
+  return _send(mac, (uint8_t*)&msg, sizeof(msg));
+}
+
+bool NowManager::sendOtaChunkMsg(const uint8_t* mac, const uint16_t index,
+                                 const uint8_t* data, const uint8_t length) {
+  if (!_isDataTransferEnabled || length > OTA_CHUNK_SIZE) return false;
+
+  NowManager::OtaChunkMsg msg;
+  msg.index = index;
+  msg.length = length;
+  memcpy(msg.data, data, length);
+  memset(msg.data + length, 0xFF, OTA_CHUNK_SIZE - length);
+
+  // Generate CRC8
+  addCRC8(msg);
+
+  return _send(mac, (uint8_t*)&msg, sizeof(msg));
+}
+
+bool NowManager::sendOtaEndMsg(const uint8_t* mac, const uint32_t imageCrc) {
+  if (!_isDataTransferEnabled) return false;
+
+  NowManager::OtaEndMsg msg;
+  msg.imageCrc = imageCrc;
+
+  // Generate CRC8
+  addCRC8(msg);
+
+  return _send(mac, (uint8_t*)&msg, sizeof(msg));
+}
+
+bool NowManager::sendRelayRoleMsg(const uint8_t* mac, const bool enabled) {
+  if (!_isDataTransferEnabled) return false;
+
+  NowManager::RelayRoleMsg msg;
+  msg.enabled = enabled;
+
+  // Generate CRC8
+  addCRC8(msg);
+
+  return _send(mac, (uint8_t*)&msg, sizeof(msg));
+}
+
+bool NowManager::_send(const uint8_t* mac, const uint8_t* data,
+                       size_t length) {
+  // La ruta se copia: la tarea de recepcion puede cambiarla mientras tanto
+  uint8_t nextHop[6];
+  bool isDirect = true;
+  {
+    TableLock lock(_mutex);
+    const DeviceInfo* device = _findDevice(mac);
+
+    // Vecino directo o ruta caducada: envio directo
+    if (device != nullptr && device->hops > 0 &&
+        millis() - device->routeUpdated <= ROUTE_TIMEOUT) {
+      memcpy(nextHop, device->nextHop, 6);
+      isDirect = false;
+    }
+  }
+
+  if (isDirect) return _transmit(mac, mac, data, length);
+
+  if (sizeof(RelayHeader) + length > ESP_NOW_MAX_DATA_LEN) return false;
+
+  // Encapsular y entregar al primer relay de la ruta
+  uint8_t frame[ESP_NOW_MAX_DATA_LEN];
+  RelayHeader header;
+  memcpy(header.origin, _ownMac, 6);
+  memcpy(header.destination, mac, 6);
+  header.hops = 0;
+  header.seq = _relaySeq++;
+
+  memcpy(frame, &header, sizeof(header));
+  memcpy(frame + sizeof(header), data, length);
+
+  return _transmit(nextHop, mac, frame, sizeof(header) + length);
+}
+
+bool NowManager::_transmit(const uint8_t* nextHop, const uint8_t* destination,
+                           const uint8_t* data, size_t length) {
+  // Se anota antes de enviar: el callback puede llegar antes del retorno
+  portENTER_CRITICAL(&_sendMux);
+  if (_pendingCount == MAX_PENDING_SENDS) {
+    _pendingHead = (_pendingHead + 1) % MAX_PENDING_SENDS;
+    _pendingCount--;
+  }
+  PendingSend& pending =
+      _pendingSends[(_pendingHead + _pendingCount) % MAX_PENDING_SENDS];
+  memcpy(pending.nextHop, nextHop, 6);
+  memcpy(pending.destination, destination, 6);
+  pending.sentAt = micros();
+  _pendingCount++;
+  portEXIT_CRITICAL(&_sendMux);
+
+  if (esp_now_send(nextHop, data, length) == ESP_OK) return true;
+
+  // Sin envio no habra callback: se retira la anotacion mas reciente
+  portENTER_CRITICAL(&_sendMux);
+  for (uint8_t i = _pendingCount; i > 0; i--) {
+    const uint8_t slot = (_pendingHead + i - 1) % MAX_PENDING_SENDS;
+    if (memcmp(_pendingSends[slot].nextHop, nextHop, 6) != 0 ||
+        memcmp(_pendingSends[slot].destination, destination, 6) != 0)
+      continue;
+
+    for (uint8_t j = i; j < _pendingCount; j++) {
+      _pendingSends[(_pendingHead + j - 1) % MAX_PENDING_SENDS] =
+          _pendingSends[(_pendingHead + j) % MAX_PENDING_SENDS];
+    }
+    _pendingCount--;
+    break;
+  }
+  portEXIT_CRITICAL(&_sendMux);
+
+  return false;
+}
+
+uint32_t NowManager::popSendDestination(const uint8_t* mac,
+                                        uint8_t* destination) {
+  const uint32_t now = micros();
+  uint32_t elapsed = 0;
+  memcpy(destination, mac, 6);
+
+  // Los callbacks llegan en orden de envio; lo que no corresponde a este
+  // vecino se perdio sin callback y se descarta
+  portENTER_CRITICAL(&_sendMux);
+  while (_pendingCount > 0) {
+    const PendingSend& pending = _pendingSends[_pendingHead];
+    _pendingHead = (_pendingHead + 1) % MAX_PENDING_SENDS;
+    _pendingCount--;
+
+    if (memcmp(pending.nextHop, mac, 6) == 0) {
+      memcpy(destination, pending.destination, 6);
+      elapsed = now - pending.sentAt;
+      break;
+    }
+  }
+  portEXIT_CRITICAL(&_sendMux);
+
+  return elapsed;
 }
 
 bool NowManager::validateMessage(MessageType expectedType, const uint8_t* data,
@@ -139,6 +367,197 @@ bool NowManager::validateMessage(MessageType expectedType, const uint8_t* data,
   return (msgType == expectedType) && (length == _getMessageSize(expectedType));
 }
 
+bool NowManager::admitSender(const uint8_t* mac) {
+  TRACE_SCOPE("now_admit");
+  TableLock lock(_mutex);
+
+  // Antes de decodificar nada, relay y OTA incluidos, para que un vecino
+  // defectuoso no acapare el callback de recepcion ni la pantalla
+  DeviceInfo* device = _findDevice(mac);
+  if (device == nullptr) return false;
+
+  if (!_consumeToken(device->filter)) {
+    device->filter.rateLimitDrops++;
+    return false;
+  }
+
+  return true;
+}
+
+bool NowManager::acceptFrame(const uint8_t* mac, const uint8_t* data,
+                             size_t length) {
+  TRACE_SCOPE("now_accept");
+  TableLock lock(_mutex);
+
+  DeviceInfo* device = _findDevice(mac);
+  if (device == nullptr || length < 1) return false;
+
+  // La ventana no se mueve aqui: solo commitFrame(), con el CRC ya validado
+  if (_hasSequence(static_cast<MessageType>(data[0])) && length >= 3) {
+    uint16_t seq;
+    memcpy(&seq, data + 1, sizeof(seq));
+
+    if (_isDuplicate(device->filter.frames, seq)) {
+      device->filter.duplicateDrops++;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void NowManager::commitFrame(const uint8_t* mac, const uint8_t* data,
+                             size_t length) {
+  TableLock lock(_mutex);
+  DeviceInfo* device = _findDevice(mac);
+  if (device == nullptr || length < 3) return;
+
+  if (!_hasSequence(static_cast<MessageType>(data[0]))) return;
+
+  uint16_t seq;
+  memcpy(&seq, data + 1, sizeof(seq));
+  _commitSequence(device->filter.frames, seq);
+}
+
+bool NowManager::resolveOrigin(const uint8_t* sender, const uint8_t*& data,
+                               int& length, const uint8_t*& origin) {
+  if (length < 1) return false;
+
+  TableLock lock(_mutex);
+
+  // Trama directa: el emisor es el origen y es un vecino
+  if (static_cast<MessageType>(data[0]) != MessageType::RELAY) {
+    origin = sender;
+
+    DeviceInfo* device = _findDevice(sender);
+    if (device != nullptr) _learnRoute(*device, sender, 0);
+
+    return true;
+  }
+
+  if (length <= (int)sizeof(RelayHeader)) return false;
+
+  RelayHeader header;
+  memcpy(&header, data, sizeof(header));
+
+  // Solo se aceptan tramas para el master reenviadas por nodos vinculados
+  if (memcmp(header.destination, _ownMac, 6) != 0 &&
+      memcmp(header.destination, _broadcastMac, 6) != 0)
+    return false;
+
+  // El ultimo salto debe ser un nodo vinculado con el rol de relay activo
+  const DeviceInfo* relay = _findDevice(sender);
+  if (header.hops > RELAY_MAX_HOPS || relay == nullptr || !relay->isRelay)
+    return false;
+
+  DeviceInfo* device = _findDevice(header.origin);
+  if (device == nullptr) return false;
+
+  // La misma trama llega por varios relays: solo se procesa la primera
+  if (_isDuplicate(device->filter.relayed, header.seq)) {
+    device->filter.duplicateDrops++;
+    return false;
+  }
+  _commitSequence(device->filter.relayed, header.seq);
+
+  _learnRoute(*device, sender, header.hops);
+
+  origin = device->mac;
+  data += sizeof(RelayHeader);
+  length -= sizeof(RelayHeader);
+
+  return true;
+}
+
+void NowManager::_learnRoute(DeviceInfo& device, const uint8_t* nextHop,
+                             const uint8_t hops) {
+  const uint32_t now = millis();
+
+  // Se prefiere la ruta mas corta mientras siga viva
+  if (hops > device.hops && now - device.routeUpdated <= ROUTE_TIMEOUT)
+    return;
+
+  memcpy(device.nextHop, nextHop, 6);
+  device.hops = hops;
+  device.routeUpdated = now;
+}
+
+bool NowManager::_hasSequence(MessageType type) {
+  switch (type) {
+    case MessageType::TEMPERATURE_HUMIDITY:
+    case MessageType::ACTUATOR_STATE:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+bool NowManager::_isDuplicate(const SequenceWindow& window,
+                              const uint16_t seq) {
+  if (!window.hasSeq) return false;
+
+  const int16_t diff = static_cast<int16_t>(seq - window.lastSeq);
+
+  // Trama mas reciente
+  if (diff > 0) return false;
+
+  const uint16_t offset = -diff;
+
+  // Salto atras mayor que la ventana: el nodo ha reiniciado su secuencia
+  // sin volver a vincularse. commitFrame() vuelve a sincronizar la ventana
+  if (offset >= DUPLICATE_WINDOW_SIZE) return false;
+
+  return (window.bitmap & (1UL << offset)) != 0;
+}
+
+void NowManager::_commitSequence(SequenceWindow& window, const uint16_t seq) {
+  if (!window.hasSeq) {
+    window.hasSeq = true;
+    window.lastSeq = seq;
+    window.bitmap = 1;
+    return;
+  }
+
+  const int16_t diff = static_cast<int16_t>(seq - window.lastSeq);
+
+  // Trama mas reciente: desplazar la ventana
+  if (diff > 0) {
+    window.bitmap =
+        (diff < DUPLICATE_WINDOW_SIZE) ? (window.bitmap << diff) | 1 : 1;
+    window.lastSeq = seq;
+    return;
+  }
+
+  const uint16_t offset = -diff;
+
+  // Secuencia reiniciada: la ventana empieza de nuevo en esta trama
+  if (offset >= DUPLICATE_WINDOW_SIZE) {
+    window.lastSeq = seq;
+    window.bitmap = 1;
+    return;
+  }
+
+  window.bitmap |= 1UL << offset;
+}
+
+bool NowManager::_consumeToken(FrameFilter& filter) {
+  const uint32_t now = millis();
+  const uint32_t refill =
+      (now - filter.lastRefill) / RATE_LIMIT_REFILL_INTERVAL;
+
+  if (refill > 0) {
+    filter.tokens =
+        std::min<uint32_t>(RATE_LIMIT_BURST, filter.tokens + refill);
+    filter.lastRefill += refill * RATE_LIMIT_REFILL_INTERVAL;
+  }
+
+  if (filter.tokens == 0) return false;
+
+  filter.tokens--;
+  return true;
+}
+
 size_t NowManager::_getMessageSize(MessageType type) {
   switch (type) {
     case MessageType::SYNC_BROADCAST:
@@ -156,14 +575,24 @@ size_t NowManager::_getMessageSize(MessageType type) {
     case MessageType::ACTUATOR_STATE:
       return sizeof(ActuatorStateMsg);
 
+    case MessageType::OTA_ACK:
+      return sizeof(OtaAckMsg);
+
+    case MessageType::OTA_RESULT:
+      return sizeof(OtaResultMsg);
+
     default:
       return 0;  // Tipo desconocido
   }
 }
 
 bool NowManager::addDevice(const uint8_t* mac, const uint8_t nodeType,
-                           const String& deviceName,
-                           const uint8_t* firmwareVersion) {
+                           const char* deviceName,
+                           const uint8_t* firmwareVersion,
+                           const uint32_t reportInterval,
+                           const float reportThreshold, const bool isRelay) {
+  TableLock lock(_mutex);
+
   // Verificar si ya existe
   auto it = std::find_if(
       _pairedDevices.begin(), _pairedDevices.end(),
@@ -171,7 +600,7 @@ bool NowManager::addDevice(const uint8_t* mac, const uint8_t nodeType,
 
   if (it != _pairedDevices.end()) return false;
 
-  if (_pairedDevices.size() >= 12) return false;
+  if (_pairedDevices.full()) return false;
 
   // Añadir nuevo nodo
   DeviceInfo newDevice;
@@ -179,7 +608,15 @@ bool NowManager::addDevice(const uint8_t* mac, const uint8_t nodeType,
   memcpy(newDevice.firmwareVersion, firmwareVersion, 3);
   newDevice.nodeType = nodeType;
   newDevice.lastSeen = millis();
-  newDevice.deviceName = deviceName;
+  strlcpy(newDevice.deviceName, deviceName, sizeof(newDevice.deviceName));
+  newDevice.reportInterval = reportInterval;
+  newDevice.reportThreshold = reportThreshold;
+  newDevice.filter.lastRefill = newDevice.lastSeen;
+  newDevice.isRelay = isRelay;
+  memcpy(newDevice.nextHop, mac, 6);
+  newDevice.hops = 0;
+  // Ruta directa supuesta, ya caducada: la primera ruta aprendida la sustituye
+  newDevice.routeUpdated = newDevice.lastSeen - ROUTE_TIMEOUT - 1;
 
   _pairedDevices.push_back(newDevice);
 
@@ -193,14 +630,14 @@ bool NowManager::addDevice(const uint8_t* mac, const uint8_t nodeType,
     case NodeType::TEMPERATURE_HUMIDITY: {
       SensorData data;
       memcpy(data.mac, mac, 6);
-      data.deviceName = newDevice.deviceName;
-      data.variable = "Temp";
-      data.units = "C";
+      strlcpy(data.deviceName, newDevice.deviceName, sizeof(data.deviceName));
+      strlcpy(data.variable, "Temp", sizeof(data.variable));
+      strlcpy(data.units, "C", sizeof(data.units));
       data.type = SensorValueType::FLOAT;
       data.value.f = NAN;
       _sensors.push_back(data);
-      data.variable = "Hum";
-      data.units = "%";
+      strlcpy(data.variable, "Hum", sizeof(data.variable));
+      strlcpy(data.units, "%", sizeof(data.units));
       data.type = SensorValueType::FLOAT;
       data.value.f = NAN;
       _sensors.push_back(data);
@@ -210,7 +647,7 @@ bool NowManager::addDevice(const uint8_t* mac, const uint8_t nodeType,
     case NodeType::RELAY: {
       ActuatorData data;
       memcpy(data.mac, mac, 6);
-      data.deviceName = newDevice.deviceName;
+      strlcpy(data.deviceName, newDevice.deviceName, sizeof(data.deviceName));
       data.state = false;
       _actuators.push_back(data);
       break;
@@ -221,13 +658,19 @@ bool NowManager::addDevice(const uint8_t* mac, const uint8_t nodeType,
 }
 
 void NowManager::printAllDevices() {
+  TableLock lock(_mutex);
   int i = 0;
   Serial.println("Dispositivos vinculados: ");
   if (_pairedDevices.size() > 0) {
     for (const auto& device : _pairedDevices) {
-      Serial.printf("%d - MAC: %s, Tipo: %d, Ultima vez: %lu\n", i,
-                    macToString(device.mac).c_str(), device.nodeType,
-                    device.lastSeen);
+      Serial.printf(
+          "%d - MAC: %s, Tipo: %d, Ultima vez: %lu, Reporte: %lums/%.2f, "
+          "Duplicados: %lu, Limitados: %lu, Relay: %s, Saltos: %d via %s\n",
+          i, MacText(device.mac).c_str(), device.nodeType, device.lastSeen,
+          device.reportInterval, device.reportThreshold,
+          device.filter.duplicateDrops, device.filter.rateLimitDrops,
+          formatBooleanToText(device.isRelay), device.hops,
+          MacText(device.nextHop).c_str());
 
       i++;
     }
@@ -238,8 +681,8 @@ void NowManager::printAllDevices() {
     i = 0;
     for (const auto& sensor : _sensors) {
       Serial.printf("%d - MAC: %s, Nombre: %s, Conectado?: %s\n", i,
-                    macToString(sensor.mac).c_str(), sensor.deviceName.c_str(),
-                    formatBooleanToText(sensor.isConnected).c_str());
+                    MacText(sensor.mac).c_str(), sensor.deviceName,
+                    formatBooleanToText(sensor.isConnected));
       i++;
     }
   }
@@ -249,116 +692,144 @@ void NowManager::printAllDevices() {
     i = 0;
     for (const auto& actuator : _actuators) {
       Serial.printf("%d - MAC: %s, Nombre: %s, Estado: %s, Conectado: %s\n", i,
-                    macToString(actuator.mac).c_str(),
-                    actuator.deviceName.c_str(),
-                    formatBooleanToText(actuator.state).c_str(),
-                    formatBooleanToText(actuator.isConnected).c_str());
+                    MacText(actuator.mac).c_str(),
+                    actuator.deviceName,
+                    formatBooleanToText(actuator.state),
+                    formatBooleanToText(actuator.isConnected));
       i++;
     }
   }
 }
 
-NowManager::SensorData NowManager::getSensorAt(const int index) const {
-  if (index >= 0 && index < _sensors.size()) {
-    return _sensors.at(index);
-  } else {
-    SensorData data;
-    data.deviceName = "Nodo secundario";
-    data.type = SensorValueType::BOOL;
-    data.value.b = false;
-
-    return data;
+bool NowManager::copyDeviceAt(const size_t index, DeviceInfo& device) {
+  TableLock lock(_mutex);
+  if (index >= _pairedDevices.size()) {
+    device = FALLBACK_DEVICE;
+    return false;
   }
+
+  device = _pairedDevices[index];
+  return true;
 }
 
-NowManager::ActuatorData NowManager::getActuatorAt(const int index) const {
-  if (index >= 0 && index < _actuators.size()) {
-    return _actuators.at(index);
-  } else {
-    ActuatorData data;
-    data.deviceName = "Nodo secundario";
-    data.state = false;
+bool NowManager::copySensorAt(const size_t index, SensorData& sensor) {
+  TableLock lock(_mutex);
+  if (index >= _sensors.size()) {
+    sensor = FALLBACK_SENSOR;
+    return false;
+  }
+
+  sensor = _sensors[index];
+  return true;
+}
 
-    return data;
+bool NowManager::copyActuatorAt(const size_t index, ActuatorData& actuator) {
+  TableLock lock(_mutex);
+  if (index >= _actuators.size()) {
+    actuator = FALLBACK_ACTUATOR;
+    return false;
   }
+
+  actuator = _actuators[index];
+  return true;
+}
+
+bool NowManager::getNodeType(const uint8_t* mac, NodeType& nodeType) {
+  TableLock lock(_mutex);
+  const DeviceInfo* device = _findDevice(mac);
+  if (device == nullptr) return false;
+
+  nodeType = static_cast<NodeType>(device->nodeType);
+  return true;
 }
 
 void NowManager::setDataTransfer(const bool state) {
   _isDataTransferEnabled = state;
 }
 
-void NowManager::updateSensorData(const uint8_t* mac, const String& variable,
+void NowManager::updateSensorData(const uint8_t* mac, const char* variable,
                                   const bool value) {
+  TRACE_SCOPE("now_update_sensor");
+  TableLock lock(_mutex);
   auto it = std::find_if(
       _sensors.begin(), _sensors.end(), [&mac, &variable](const SensorData& d) {
-        return memcmp(d.mac, mac, 6) == 0 && d.variable == variable;
+        return memcmp(d.mac, mac, 6) == 0 && strcmp(d.variable, variable) == 0;
       });
 
   if (it != _sensors.end()) {
-    it.base()->value.b = value;
-    it.base()->isConnected = true;
+    it->value.b = value;
+    it->isConnected = true;
   }
 }
 
-void NowManager::updateSensorData(const uint8_t* mac, const String& variable,
+void NowManager::updateSensorData(const uint8_t* mac, const char* variable,
                                   const int value) {
+  TRACE_SCOPE("now_update_sensor");
+  TableLock lock(_mutex);
   auto it = std::find_if(
       _sensors.begin(), _sensors.end(), [&mac, &variable](const SensorData& d) {
-        return memcmp(d.mac, mac, 6) == 0 && d.variable == variable;
+        return memcmp(d.mac, mac, 6) == 0 && strcmp(d.variable, variable) == 0;
       });
 
   if (it != _sensors.end()) {
-    it.base()->value.i = value;
-    it.base()->isConnected = true;
+    it->value.i = value;
+    it->isConnected = true;
   }
 }
 
-void NowManager::updateSensorData(const uint8_t* mac, const String& variable,
+void NowManager::updateSensorData(const uint8_t* mac, const char* variable,
                                   const float value) {
+  TRACE_SCOPE("now_update_sensor");
+  TableLock lock(_mutex);
   auto it = std::find_if(
       _sensors.begin(), _sensors.end(), [&mac, &variable](const SensorData& d) {
-        return memcmp(d.mac, mac, 6) == 0 && d.variable == variable;
+        return memcmp(d.mac, mac, 6) == 0 && strcmp(d.variable, variable) == 0;
       });
 
   if (it != _sensors.end()) {
-    it.base()->value.f = value;
-    it.base()->isConnected = true;
+    it->value.f = value;
+    it->isConnected = true;
   }
 }
 
 void NowManager::updateActuatorState(const uint8_t* mac, const bool state) {
+  TRACE_SCOPE("now_update_actuator");
+  TableLock lock(_mutex);
   auto it = std::find_if(
       _actuators.begin(), _actuators.end(),
       [&mac](const ActuatorData& d) { return memcmp(d.mac, mac, 6) == 0; });
 
   if (it != _actuators.end()) {
-    it.base()->state = state;
-    it.base()->isConnected = true;
+    it->state = state;
+    it->isConnected = true;
   }
 }
 
-void NowManager::desconnectSensor(const uint8_t* mac, const String& variable) {
+void NowManager::desconnectSensor(const uint8_t* mac, const char* variable) {
+  TableLock lock(_mutex);
   auto it = std::find_if(
       _sensors.begin(), _sensors.end(), [&mac, &variable](const SensorData& d) {
-        return memcmp(d.mac, mac, 6) == 0 && d.variable == variable;
+        return memcmp(d.mac, mac, 6) == 0 && strcmp(d.variable, variable) == 0;
       });
 
   if (it != _sensors.end()) {
-    it.base()->isConnected = false;
+    it->isConnected = false;
   }
 }
 
 void NowManager::desconnectActuator(const uint8_t* mac) {
+  TableLock lock(_mutex);
   auto it = std::find_if(
       _actuators.begin(), _actuators.end(),
       [&mac](const ActuatorData& d) { return memcmp(d.mac, mac, 6) == 0; });
 
   if (it != _actuators.end()) {
-    it.base()->isConnected = false;
+    it->isConnected = false;
   }
 }
 
 bool NowManager::isDevicePaired(const uint8_t* mac) {
+  TableLock lock(_mutex);
   auto it = std::find_if(
       _pairedDevices.begin(), _pairedDevices.end(),
       [&mac](const DeviceInfo& d) { return memcmp(d.mac, mac, 6) == 0; });
@@ -367,14 +838,55 @@ bool NowManager::isDevicePaired(const uint8_t* mac) {
 }
 
 void NowManager::updateDeviceLastSeen(const uint8_t* mac) {
+  TRACE_SCOPE("now_last_seen");
+  TableLock lock(_mutex);
   auto it = std::find_if(
       _pairedDevices.begin(), _pairedDevices.end(),
       [&mac](const DeviceInfo& d) { return memcmp(d.mac, mac, 6) == 0; });
 
-  if (it != _pairedDevices.end()) it.base()->lastSeen = millis();
+  if (it != _pairedDevices.end()) it->lastSeen = millis();
+}
+
+bool NowManager::isValidReportConfig(const uint32_t interval,
+                                     const float threshold) {
+  // Toda comparacion con NaN es falsa: tambien se rechaza
+  return interval >= MIN_REPORT_INTERVAL && interval <= MAX_REPORT_INTERVAL &&
+         threshold >= 0 && threshold <= MAX_REPORT_THRESHOLD;
+}
+
+bool NowManager::setReportConfig(const uint8_t* mac, const uint32_t interval,
+                                 const float threshold) {
+  if (!isValidReportConfig(interval, threshold) || !isDevicePaired(mac))
+    return false;
+
+  // La tabla solo cambia si la radio ha aceptado el envio
+  if (!sendReportConfigMsg(mac, interval, threshold)) return false;
+
+  TableLock lock(_mutex);
+  DeviceInfo* device = _findDevice(mac);
+  if (device == nullptr) return false;  // Eliminado durante el envio
+
+  device->reportInterval = interval;
+  device->reportThreshold = threshold;
+
+  return true;
+}
+
+bool NowManager::setRelayRole(const uint8_t* mac, const bool enabled) {
+  if (!isDevicePaired(mac)) return false;
+
+  if (!sendRelayRoleMsg(mac, enabled)) return false;
+
+  TableLock lock(_mutex);
+  DeviceInfo* device = _findDevice(mac);
+  if (device == nullptr) return false;
+
+  device->isRelay = enabled;
+
+  return true;
 }
 
-NowManager::DeviceInfo* NowManager::findDevice(const uint8_t* mac) {
+NowManager::DeviceInfo* NowManager::_findDevice(const uint8_t* mac) {
   auto it = std::find_if(
       _pairedDevices.begin(), _pairedDevices.end(),
       [&mac](const DeviceInfo& d) { return memcmp(d.mac, mac, 6) == 0; });
@@ -383,6 +895,7 @@ NowManager::DeviceInfo* NowManager::findDevice(const uint8_t* mac) {
 }
 
 bool NowManager::removeDevice(const uint8_t* mac) {
+  TableLock lock(_mutex);
   auto it = std::find_if(
       _pairedDevices.begin(), _pairedDevices.end(),
       [&mac](const DeviceInfo& d) { return memcmp(d.mac, mac, 6) == 0; });
@@ -398,10 +911,11 @@ bool NowManager::removeDevice(const uint8_t* mac) {
   return false;
 }
 
-bool NowManager::removeSensor(const uint8_t* mac, const String& variable) {
+bool NowManager::removeSensor(const uint8_t* mac, const char* variable) {
+  TableLock lock(_mutex);
   auto it = std::find_if(
       _sensors.begin(), _sensors.end(), [&mac, &variable](const SensorData& d) {
-        return memcmp(d.mac, mac, 6) == 0 && d.variable == variable;
+        return memcmp(d.mac, mac, 6) == 0 && strcmp(d.variable, variable) == 0;
       });
 
   if (it != _sensors.end()) {
@@ -413,6 +927,7 @@ bool NowManager::removeSensor(const uint8_t* mac, const String& variable) {
 }
 
 bool NowManager::removeActuator(const uint8_t* mac) {
+  TableLock lock(_mutex);
   auto it = std::find_if(
       _actuators.begin(), _actuators.end(),
       [&mac](const ActuatorData& d) { return memcmp(d.mac, mac, 6) == 0; });
@@ -0,0 +1,212 @@
+#include "PowerManager.hpp"
+
+#include <WiFi.h>
+#include <esp_timer.h>
+
+namespace {
+
+struct ProfileConfig {
+  int maxFreq;      // MHz
+  int minFreq;      // MHz; con Wi-Fi activo el minimo util es 80
+  bool lightSleep;  // Requiere CONFIG_FREERTOS_USE_TICKLESS_IDLE
+  int fixedFreq;    // MHz sin soporte de PM
+  bool modemSleep;  // Wi-Fi en modo ahorro: aumenta la latencia de recepcion
+};
+
+// Sin modem sleep en ningun perfil: la radio duerme entre beacons y las
+// tramas de los nodos se pierden sin que el master lo sepa. Solo podra
+// activarse cuando los nodos reintenten hasta confirmar la entrega
+const ProfileConfig PROFILES[] = {
+    {240, 240, false, 240, false},  // PERFORMANCE
+    {240, 80, false, 160, false},   // BALANCED
+    {160, 80, true, 80, false},     // LOW_POWER
+};
+
+static_assert(sizeof(PROFILES) / sizeof(PROFILES[0]) ==
+                  PowerManager::PROFILE_COUNT,
+              "PROFILES no cubre todos los perfiles");
+
+const esp_pm_lock_type_t LOCK_TYPES[] = {
+    ESP_PM_CPU_FREQ_MAX,    // RADIO_RX
+    ESP_PM_NO_LIGHT_SLEEP,  // RADIO_LISTEN
+    ESP_PM_CPU_FREQ_MAX,    // DISPLAY
+};
+
+const char* const LOCK_NAMES[] = {"radio_rx", "radio_listen", "display"};
+
+void addLatency(PowerManager::LatencyStats& stats, uint32_t latency) {
+  stats.count++;
+  stats.totalLatency += latency;
+  if (latency > stats.maxLatency) stats.maxLatency = latency;
+  if (latency > PowerManager::RADIO_LATENCY_BUDGET) stats.overBudget++;
+}
+
+uint32_t averageLatency(const PowerManager::LatencyStats& stats) {
+  return stats.count > 0
+             ? static_cast<uint32_t>(stats.totalLatency / stats.count)
+             : 0;
+}
+
+}  // namespace
+
+bool PowerManager::begin(Profile profile) {
+  _startTime = esp_timer_get_time();
+
+  for (uint8_t i = 0; i < LOCK_COUNT; i++) {
+    // Sin CONFIG_PM_ENABLE devuelve ESP_ERR_NOT_SUPPORTED: solo estadisticas
+    if (esp_pm_lock_create(LOCK_TYPES[i], 0, LOCK_NAMES[i],
+                           &_locks[i].handle) != ESP_OK)
+      _locks[i].handle = NULL;
+  }
+
+  return _configure(profile);
+}
+
+bool PowerManager::setProfile(Profile profile) { return _configure(profile); }
+
+void PowerManager::acquire(Lock lock) {
+  LockState& state = _locks[static_cast<uint8_t>(lock)];
+  if (state.handle != NULL) esp_pm_lock_acquire(state.handle);
+
+  portENTER_CRITICAL(&_mux);
+  if (state.depth++ == 0) {
+    state.since = esp_timer_get_time();
+    state.stats.acquisitions++;
+  }
+  portEXIT_CRITICAL(&_mux);
+}
+
+void PowerManager::release(Lock lock) {
+  LockState& state = _locks[static_cast<uint8_t>(lock)];
+
+  portENTER_CRITICAL(&_mux);
+  if (state.depth > 0 && --state.depth == 0)
+    state.stats.heldTime += esp_timer_get_time() - state.since;
+  portEXIT_CRITICAL(&_mux);
+
+  if (state.handle != NULL) esp_pm_lock_release(state.handle);
+}
+
+void PowerManager::recordRadioReceive(uint32_t latency) {
+  portENTER_CRITICAL(&_mux);
+  addLatency(_radioStats.rx, latency);
+  portEXIT_CRITICAL(&_mux);
+}
+
+void PowerManager::recordRadioSend(bool isDelivered, uint32_t latency) {
+  portENTER_CRITICAL(&_mux);
+  _radioStats.sent++;
+  if (isDelivered) addLatency(_radioStats.tx, latency);
+  portEXIT_CRITICAL(&_mux);
+}
+
+PowerManager::LockStats PowerManager::getLockStats(Lock lock) {
+  const LockState& state = _locks[static_cast<uint8_t>(lock)];
+
+  portENTER_CRITICAL(&_mux);
+  LockStats stats = state.stats;
+  if (state.depth > 0) stats.heldTime += esp_timer_get_time() - state.since;
+  portEXIT_CRITICAL(&_mux);
+
+  return stats;
+}
+
+PowerManager::RadioStats PowerManager::getRadioStats() {
+  portENTER_CRITICAL(&_mux);
+  const RadioStats stats = _radioStats;
+  portEXIT_CRITICAL(&_mux);
+
+  return stats;
+}
+
+uint64_t PowerManager::getUptime() const {
+  return esp_timer_get_time() - _startTime;
+}
+
+void PowerManager::printStats(Print& output) {
+  const uint64_t uptime = getUptime();
+
+  output.printf("Perfil: %s, DFS: %s, light sleep: %s, CPU: %lu MHz\n",
+                profileToText(_profile), _isDynamic ? "Si" : "No",
+                _isLightSleepEnabled ? "Si" : "No", getCpuFrequencyMhz());
+
+  for (uint8_t i = 0; i < LOCK_COUNT; i++) {
+    const LockStats stats = getLockStats(static_cast<Lock>(i));
+    output.printf("Lock %s: %lu veces, %llu ms (%u%%)\n", LOCK_NAMES[i],
+                  stats.acquisitions, stats.heldTime / 1000,
+                  uptime > 0 ? static_cast<unsigned>(stats.heldTime * 100 /
+                                                     uptime)
+                             : 0);
+  }
+
+  const RadioStats radio = getRadioStats();
+  output.printf(
+      "Radio RX: %lu tramas, media %lu us, max %lu us, %lu > %lu us\n",
+      radio.rx.count, averageLatency(radio.rx), radio.rx.maxLatency,
+      radio.rx.overBudget, RADIO_LATENCY_BUDGET);
+  output.printf(
+      "Radio TX: %lu/%lu entregas, media %lu us, max %lu us, %lu > %lu us\n",
+      radio.tx.count, radio.sent, averageLatency(radio.tx),
+      radio.tx.maxLatency, radio.tx.overBudget, RADIO_LATENCY_BUDGET);
+
+#ifdef CONFIG_PM_PROFILING
+  // Tiempo en cada modo (CPU_MAX, APB_MAX, APB_MIN, LIGHT_SLEEP)
+  esp_pm_dump_locks(stdout);
+#endif
+}
+
+const char* PowerManager::profileToText(Profile profile) {
+  switch (profile) {
+    case Profile::PERFORMANCE:
+      return "performance";
+    case Profile::BALANCED:
+      return "balanced";
+    case Profile::LOW_POWER:
+      return "low_power";
+  }
+
+  return "";
+}
+
+const char* PowerManager::lockToText(Lock lock) {
+  return LOCK_NAMES[static_cast<uint8_t>(lock)];
+}
+
+bool PowerManager::_configure(Profile profile) {
+  const uint8_t index = static_cast<uint8_t>(profile);
+  if (index >= sizeof(PROFILES) / sizeof(PROFILES[0])) return false;
+
+  const ProfileConfig& config = PROFILES[index];
+
+  esp_pm_config_esp32_t pmConfig;
+  pmConfig.max_freq_mhz = config.maxFreq;
+  pmConfig.min_freq_mhz = config.minFreq;
+  pmConfig.light_sleep_enable = config.lightSleep;
+
+  esp_err_t result = esp_pm_configure(&pmConfig);
+
+  // Sin tickless idle no hay light sleep: se mantiene solo el DFS
+  if (result == ESP_ERR_NOT_SUPPORTED && config.lightSleep) {
+    pmConfig.light_sleep_enable = false;
+    result = esp_pm_configure(&pmConfig);
+  }
+
+  if (result == ESP_OK) {
+    _isDynamic = config.minFreq != config.maxFreq;
+    // El Wi-Fi sin modem sleep retiene su propio lock: con la radio activa
+    // el light sleep configurado nunca llega a ocurrir
+    _isLightSleepEnabled = pmConfig.light_sleep_enable && config.modemSleep;
+  } else if (result == ESP_ERR_NOT_SUPPORTED) {
+    // Sin CONFIG_PM_ENABLE: frecuencia fija segun el perfil
+    if (!setCpuFrequencyMhz(config.fixedFreq)) return false;
+    _isDynamic = false;
+    _isLightSleepEnabled = false;
+  } else {
+    return false;
+  }
+
+  WiFi.setSleep(config.modemSleep);
+  _profile = profile;
+
+  return true;
+}
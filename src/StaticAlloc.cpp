@@ -0,0 +1,127 @@
+#include "StaticAlloc.hpp"
+
+#include <esp_heap_caps.h>
+#include <esp_rom_sys.h>
+
+namespace {
+
+struct WatchedTask {
+  TaskHandle_t handle;
+  uint8_t exemptDepth;  // Secciones HeapGuard::Exempt anidadas
+  volatile uint32_t allocations;
+};
+
+WatchedTask watchedTasks[HeapGuard::MAX_TASKS] = {};
+uint8_t watchedCount = 0;
+volatile bool isArmed = false;
+
+}  // namespace
+
+bool HeapGuard::watch(TaskHandle_t task) {
+#ifdef STATIC_ALLOCATION
+  if (watchedCount >= MAX_TASKS) return false;
+
+  watchedTasks[watchedCount].handle =
+      task != NULL ? task : xTaskGetCurrentTaskHandle();
+  watchedTasks[watchedCount].exemptDepth = 0;
+  watchedTasks[watchedCount].allocations = 0;
+  watchedCount++;
+#endif
+
+  return true;
+}
+
+void HeapGuard::arm() {
+#ifdef STATIC_ALLOCATION
+  isArmed = true;
+#endif
+}
+
+HeapGuard::Stats HeapGuard::getStats() {
+  Stats stats;
+  stats.freeHeap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  stats.minFreeHeap = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+  stats.largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  stats.isArmed = isArmed;
+
+  return stats;
+}
+
+uint8_t HeapGuard::getTaskCount() { return watchedCount; }
+
+HeapGuard::TaskStats HeapGuard::getTaskStats(uint8_t index) {
+  TaskStats stats = {"", 0};
+  if (index >= watchedCount) return stats;
+
+  stats.name = pcTaskGetName(watchedTasks[index].handle);
+  stats.allocations = watchedTasks[index].allocations;
+  return stats;
+}
+
+uint32_t HeapGuard::getAllocations(TaskHandle_t task) {
+  if (task == NULL) task = xTaskGetCurrentTaskHandle();
+
+  for (uint8_t i = 0; i < watchedCount; i++) {
+    if (watchedTasks[i].handle == task) return watchedTasks[i].allocations;
+  }
+
+  return 0;
+}
+
+void IRAM_ATTR HeapGuard::check(size_t size) {
+  const TaskHandle_t current = xTaskGetCurrentTaskHandle();
+
+  for (uint8_t i = 0; i < watchedCount; i++) {
+    if (watchedTasks[i].handle != current) continue;
+
+    // Solo escribe la propia tarea
+    watchedTasks[i].allocations = watchedTasks[i].allocations + 1;
+    if (!isArmed || watchedTasks[i].exemptDepth > 0) return;
+
+    // Sin printf de newlib: podria volver a reservar memoria
+    esp_rom_printf("HeapGuard: %u bytes reservados en '%s' tras setup()\n",
+                   size, pcTaskGetName(current));
+    abort();
+  }
+}
+
+void HeapGuard::_exempt(bool enter) {
+#ifdef STATIC_ALLOCATION
+  const TaskHandle_t current = xTaskGetCurrentTaskHandle();
+
+  for (uint8_t i = 0; i < watchedCount; i++) {
+    if (watchedTasks[i].handle != current) continue;
+
+    if (enter)
+      watchedTasks[i].exemptDepth++;
+    else if (watchedTasks[i].exemptDepth > 0)
+      watchedTasks[i].exemptDepth--;
+    return;
+  }
+#endif
+}
+
+#ifdef STATIC_ALLOCATION
+// Enlazado con -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc: operator new
+// y String pasan tambien por aqui
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+
+void* IRAM_ATTR __wrap_malloc(size_t size) {
+  HeapGuard::check(size);
+  return __real_malloc(size);
+}
+
+void* IRAM_ATTR __wrap_calloc(size_t count, size_t size) {
+  HeapGuard::check(count * size);
+  return __real_calloc(count, size);
+}
+
+void* IRAM_ATTR __wrap_realloc(void* pointer, size_t size) {
+  HeapGuard::check(size);
+  return __real_realloc(pointer, size);
+}
+}
+#endif
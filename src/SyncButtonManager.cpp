@@ -1,48 +1,62 @@
 #include "SyncButtonManager.hpp"
 
-SyncButtonManager::SyncButtonManager(const gpio_num_t buttonPin)
-    : _PIN(buttonPin) {}
+SyncButtonManager::SyncButtonManager(const gpio_num_t buttonPin,
+                                     EventBus& bus)
+    : _input(buttonPin, BUTTON_EDGE), _bus(bus) {}
 
-void SyncButtonManager::begin() {
-  _debouncer.attach(_PIN, INPUT_PULLUP);
-  _debouncer.interval(DEBOUNCE_INTERVAL);
+bool SyncButtonManager::begin() {
+  _queue = _queueStorage.create();
+  if (_queue == NULL) return false;
+
+  _longPressTimer = _longPressTimerStorage.create(
+      "Long Press", pdMS_TO_TICKS(LONG_PRESS_DURATION), pdFALSE, this,
+      _onLongPressTimer);
+  if (_longPressTimer == NULL) return false;
+
+  return _input.begin(_queue);
 }
 
 void SyncButtonManager::update() {
-  _debouncer.update();
+  DebouncedInput::Edge edge;
 
-  if (_debouncer.fell()) {
-    _pressStartTime = millis();
-    _longPressDetected = false;
+  // Con flancos descartados se espera como mucho al final del rebote
+  if (xQueueReceive(_queue, &edge, _input.nextCheck()) != pdTRUE) {
+    if (_input.settle()) _onChange(_input.getLevel(), _input.getLastChange());
+    return;
   }
 
-  if (_debouncer.read() == LOW) {
-    unsigned long elapsed = millis() - _pressStartTime;
-
-    if (elapsed >= LONG_PRESS_DURATION && !_longPressDetected) {
+  if (edge.id == LONG_PRESS) {
+    // El timer puede vencer justo tras soltar o volver a pulsar
+    if (_input.getLevel() == LOW && !_longPressDetected &&
+        micros() - _pressStartTime >= LONG_PRESS_DURATION * 1000UL) {
       _longPressDetected = true;
-      _trigger(Event::LONG_PRESS);
+      _bus.publish(EventId::SYNC_LONG_PRESS);
     }
+    return;
   }
 
-  if (_debouncer.rose()) {
-    unsigned long elapsed = millis() - _pressStartTime;
+  if (_input.accept(edge)) _onChange(edge.level, edge.time);
+}
+
+void SyncButtonManager::_onChange(uint8_t level, uint32_t time) {
+  if (level == LOW) {
+    _pressStartTime = time;
+    _longPressDetected = false;
+    xTimerReset(_longPressTimer, 0);
+  } else {
+    xTimerStop(_longPressTimer, 0);
 
     // Solo ejecutar una accion corta si no se detecto ya una larga
-    if (elapsed < LONG_PRESS_DURATION && !_longPressDetected) {
-      _trigger(Event::SIMPLE_PRESS);
-    }
+    if (!_longPressDetected) _bus.publish(EventId::SYNC_PRESS);
   }
 }
 
-void SyncButtonManager::on(Event event, std::function<void()> callback) {
-  _callbacks[event] = callback;
-}
+void SyncButtonManager::_onLongPressTimer(TimerHandle_t timer) {
+  SyncButtonManager* button =
+      static_cast<SyncButtonManager*>(pvTimerGetTimerID(timer));
+  const DebouncedInput::Edge edge = {LONG_PRESS, LOW,
+                                     static_cast<uint32_t>(micros())};
 
-void SyncButtonManager::_trigger(Event event) {
-  auto it = _callbacks.find(event);
-
-  if (it != _callbacks.end() && it->second) {
-    it->second();
-  }
+  // Se procesa en update() para no publicar desde la tarea de timers
+  xQueueSend(button->_queue, &edge, 0);
 }
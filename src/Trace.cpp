@@ -0,0 +1,288 @@
+#include "Trace.hpp"
+
+#ifdef TRACE_ENABLED
+
+#include <esp_freertos_hooks.h>
+#include <esp_pm.h>
+#include <esp_timer.h>
+
+namespace {
+
+static_assert((Trace::CAPACITY & (Trace::CAPACITY - 1)) == 0,
+              "CAPACITY debe ser potencia de 2");
+
+struct Entry {
+  const char* name;
+  TaskHandle_t task;
+  uint32_t cycles;
+  uint16_t wraps;  // Vueltas del contador desde el anclaje
+  char phase;
+};
+
+// Solo escribe el propio nucleo, con las interrupciones enmascaradas
+struct Ring {
+  Entry entries[Trace::CAPACITY];
+  volatile uint32_t head;
+  uint32_t lastCycles;
+  uint16_t wraps;
+  bool isAnchored;
+  int64_t anchorTime;  // esp_timer_get_time() en el primer evento
+  uint32_t anchorCycles;
+};
+
+Ring rings[portNUM_PROCESSORS] = {};
+volatile uint32_t session = 0;
+volatile uint8_t exports = 0;  // Exportaciones en curso: grabacion en pausa
+portMUX_TYPE exportMux = portMUX_INITIALIZER_UNLOCKED;
+int64_t startTime = 0;  // Activacion de la traza
+uint32_t cpuFrequency = 0;
+
+// Sin CONFIG_PM_ENABLE quedan a NULL y la frecuencia ya es fija
+esp_pm_lock_handle_t frequencyLock = NULL;
+esp_pm_lock_handle_t sleepLock = NULL;
+
+// Los contadores de cada nucleo no estan sincronizados y dan la vuelta cada
+// ~18 s a 240 MHz: se anclan a esp_timer y se cuentan las vueltas
+void extend(Ring& ring, uint32_t cycles) {
+  if (!ring.isAnchored) {
+    ring.anchorTime = esp_timer_get_time();
+    ring.anchorCycles = cycles;
+    ring.lastCycles = cycles;
+    ring.wraps = 0;
+    ring.isAnchored = true;
+    return;
+  }
+
+  if (cycles < ring.lastCycles) ring.wraps++;
+  ring.lastCycles = cycles;
+}
+
+double toMicros(const Ring& ring, const Entry& entry) {
+  const uint64_t cycles =
+      (static_cast<uint64_t>(entry.wraps) << 32 | entry.cycles) -
+      ring.anchorCycles;
+
+  return (ring.anchorTime - startTime) +
+         static_cast<double>(cycles) / cpuFrequency;
+}
+
+}  // namespace
+
+volatile bool Trace::_isEnabled = false;
+
+bool Trace::begin() {
+  if (esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "trace", &frequencyLock) !=
+      ESP_OK)
+    frequencyLock = NULL;
+  if (esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "trace", &sleepLock) !=
+      ESP_OK)
+    sleepLock = NULL;
+
+  // Sin eventos en un nucleo las vueltas del contador se cuentan en idle
+  for (UBaseType_t core = 0; core < portNUM_PROCESSORS; core++) {
+    if (esp_register_freertos_idle_hook_for_cpu(_idleHook, core) != ESP_OK)
+      return false;
+  }
+
+  return true;
+}
+
+bool Trace::setEnabled(bool enabled) {
+  if (enabled == _isEnabled) return true;
+
+  if (!enabled) {
+    _isEnabled = false;
+    if (sleepLock != NULL) esp_pm_lock_release(sleepLock);
+    if (frequencyLock != NULL) esp_pm_lock_release(frequencyLock);
+    return true;
+  }
+
+  // Frecuencia fija y sin light sleep: ciclos -> us con un solo factor
+  if (frequencyLock != NULL) esp_pm_lock_acquire(frequencyLock);
+  if (sleepLock != NULL) esp_pm_lock_acquire(sleepLock);
+  cpuFrequency = getCpuFrequencyMhz();
+  startTime = esp_timer_get_time();
+
+  session++;
+  for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+    rings[core].head = 0;
+    rings[core].isAnchored = false;
+  }
+
+  _isEnabled = true;
+  return true;
+}
+
+void Trace::_record(const char* name, char phase) {
+  if (!_isEnabled || exports > 0) return;
+
+  // Ni expropiacion ni cambio de nucleo mientras se escribe el evento
+  const UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+  Ring& ring = rings[xPortGetCoreID()];
+  const uint32_t cycles = ESP.getCycleCount();
+  extend(ring, cycles);
+
+  Entry& entry = ring.entries[ring.head & (CAPACITY - 1)];
+  entry.name = name;
+  entry.task = xTaskGetCurrentTaskHandle();
+  entry.cycles = cycles;
+  entry.wraps = ring.wraps;
+  entry.phase = phase;
+  ring.head = ring.head + 1;
+
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+}
+
+bool Trace::_idleHook() {
+  if (_isEnabled) {
+    const UBaseType_t state = portSET_INTERRUPT_MASK_FROM_ISR();
+    Ring& ring = rings[xPortGetCoreID()];
+    if (ring.isAnchored) extend(ring, ESP.getCycleCount());
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(state);
+  }
+
+  return true;
+}
+
+Trace::Export::Export() : _session(session), _matched() {
+  // Antes de fijar el final: lo que se escriba despues queda fuera
+  portENTER_CRITICAL(&exportMux);
+  exports = exports + 1;
+  portEXIT_CRITICAL(&exportMux);
+
+  for (uint8_t core = 0; core < portNUM_PROCESSORS; core++) {
+    const uint32_t head = rings[core].head;
+    _end[core] = head;
+    // El hueco mas antiguo es el siguiente en escribirse: se descarta
+    _position[core] = head >= CAPACITY ? head - CAPACITY + 1 : 0;
+
+    // Tareas presentes en la ventana, para nombrar sus filas
+    for (uint32_t i = _position[core]; i < head; i++) {
+      const TaskHandle_t task = rings[core].entries[i & (CAPACITY - 1)].task;
+      bool isKnown = false;
+
+      for (uint8_t j = 0; j < _threadCount && !isKnown; j++)
+        isKnown = _threads[j] == task;
+      if (!isKnown && _threadCount < MAX_THREADS)
+        _threads[_threadCount++] = task;
+    }
+  }
+
+  _match();
+}
+
+Trace::Export::~Export() {
+  portENTER_CRITICAL(&exportMux);
+  exports = exports - 1;
+  portEXIT_CRITICAL(&exportMux);
+}
+
+void Trace::Export::_match() {
+  struct Open {
+    TaskHandle_t task;
+    uint8_t core;
+    uint32_t position;
+  };
+
+  // Cada tarea anida sus tramos: un fin cierra el ultimo inicio abierto de
+  // su tarea. Los nucleos se recorren en orden de tiempo porque una tarea
+  // sin afinidad puede cambiar de nucleo dentro de un tramo
+  Open open[MAX_OPEN];
+  uint8_t openCount = 0;
+  uint32_t cursor[portNUM_PROCESSORS];
+  memcpy(cursor, _position, sizeof(cursor));
+
+  while (1) {
+    int8_t core = -1;
+    double time = 0;
+
+    for (uint8_t i = 0; i < portNUM_PROCESSORS; i++) {
+      if (cursor[i] == _end[i]) continue;
+
+      const Entry& entry = rings[i].entries[cursor[i] & (CAPACITY - 1)];
+      const double entryTime = toMicros(rings[i], entry);
+      if (core < 0 || entryTime < time) {
+        core = i;
+        time = entryTime;
+      }
+    }
+    if (core < 0) break;
+
+    const uint32_t position = cursor[core]++;
+    const Entry& entry = rings[core].entries[position & (CAPACITY - 1)];
+
+    if (entry.phase == 'B') {
+      // Sin sitio se descarta el tramo abierto mas antiguo
+      if (openCount == MAX_OPEN) {
+        memmove(open, open + 1, sizeof(Open) * (MAX_OPEN - 1));
+        openCount--;
+      }
+      open[openCount++] = {entry.task, static_cast<uint8_t>(core), position};
+      continue;
+    }
+
+    // Un fin sin inicio en la ventana se omite
+    for (uint8_t i = openCount; i > 0; i--) {
+      const Open& begin = open[i - 1];
+      if (begin.task != entry.task) continue;
+
+      const uint32_t slot = begin.position & (CAPACITY - 1);
+      _matched[begin.core][slot / 32] |= 1UL << (slot % 32);
+      const uint32_t end = position & (CAPACITY - 1);
+      _matched[core][end / 32] |= 1UL << (end % 32);
+
+      memmove(open + i - 1, open + i, sizeof(Open) * (openCount - i));
+      openCount--;
+      break;
+    }
+  }
+}
+
+bool Trace::Export::_isMatched(uint8_t core, uint32_t position) const {
+  const uint32_t slot = position & (CAPACITY - 1);
+  return (_matched[core][slot / 32] & (1UL << (slot % 32))) != 0;
+}
+
+bool Trace::Export::next(Event& event) {
+  if (_session != session) return false;
+
+  // Primero los nombres: las tareas trazadas son persistentes, asi que el
+  // handle sigue siendo valido
+  if (_nextThread < _threadCount) {
+    const TaskHandle_t task = _threads[_nextThread++];
+    event.name = pcTaskGetName(task);
+    event.phase = 'M';
+    event.core = 0;
+    event.tid = reinterpret_cast<uintptr_t>(task);
+    event.time = 0;
+    return true;
+  }
+
+  while (_core < portNUM_PROCESSORS) {
+    const Ring& ring = rings[_core];
+
+    while (_position[_core] < _end[_core]) {
+      const uint32_t position = _position[_core]++;
+      const Entry entry = ring.entries[position & (CAPACITY - 1)];
+
+      // El nucleo ha seguido escribiendo y ha pisado este hueco
+      if (ring.head - position >= CAPACITY) continue;
+      // Inicio sin fin (cortado por la pausa o por setEnabled(false)) o fin
+      // sin inicio: los visores lo dibujarian hasta el final de la traza
+      if (!_isMatched(_core, position)) continue;
+
+      event.name = entry.name;
+      event.phase = entry.phase;
+      event.core = _core;
+      event.tid = reinterpret_cast<uintptr_t>(entry.task);
+      event.time = toMicros(ring, entry);
+      return true;
+    }
+
+    _core++;
+  }
+
+  return false;
+}
+
+#endif
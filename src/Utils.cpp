@@ -1,5 +1,7 @@
 #include "Utils.hpp"
 
+#include <esp32/rom/crc.h>
+
 void sanitizeInput(String& input, size_t maxLength) {
   input.replace("\\", "");
   input.replace("\"", "");
@@ -12,17 +14,46 @@ bool isNetworkSecure(wifi_auth_mode_t encryptionType) {
   return encryptionType != WIFI_AUTH_OPEN;
 }
 
-String formatBooleanToText(const bool data) {
+const char* formatBooleanToText(const bool data) {
   if (data) return "Si";
   return "No";
 }
 
-String macToString(const uint8_t* mac) {
-  char buffer[18];
-  snprintf(buffer, sizeof(buffer), "%02X:%02X:%02X:%02X:%02X:%02X", mac[0],
-           mac[1], mac[2], mac[3], mac[4], mac[5]);
+size_t formatMac(char* dest, size_t size, const uint8_t* mac) {
+  return snprintf(dest, size, "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1],
+                  mac[2], mac[3], mac[4], mac[5]);
+}
 
-  return String(buffer);
+size_t formatFirmwareVersion(char* dest, size_t size,
+                             const uint8_t* firmwareVersion) {
+  return snprintf(dest, size, "%u.%u.%u", firmwareVersion[0],
+                  firmwareVersion[1], firmwareVersion[2]);
+}
+
+size_t formatFixed(char* dest, size_t size, float value, uint8_t decimals) {
+  static const uint32_t POWERS[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+  static const uint8_t MAX_DECIMALS = 6;
+  static const double MAX_SCALED = 1e18;  // Cabe en uint64_t
+
+  if (isnan(value)) return snprintf(dest, size, "nan");
+  if (decimals > MAX_DECIMALS) decimals = MAX_DECIMALS;
+
+  const uint32_t scale = POWERS[decimals];
+  const bool negative = value < 0;
+  const double magnitude = fabs(static_cast<double>(value)) * scale;
+
+  if (magnitude >= MAX_SCALED)
+    return snprintf(dest, size, negative ? "-inf" : "inf");
+
+  // Redondeo a la escala pedida trabajando con enteros de 64 bits
+  const uint64_t scaled = static_cast<uint64_t>(magnitude + 0.5);
+  const unsigned long long whole = scaled / scale;
+  const unsigned long fraction = scaled % scale;
+  const char* sign = negative && scaled > 0 ? "-" : "";
+
+  if (decimals == 0) return snprintf(dest, size, "%s%llu", sign, whole);
+
+  return snprintf(dest, size, "%s%llu.%0*lu", sign, whole, decimals, fraction);
 }
 
 void stringToMac(const String& macStr, uint8_t* macDest) {
@@ -32,14 +63,6 @@ void stringToMac(const String& macStr, uint8_t* macDest) {
          &macDest[1], &macDest[2], &macDest[3], &macDest[4], &macDest[5]);
 }
 
-String firmwareVersionToString(const uint8_t* firmwareVersion) {
-  char firmwareVersionStr[6];
-  snprintf(firmwareVersionStr, sizeof(firmwareVersionStr), "%d.%d.%d",
-           firmwareVersion[0], firmwareVersion[1], firmwareVersion[2]);
-
-  return String(firmwareVersionStr);
-}
-
 bool stringToFirmwareVersion(const String& firmwareVersionStr,
                              uint8_t* firmwareVersionDest) {
   // Validar formato basico y caracteres
@@ -81,3 +104,8 @@ uint8_t calcCRC8(const uint8_t* data, size_t length) {
 
   return crc.calc();
 }
+
+uint32_t calcCRC32(const uint8_t* data, size_t length, uint32_t crc) {
+  // CRC32 estandar (IEEE 802.3), encadenable pasando el resultado anterior
+  return crc32_le(crc, data, length);
+}
@@ -1,44 +1,321 @@
 #include "WebServerManager.hpp"
 
 #include <LittleFS.h>
+#include <Update.h>
 #include <freertos/FreeRTOS.h>
 
+#include <algorithm>
+#include <memory>
+
+#include "Logger.hpp"
+#include "Trace.hpp"
 #include "Utils.hpp"
 
-WebServerManager::WebServerManager(ConfigManager& config, WiFiManager& wifi)
-    : _config(config), _wifi(wifi) {}
+#ifdef EMBED_WEB_ASSETS
+#include <WebAssetData.hpp>
+#endif
 
-String WebServerManager::begin() {
-  const ConfigManager::NetworkConfig apConfig = _config.getAPConfig();
-  const String ip = _wifi.startAP(apConfig.ssid, apConfig.password);
+namespace {
+
+// Print sobre un buffer fijo; lo que no cabe se descarta
+class BufferPrint : public Print {
+ public:
+  BufferPrint(char* buffer, size_t capacity)
+      : _buffer(buffer), _capacity(capacity) {}
+
+  size_t write(uint8_t c) override {
+    if (_length >= _capacity) return 0;
+
+    _buffer[_length++] = c;
+    return 1;
+  }
+
+  size_t length() const { return _length; }
+
+ private:
+  char* _buffer;
+  size_t _capacity;
+  size_t _length = 0;
+};
+
+// Estado de una respuesta JSON en streaming: un solo registro en memoria
+struct JsonArrayStream {
+  WebServerManager::RecordWriter writer;
+  JsonPool<WebServerManager::API_RECORD_POOL_SIZE> pool;
+  char record[WebServerManager::API_RECORD_SIZE + 1];  // + ','
+  size_t length = 0;
+  size_t offset = 0;
+  size_t next = 0;
+  bool isOpen = false;
+  bool isClosed = false;
+
+  // Prepara el siguiente fragmento; false al terminar el array
+  bool fill() {
+    offset = 0;
+
+    if (!isOpen) {
+      isOpen = true;
+      record[0] = '[';
+      length = 1;
+      return true;
+    }
+
+    if (isClosed) return false;
+
+    pool.reset();
+    JsonDocument doc(&pool);
+
+    if (!writer(next, doc.to<JsonObject>())) {
+      isClosed = true;
+      record[0] = ']';
+      length = 1;
+      return true;
+    }
+
+    BufferPrint output(record, sizeof(record));
+    if (next > 0) output.write(',');
+    serializeJson(doc, output);
+    length = output.length();
+    next++;
+    return true;
+  }
+};
+
+// Prefijos de la API: una ruta desconocida es un 404, no la SPA
+const char* const API_PREFIXES[] = {"/api/", "/config/", "/debug/"};
+
+bool isApiUrl(const char* url) {
+  for (const char* prefix : API_PREFIXES) {
+    if (strncmp(url, prefix, strlen(prefix)) == 0) return true;
+  }
+
+  return false;
+}
+
+// "/api/nodes/AA:BB:CC:DD:EE:FF/<accion>": MAC del nodo y accion
+bool parseNodeUrl(const String& url, uint8_t* mac, String& action) {
+  static const char PREFIX[] = "/api/nodes/";
+  const size_t prefixLength = sizeof(PREFIX) - 1;
+  const size_t macEnd = prefixLength + MAC_TEXT_SIZE - 1;
+
+  if (!url.startsWith(PREFIX) || url.length() <= macEnd + 1 ||
+      url[macEnd] != '/')
+    return false;
+
+  unsigned int octets[6];
+  char separators[5];
+  if (sscanf(url.c_str() + prefixLength, "%2x%c%2x%c%2x%c%2x%c%2x%c%2x",
+             &octets[0], &separators[0], &octets[1], &separators[1],
+             &octets[2], &separators[2], &octets[3], &separators[3],
+             &octets[4], &separators[4], &octets[5]) != 11)
+    return false;
+
+  for (uint8_t i = 0; i < 5; i++) {
+    if (separators[i] != ':') return false;
+  }
+  for (uint8_t i = 0; i < 6; i++) mac[i] = octets[i];
 
+  action = url.substring(macEnd + 1);
+  return true;
+}
+
+}  // namespace
+
+WebServerManager::WebServerManager(ConfigManager& config, WiFiManager& wifi,
+                                   NowManager& now, NodeOtaManager& nodeOta,
+                                   PowerManager& power, EventBus& bus)
+    : _config(config),
+      _wifi(wifi),
+      _now(now),
+      _nodeOta(nodeOta),
+      _power(power),
+      _bus(bus) {}
+
+void WebServerManager::begin() {
+  if (_wsMutex == NULL) _wsMutex = _wsMutexStorage.create();
+
+  if (_pushTaskHandler == NULL)
+    _pushTaskStorage.create(_pushTask, "WS Push", this, 1, &_pushTaskHandler,
+                            1);
+
+  _rateWindowStart = millis();
   _server.begin();
-  _isListening = true;
+}
+
+String WebServerManager::openPortal() {
+  const ConfigManager::NetworkConfig apConfig = _config.getAPConfig();
+  const String ip = _wifi.startAP(apConfig.ssid, apConfig.password);
 
+  _isPortalOpen = true;
   return ip;
 }
 
-void WebServerManager::end() {
+void WebServerManager::notifyDataChanged() {
+  if (_pushTaskHandler != NULL && _ws.count() > 0)
+    xTaskNotifyGive(_pushTaskHandler);
+}
+
+void WebServerManager::closePortal() {
+  _isPortalOpen = false;
   _wifi.closeAP();
+}
+
+void WebServerManager::_handleUpdateUpload(AsyncWebServerRequest* request,
+                                           size_t index, uint8_t* data,
+                                           size_t len, bool final) {
+  if (index == 0) {
+    // Una subida anterior interrumpida deja la escritura a medias
+    if (Update.isRunning()) Update.abort();
+
+    _updateStats = UpdateStats();
+    _updateStats.startTime = millis();
+    _updateStats.startFreeHeap = ESP.getFreeHeap();
+    _updateStats.minFreeHeap = _updateStats.startFreeHeap;
+    _updateProgress = 0;
+
+    // El tamano del fichero solo se conoce si el campo "size" lo precede;
+    // si no, el cuerpo completo es una cota superior
+    if (request->hasParam("size", true))
+      _updateStats.total = request->getParam("size", true)->value().toInt();
+    if (_updateStats.total == 0)
+      _updateStats.total = std::max<size_t>(request->contentLength(), 1);
+
+    // Tamano desconocido: se usa toda la particion inactiva
+    if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {
+      Update.printError(Serial);
+      return;
+    }
+
+    // Inicio y fin no se pueden perder: la pantalla y el teclado quedarian
+    // bloqueados en "Actualizando"
+    _bus.publish(EventId::UPDATE_START, 0, portMAX_DELAY);
+  }
+
+  if (!Update.isRunning()) return;
+
+  // Cada fragmento se escribe en flash tal cual llega, sin acumularlo
+  if (Update.write(data, len) != len) {
+    Update.printError(Serial);
+    Update.abort();
+    _bus.publish(EventId::UPDATE_END, false, portMAX_DELAY);
+    return;
+  }
+
+  _updateStats.written += len;
+  _updateStats.minFreeHeap =
+      std::min<uint32_t>(_updateStats.minFreeHeap, ESP.getFreeHeap());
+
+  // Con el fichero completo el progreso es 100% aunque total fuera una cota
+  const uint8_t progress =
+      final ? 100
+            : std::min<uint32_t>(
+                  _updateStats.written * 100 / _updateStats.total, 99);
 
-  _server.end();
-  _isListening = false;
+  if (progress != _updateProgress) {
+    _updateProgress = progress;
+    _bus.publishLatest(EventId::UPDATE_PROGRESS, progress);
+  }
+}
+
+bool WebServerManager::_finishUpdate(AsyncWebServerRequest* request) {
+  if (!Update.isRunning()) return false;
+
+  // Aqui ya se han leido todos los campos, antes o despues del fichero
+  if (request->hasParam("md5", true))
+    Update.setMD5(request->getParam("md5", true)->value().c_str());
+
+  // Valida la imagen y cambia la particion de arranque solo si es correcta
+  _updateStats.success = Update.end(true);
+  _updateStats.elapsed = millis() - _updateStats.startTime;
+
+  if (!_updateStats.success) Update.printError(Serial);
+
+  LOG_INFO(
+      "Actualizacion %s: %u bytes en %lu ms (%.2f KB/s), heap maximo usado "
+      "%lu bytes",
+      _updateStats.success ? "OK" : "fallida", _updateStats.written,
+      _updateStats.elapsed,
+      _updateStats.elapsed > 0
+          ? (_updateStats.written / 1024.0) / (_updateStats.elapsed / 1000.0)
+          : 0,
+      _updateStats.startFreeHeap - _updateStats.minFreeHeap);
+
+  _bus.publish(EventId::UPDATE_END, _updateStats.success, portMAX_DELAY);
+  return _updateStats.success;
+}
+
+void WebServerManager::_receiveBody(AsyncWebServerRequest* request,
+                                    uint8_t* data, size_t len, size_t index,
+                                    size_t total, size_t maxSize) {
+  // Un cuerpo demasiado grande se rechaza sin reservar memoria
+  if (total > maxSize) return;
+
+  if (index == 0) request->_tempObject = malloc(total);
+  if (request->_tempObject == nullptr) return;
+
+  memcpy((uint8_t*)request->_tempObject + index, data, len);
+}
+
+void WebServerManager::_releaseBody(AsyncWebServerRequest* request) {
+  free(request->_tempObject);
+  request->_tempObject = nullptr;
+}
+
+bool WebServerManager::_checkPortal(AsyncWebServerRequest* request) {
+  if (_isPortalOpen) return true;
+
+  request->send(403, "text/plain", "Solo en modo configuracion");
+  return false;
+}
+
+void WebServerManager::_countRequest() {
+  // Las peticiones se atienden en serie: no hace falta bloqueo
+  const uint32_t now = millis();
+  _apiRequests++;
+  _rateWindowRequests++;
+
+  if (now - _rateWindowStart >= REQUEST_RATE_WINDOW) {
+    _requestRate = _rateWindowRequests * 1000.0f / (now - _rateWindowStart);
+    _rateWindowStart = now;
+    _rateWindowRequests = 0;
+  }
 }
 
 void WebServerManager::setupRoutes() {
-  // Scan Networks
+  // Las rutas de configuracion responden 403 con el portal cerrado
+
+  // Scan Networks (cache; el escaneo corre en segundo plano). Siempre JSON:
+  // 202 con lista vacia y Retry-After mientras no hay resultado
   _server.on("/scan", HTTP_GET, [this](AsyncWebServerRequest* request) {
-    _wifi.scanNetworks();
-    const auto& results = _wifi.getScanResults();
+    if (!_checkPortal(request)) return;
+
+    switch (_wifi.requestScan()) {
+      case WiFiManager::ScanState::SCANNING: {
+        AsyncWebServerResponse* response =
+            request->beginResponse(202, "application/json", "[]");
+        response->addHeader("Retry-After", "1");
+        request->send(response);
+        return;
+      }
+      case WiFiManager::ScanState::FAILED:
+        request->send(500, "application/json", "[]");
+        return;
+      case WiFiManager::ScanState::READY:
+        break;
+    }
+
+    WiFiManager::ScanResult results[WiFiManager::MAX_SCAN_RESULTS];
+    const uint8_t count =
+        _wifi.getScanResults(results, WiFiManager::MAX_SCAN_RESULTS);
 
     JsonDocument doc;
     JsonArray networks = doc.to<JsonArray>();
 
-    for (const auto& result : results) {
+    for (uint8_t i = 0; i < count; i++) {
       JsonObject network = networks.add<JsonObject>();
-      network["ssid"] = result.ssid;
-      network["rssi"] = result.rssi;
-      network["secure"] = result.secure;
+      network["ssid"] = results[i].ssid;
+      network["rssi"] = results[i].rssi;
+      network["secure"] = results[i].secure;
     }
 
     String response;
@@ -50,20 +327,34 @@ void WebServerManager::setupRoutes() {
   _server.on(
       "/setup/wifi", HTTP_POST,
       [this](AsyncWebServerRequest* request) {
+        if (!_checkPortal(request)) return;
+
+        if (request->contentLength() > MAX_WIFI_BODY_SIZE) {
+          request->send(413, "text/plain", "Cuerpo demasiado grande");
+          return;
+        }
+
         // Verificar si hay datos en _tempObject
         if (request->_tempObject == nullptr) {
           request->send(400, "text/plain", "Cuerpo vacío");
           return;
         }
 
-        String* body = (String*)request->_tempObject;
+        // Solo se conservan los campos necesarios, en memoria acotada
+        _jsonPool.reset();
+        JsonDocument filter(&_jsonPool);
+        filter["ssid"] = true;
+        filter["password"] = true;
 
-        JsonDocument doc;
-        DeserializationError error = deserializeJson(doc, *body);
+        JsonDocument doc(&_jsonPool);
+        DeserializationError error = deserializeJson(
+            doc, (const char*)request->_tempObject, request->contentLength(),
+            DeserializationOption::Filter(filter));
+
+        _releaseBody(request);
 
         if (error) {
           request->send(400, "text/plain", "Error en el formato JSON");
-          delete body;
           return;
         }
 
@@ -77,26 +368,26 @@ void WebServerManager::setupRoutes() {
         // Validación básica
         if (ssid.isEmpty()) {
           request->send(400, "text/plain", "SSID inválido");
-          delete body;
           return;
         }
 
         _partialConfig = {ssid, password};
 
         request->send(200, "text/plain", "Configuración recibida");
-        delete body;
-        request->_tempObject = nullptr;
       },
       nullptr,
       [](AsyncWebServerRequest* request, uint8_t* data, size_t len,
          size_t index, size_t total) {
-        if (index == 0) request->_tempObject = new String();
-        ((String*)request->_tempObject)->concat((const char*)data, len);
+        _receiveBody(request, data, len, index, total, MAX_WIFI_BODY_SIZE);
       });
 
   // Confirm settings
   _server.on("/setup", HTTP_POST, [this](AsyncWebServerRequest* request) {
-    if (!_config.saveSTAConfig(_partialConfig.ssid, _partialConfig.password)) {
+    if (!_checkPortal(request)) return;
+
+    // Persistir ya: el reinicio no puede esperar a la escritura diferida
+    if (!_config.saveSTAConfig(_partialConfig.ssid, _partialConfig.password) ||
+        !_config.flush()) {
       request->send(500, "text/plain", "Error de servidor");
       return;
     }
@@ -109,7 +400,10 @@ void WebServerManager::setupRoutes() {
   });
 
   _server.on("/close", HTTP_POST, [this](AsyncWebServerRequest* request) {
+    if (!_checkPortal(request)) return;
+
     _server.end();
+    _config.flush();
 
     request->send(200, "text/plain", "Sistema reiniciado");
 
@@ -118,17 +412,973 @@ void WebServerManager::setupRoutes() {
     ESP.restart();
   });
 
-  // Static Files
-  _server.serveStatic("/", LittleFS, "/www/").setDefaultFile("index.html");
-  // .setCacheControl("max-age=3600");
+  // Master firmware update (streamed to the inactive OTA partition).
+  // Optional fields: "size" (file bytes, before the file) and "md5"
+  _server.on(
+      "/update", HTTP_POST,
+      [this](AsyncWebServerRequest* request) {
+        if (!_checkPortal(request)) return;
+
+        if (!_finishUpdate(request)) {
+          request->send(500, "text/plain", Update.errorString());
+          return;
+        }
+
+        request->send(200, "text/plain", "Actualizacion completada");
+        _config.flush();
+
+        // Delay - 1000ms
+        vTaskDelay(pdMS_TO_TICKS(1000));
+        ESP.restart();
+      },
+      [this](AsyncWebServerRequest* request, const String& filename,
+             size_t index, uint8_t* data, size_t len, bool final) {
+        if (!_isPortalOpen) return;
+
+        _handleUpdateUpload(request, index, data, len, final);
+      });
+
+  // Upload node firmware image (streamed to flash)
+  _server.on(
+      "/ota/node", HTTP_POST,
+      [this](AsyncWebServerRequest* request) {
+        if (!_checkPortal(request)) return;
+
+        // Resultado de esta subida, no de una imagen anterior
+        const bool isOk = _nodeUploadRequest == request && _isNodeUploadOk;
+        _nodeUploadRequest = nullptr;
+
+        if (!isOk) {
+          request->send(500, "text/plain", "Error guardando la imagen");
+          return;
+        }
+
+        request->send(200, "text/plain", "Imagen recibida");
+      },
+      [this](AsyncWebServerRequest* request, const String& filename,
+             size_t index, uint8_t* data, size_t len, bool final) {
+        if (!_isPortalOpen) return;
+
+        if (index == 0) {
+          _nodeUploadRequest = request;
+          _isNodeUploadOk = _nodeOta.beginUpload();
+        }
+        if (_nodeUploadRequest != request || !_isNodeUploadOk) return;
+
+        _isNodeUploadOk = _nodeOta.writeUpload(data, len);
+        if (final && _isNodeUploadOk) _isNodeUploadOk = _nodeOta.endUpload();
+      });
+
+  // Start node firmware distribution
+  _server.on("/ota/node/start", HTTP_POST,
+             [this](AsyncWebServerRequest* request) {
+               if (!_checkPortal(request)) return;
+
+               if (!request->hasParam("type", true) ||
+                   !request->hasParam("version", true)) {
+                 request->send(400, "text/plain", "Parametros invalidos");
+                 return;
+               }
+
+               const uint8_t nodeType =
+                   request->getParam("type", true)->value().toInt();
+               uint8_t firmwareVersion[3];
+
+               if (!stringToFirmwareVersion(
+                       request->getParam("version", true)->value(),
+                       firmwareVersion)) {
+                 request->send(400, "text/plain", "Version invalida");
+                 return;
+               }
+
+               if (!_nodeOta.start(nodeType, firmwareVersion)) {
+                 request->send(409, "text/plain",
+                               "No se pudo iniciar la actualizacion");
+                 return;
+               }
+
+               request->send(202, "text/plain", "Actualizacion iniciada");
+             });
+
+  // Node firmware distribution status
+  _server.on("/ota/node/status", HTTP_GET,
+             [this](AsyncWebServerRequest* request) {
+               if (!_checkPortal(request)) return;
+
+               JsonDocument doc;
+               doc["running"] = _nodeOta.isRunning();
+               doc["image_size"] = _nodeOta.getImageSize();
+               JsonArray targets = doc["targets"].to<JsonArray>();
+
+               for (uint8_t i = 0; i < _nodeOta.getTargetCount(); i++) {
+                 const NodeOtaManager::TargetStats target =
+                     _nodeOta.getTargetAt(i);
+                 JsonObject node = targets.add<JsonObject>();
+                 node["mac"] = MacText(target.mac).c_str();
+                 node["result"] = static_cast<uint8_t>(target.result);
+                 node["elapsed_ms"] = target.elapsed;
+                 node["chunks_sent"] = target.chunksSent;
+                 node["retransmits"] = target.retransmits;
+                 node["kbps"] = target.elapsed > 0
+                                    ? (_nodeOta.getImageSize() / 1024.0) /
+                                          (target.elapsed / 1000.0)
+                                    : 0;
+               }
+
+               String response;
+               serializeJson(doc, response);
+               request->send(200, "application/json", response);
+             });
+
+  // Export config as JSON; passwords only with ?secrets=1
+  _server.on("/config/export", HTTP_GET,
+             [this](AsyncWebServerRequest* request) {
+               if (!_checkPortal(request)) return;
+
+               const bool includeSecrets =
+                   request->hasParam("secrets") &&
+                   request->getParam("secrets")->value() == "1";
+               AsyncResponseStream* response =
+                   request->beginResponseStream("application/json");
+
+               if (!_config.exportJson(*response, includeSecrets)) {
+                 delete response;
+                 request->send(500, "text/plain", "Error de servidor");
+                 return;
+               }
+
+               request->send(response);
+             });
+
+  // Import config from JSON
+  _server.on(
+      "/config/import", HTTP_POST,
+      [this](AsyncWebServerRequest* request) {
+        if (!_checkPortal(request)) return;
+
+        if (request->contentLength() > ConfigManager::MAX_JSON_SIZE) {
+          request->send(413, "text/plain", "Cuerpo demasiado grande");
+          return;
+        }
+
+        if (request->_tempObject == nullptr) {
+          request->send(400, "text/plain", "Cuerpo vacío");
+          return;
+        }
+
+        const bool isImported = _config.importJson(
+            (const char*)request->_tempObject, request->contentLength());
+        _releaseBody(request);
+
+        if (!isImported) {
+          request->send(400, "text/plain", "Configuración no valida");
+          return;
+        }
+
+        // Redes y nodos se aplican al arrancar: persistir y reiniciar
+        if (!_config.flush()) {
+          request->send(500, "text/plain", "Error de servidor");
+          return;
+        }
+
+        request->send(200, "text/plain",
+                      "Configuración importada, reiniciando");
+
+        // Delay - 1000ms
+        vTaskDelay(pdMS_TO_TICKS(1000));
+        ESP.restart();
+      },
+      nullptr,
+      [](AsyncWebServerRequest* request, uint8_t* data, size_t len,
+         size_t index, size_t total) {
+        _receiveBody(request, data, len, index, total,
+                     ConfigManager::MAX_JSON_SIZE);
+      });
+
+  _setupApiRoutes();
+
+  // Static Files (gzip precomprimido, ver scripts/build_assets.py)
+#ifndef EMBED_WEB_ASSETS
+  _loadAssetManifest();
+#endif
+  _server.on("/*", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    _handleAsset(request);
+  });
 
   // 404
-  _server.onNotFound([](AsyncWebServerRequest* request) {
-    // Si la URL no es un archivo estático, servir index.html
-    if (!LittleFS.exists("/www" + request->url())) {
-      request->send(LittleFS, "/www/index.html", "text/html");
-    } else {
-      request->send(404);
+  _server.onNotFound(
+      [](AsyncWebServerRequest* request) { request->send(404); });
+}
+
+void WebServerManager::_setupApiRoutes() {
+  // Live updates (binary deltas, see PushHeader)
+  _ws.onEvent([this](AsyncWebSocket* server, AsyncWebSocketClient* client,
+                     AwsEventType type, void* arg, uint8_t* data,
+                     size_t len) { _onWsEvent(client, type); });
+  _server.addHandler(&_ws);
+
+  // WebSocket clients and their queue depth
+  _server.on("/api/ws", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    _jsonPool.reset();
+    JsonDocument doc(&_jsonPool);
+    doc["dropped"] = _droppedClients;
+    JsonArray clients = doc["clients"].to<JsonArray>();
+
+    xSemaphoreTake(_wsMutex, portMAX_DELAY);
+    for (uint8_t i = 0; i < MAX_WS_CLIENTS; i++) {
+      AsyncWebSocketClient* client =
+          _wsClientIds[i] != 0 ? _ws.client(_wsClientIds[i]) : nullptr;
+      if (client == nullptr) continue;
+
+      JsonObject entry = clients.add<JsonObject>();
+      entry["id"] = client->id();
+      entry["queue"] = client->queueLen();
+    }
+    xSemaphoreGive(_wsMutex);
+
+    AsyncResponseStream* response =
+        request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+  });
+
+  // Power profile and instrumentation
+  _server.on("/api/power", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    _jsonPool.reset();
+    JsonDocument doc(&_jsonPool);
+    const uint64_t uptime = _power.getUptime();
+    doc["profile"] = PowerManager::profileToText(_power.getProfile());
+    doc["dfs"] = _power.isDynamic();
+    doc["light_sleep"] = _power.isLightSleepEnabled();
+    doc["cpu_mhz"] = getCpuFrequencyMhz();
+    doc["uptime_ms"] = uptime / 1000;
+
+    JsonObject locks = doc["locks"].to<JsonObject>();
+    for (uint8_t i = 0; i < PowerManager::LOCK_COUNT; i++) {
+      const PowerManager::Lock id = static_cast<PowerManager::Lock>(i);
+      const PowerManager::LockStats stats = _power.getLockStats(id);
+      JsonObject lock = locks[PowerManager::lockToText(id)].to<JsonObject>();
+      lock["acquisitions"] = stats.acquisitions;
+      lock["held_ms"] = stats.heldTime / 1000;
+    }
+
+    const PowerManager::RadioStats radio = _power.getRadioStats();
+    JsonObject rx = doc["radio_rx"].to<JsonObject>();
+    rx["frames"] = radio.rx.count;
+    rx["avg_us"] =
+        radio.rx.count > 0 ? radio.rx.totalLatency / radio.rx.count : 0;
+    rx["max_us"] = radio.rx.maxLatency;
+    rx["budget_us"] = PowerManager::RADIO_LATENCY_BUDGET;
+    rx["over_budget"] = radio.rx.overBudget;
+
+    JsonObject tx = doc["radio_tx"].to<JsonObject>();
+    tx["sent"] = radio.sent;
+    tx["delivered"] = radio.tx.count;
+    tx["avg_us"] =
+        radio.tx.count > 0 ? radio.tx.totalLatency / radio.tx.count : 0;
+    tx["max_us"] = radio.tx.maxLatency;
+    tx["budget_us"] = PowerManager::RADIO_LATENCY_BUDGET;
+    tx["over_budget"] = radio.tx.overBudget;
+
+    AsyncResponseStream* response =
+        request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+  });
+
+  // Event bus statistics
+  _server.on("/api/events", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    _jsonPool.reset();
+    JsonDocument doc(&_jsonPool);
+
+    JsonObject events = doc["events"].to<JsonObject>();
+    for (uint8_t i = 0; i < EventBus::EVENT_COUNT; i++) {
+      const EventId id = static_cast<EventId>(i);
+      const EventBus::EventStats stats = _bus.getEventStats(id);
+      if (stats.published == 0) continue;
+
+      JsonObject event = events[EventBus::eventToText(id)].to<JsonObject>();
+      event["published"] = stats.published;
+      event["dropped"] = stats.dropped;
+      event["coalesced"] = stats.coalesced;
+      event["avg_us"] = stats.dispatched > 0
+                            ? stats.totalLatency / stats.dispatched
+                            : 0;
+      event["max_us"] = stats.maxLatency;
+    }
+
+    JsonObject queues = doc["queues"].to<JsonObject>();
+    for (uint8_t i = 1; i < EventBus::CONTEXT_COUNT; i++) {
+      const EventContext context = static_cast<EventContext>(i);
+      const EventBus::QueueStats stats = _bus.getQueueStats(context);
+      JsonObject queue =
+          queues[EventBus::contextToText(context)].to<JsonObject>();
+      queue["depth"] = stats.depth;
+      queue["max_depth"] = stats.maxDepth;
+      queue["capacity"] = EventBus::QUEUE_LENGTH;
+    }
+
+    AsyncResponseStream* response =
+        request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+  });
+
+  // Heap state: free memory and fragmentation
+  _server.on("/api/heap", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    _jsonPool.reset();
+    JsonDocument doc(&_jsonPool);
+    const HeapGuard::Stats stats = HeapGuard::getStats();
+    doc["free"] = stats.freeHeap;
+    doc["min_free"] = stats.minFreeHeap;
+    doc["largest_block"] = stats.largestBlock;
+    doc["guard_armed"] = stats.isArmed;
+    doc["uptime_ms"] = millis();
+
+    // Reservas por tarea vigilada (con STATIC_ALLOCATION)
+    JsonObject tasks = doc["allocations"].to<JsonObject>();
+    for (uint8_t i = 0; i < HeapGuard::getTaskCount(); i++) {
+      const HeapGuard::TaskStats task = HeapGuard::getTaskStats(i);
+      tasks[task.name] = task.allocations;
     }
+
+    AsyncResponseStream* response =
+        request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+  });
+
+  // API request rate (see scripts/api_load.py)
+  _server.on("/api/http", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    _jsonPool.reset();
+    JsonDocument doc(&_jsonPool);
+    doc["requests"] = _apiRequests;
+    doc["rate"] = _requestRate;
+    doc["window_ms"] = REQUEST_RATE_WINDOW;
+    doc["portal"] = _isPortalOpen;
+
+    AsyncResponseStream* response =
+        request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+  });
+
+  // Station link state and reconnect timing
+  _server.on("/api/wifi", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    _jsonPool.reset();
+    JsonDocument doc(&_jsonPool);
+    doc["state"] = WiFiManager::staStateToText(_wifi.getStaState());
+    doc["reconnects"] = _wifi.getReconnectCount();
+    doc["last_reconnect_ms"] = _wifi.getLastReconnectTime();
+
+    AsyncResponseStream* response =
+        request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+  });
+
+  _server.on("/api/log", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    _jsonPool.reset();
+    JsonDocument doc(&_jsonPool);
+    const Logger::Stats stats = Logger::getStats();
+    doc["level"] = LOG_LEVEL;
+    doc["written"] = stats.written;
+    doc["dropped"] = stats.dropped;
+
+    AsyncResponseStream* response =
+        request->beginResponseStream("application/json");
+    serializeJson(doc, *response);
+    request->send(response);
+  });
+
+  // Profile change: {"profile": 0}
+  _server.on(
+      "/api/power", HTTP_POST,
+      [this](AsyncWebServerRequest* request) {
+        TRACE_SCOPE("http_power");
+        if (request->contentLength() > MAX_API_BODY_SIZE) {
+          request->send(413, "text/plain", "Cuerpo demasiado grande");
+          return;
+        }
+
+        if (request->_tempObject == nullptr) {
+          request->send(400, "text/plain", "Cuerpo vacío");
+          return;
+        }
+
+        _jsonPool.reset();
+        JsonDocument doc(&_jsonPool);
+        DeserializationError error =
+            deserializeJson(doc, (const char*)request->_tempObject,
+                            request->contentLength());
+
+        _releaseBody(request);
+
+        if (error || !doc["profile"].is<uint8_t>()) {
+          request->send(400, "text/plain", "Error en el formato JSON");
+          return;
+        }
+
+        const uint8_t profile = doc["profile"].as<uint8_t>();
+        if (!_power.setProfile(static_cast<PowerManager::Profile>(profile))) {
+          request->send(400, "text/plain", "Perfil no valido");
+          return;
+        }
+
+        _config.savePowerProfile(profile);
+        request->send(200, "text/plain", "OK");
+      },
+      nullptr,
+      [](AsyncWebServerRequest* request, uint8_t* data, size_t len,
+         size_t index, size_t total) {
+        _receiveBody(request, data, len, index, total, MAX_API_BODY_SIZE);
+      });
+
+  // Paired devices
+  _server.on("/api/devices", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    _countRequest();
+    _sendJsonArray(request, [this](size_t index, JsonObject record) {
+      // Copia: la tarea de recepcion modifica las tablas mientras tanto
+      NowManager::DeviceInfo device;
+      if (!_now.copyDeviceAt(index, device)) return false;
+
+      record["mac"] = MacText(device.mac).c_str();
+      record["name"] = device.deviceName;
+      record["node_type"] = device.nodeType;
+      record["node_id"] = device.nodeId;
+      record["firmware_version"] = VersionText(device.firmwareVersion).c_str();
+      record["last_seen_ms"] = millis() - device.lastSeen;
+      record["report_interval"] = device.reportInterval;
+      record["report_threshold"] = device.reportThreshold;
+      record["relay"] = device.isRelay;
+      record["hops"] = device.hops;
+      record["duplicate_drops"] = device.filter.duplicateDrops;
+      record["rate_limit_drops"] = device.filter.rateLimitDrops;
+      return true;
+    });
+  });
+
+  // Sensor readings
+  _server.on("/api/sensors", HTTP_GET, [this](AsyncWebServerRequest* request) {
+    _countRequest();
+    _sendJsonArray(request, [this](size_t index, JsonObject record) {
+      NowManager::SensorData sensor;
+      if (!_now.copySensorAt(index, sensor)) return false;
+
+      record["mac"] = MacText(sensor.mac).c_str();
+      record["name"] = sensor.deviceName;
+      record["connected"] = sensor.isConnected;
+      record["variable"] = sensor.variable;
+      record["units"] = sensor.units;
+
+      switch (sensor.type) {
+        case NowManager::SensorValueType::FLOAT:
+          record["value"] = sensor.value.f;
+          break;
+        case NowManager::SensorValueType::INT:
+          record["value"] = sensor.value.i;
+          break;
+        case NowManager::SensorValueType::BOOL:
+          record["value"] = sensor.value.b;
+          break;
+      }
+      return true;
+    });
   });
-}
\ No newline at end of file
+
+  // Actuator states
+  _server.on(
+      "/api/actuators", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        _countRequest();
+        _sendJsonArray(request, [this](size_t index, JsonObject record) {
+          NowManager::ActuatorData actuator;
+          if (!_now.copyActuatorAt(index, actuator)) return false;
+
+          record["mac"] = MacText(actuator.mac).c_str();
+          record["name"] = actuator.deviceName;
+          record["connected"] = actuator.isConnected;
+          record["state"] = actuator.state;
+          return true;
+        });
+      });
+
+  // Actuator command: {"mac": "AA:BB:CC:DD:EE:FF", "state": true}
+  _server.on(
+      "/api/actuators", HTTP_POST,
+      [this](AsyncWebServerRequest* request) {
+        TRACE_SCOPE("http_actuators");
+        _countRequest();
+        if (request->contentLength() > MAX_API_BODY_SIZE) {
+          request->send(413, "text/plain", "Cuerpo demasiado grande");
+          return;
+        }
+
+        if (request->_tempObject == nullptr) {
+          request->send(400, "text/plain", "Cuerpo vacío");
+          return;
+        }
+
+        _jsonPool.reset();
+        JsonDocument filter(&_jsonPool);
+        filter["mac"] = true;
+        filter["state"] = true;
+
+        JsonDocument doc(&_jsonPool);
+        DeserializationError error = deserializeJson(
+            doc, (const char*)request->_tempObject, request->contentLength(),
+            DeserializationOption::Filter(filter));
+
+        _releaseBody(request);
+
+        if (error || !doc["mac"].is<const char*>() ||
+            !doc["state"].is<bool>()) {
+          request->send(400, "text/plain", "Error en el formato JSON");
+          return;
+        }
+
+        uint8_t mac[6];
+        stringToMac(doc["mac"].as<String>(), mac);
+
+        bool isActuator = false;
+        NowManager::ActuatorData actuator;
+        for (size_t i = 0; _now.copyActuatorAt(i, actuator); i++) {
+          if (memcmp(actuator.mac, mac, 6) == 0) {
+            isActuator = true;
+            break;
+          }
+        }
+
+        if (!isActuator) {
+          request->send(404, "text/plain", "Actuador no encontrado");
+          return;
+        }
+
+        // El estado se actualiza cuando el nodo confirma el cambio
+        if (!_now.sendSetActuatorMsg(mac, doc["state"].as<bool>())) {
+          request->send(502, "text/plain", "Error enviando la orden");
+          return;
+        }
+
+        request->send(202, "text/plain", "Orden enviada");
+      },
+      nullptr,
+      [](AsyncWebServerRequest* request, uint8_t* data, size_t len,
+         size_t index, size_t total) {
+        _receiveBody(request, data, len, index, total, MAX_API_BODY_SIZE);
+      });
+
+  // Node settings: POST /api/nodes/<mac>/report
+  // {"interval": 10000, "threshold": 0.5} and POST /api/nodes/<mac>/relay
+  // {"enabled": true}
+  _server.on(
+      "/api/nodes/*", HTTP_POST,
+      [this](AsyncWebServerRequest* request) {
+        if (request->contentLength() > MAX_API_BODY_SIZE) {
+          request->send(413, "text/plain", "Cuerpo demasiado grande");
+          return;
+        }
+
+        if (request->_tempObject == nullptr) {
+          request->send(400, "text/plain", "Cuerpo vacío");
+          return;
+        }
+
+        _jsonPool.reset();
+        JsonDocument doc(&_jsonPool);
+        DeserializationError error =
+            deserializeJson(doc, (const char*)request->_tempObject,
+                            request->contentLength());
+
+        _releaseBody(request);
+
+        uint8_t mac[6];
+        String action;
+        if (!parseNodeUrl(request->url(), mac, action) ||
+            (action != "report" && action != "relay")) {
+          request->send(404);
+          return;
+        }
+
+        if (!_now.isDevicePaired(mac)) {
+          request->send(404, "text/plain", "Nodo no encontrado");
+          return;
+        }
+
+        if (action == "relay") {
+          if (error || !doc["enabled"].is<bool>()) {
+            request->send(400, "text/plain", "Error en el formato JSON");
+            return;
+          }
+
+          const bool enabled = doc["enabled"].as<bool>();
+          if (!_now.setRelayRole(mac, enabled)) {
+            request->send(502, "text/plain", "Error enviando la configuracion");
+            return;
+          }
+
+          if (!_config.saveNodeRelayRole(mac, enabled)) {
+            request->send(500, "text/plain", "Error de servidor");
+            return;
+          }
+
+          request->send(200, "text/plain", "OK");
+          return;
+        }
+
+        if (error || !doc["interval"].is<uint32_t>() ||
+            !doc["threshold"].is<float>()) {
+          request->send(400, "text/plain", "Error en el formato JSON");
+          return;
+        }
+
+        // Se valida antes de enviar y se persiste solo si el envio se acepta
+        const uint32_t interval = doc["interval"].as<uint32_t>();
+        const float threshold = doc["threshold"].as<float>();
+        if (!NowManager::isValidReportConfig(interval, threshold)) {
+          request->send(400, "text/plain", "Configuracion no valida");
+          return;
+        }
+
+        if (!_now.setReportConfig(mac, interval, threshold)) {
+          request->send(502, "text/plain", "Error enviando la configuracion");
+          return;
+        }
+
+        if (!_config.saveNodeReportConfig(mac, interval, threshold)) {
+          request->send(500, "text/plain", "Error de servidor");
+          return;
+        }
+
+        request->send(200, "text/plain", "OK");
+      },
+      nullptr,
+      [](AsyncWebServerRequest* request, uint8_t* data, size_t len,
+         size_t index, size_t total) {
+        _receiveBody(request, data, len, index, total, MAX_API_BODY_SIZE);
+      });
+
+#ifdef TRACE_ENABLED
+  // Trace in Chrome trace-event format (JSON array): chrome://tracing
+  _server.on("/debug/trace", HTTP_GET, [](AsyncWebServerRequest* request) {
+    std::shared_ptr<Trace::Export> trace(new Trace::Export());
+
+    _sendJsonArray(request, [trace](size_t index, JsonObject record) {
+      Trace::Event event;
+      if (!trace->next(event)) return false;
+
+      record["pid"] = 0;
+      record["tid"] = event.tid;
+
+      if (event.phase == 'M') {
+        record["name"] = "thread_name";
+        record["ph"] = "M";
+        record["args"]["name"] = event.name;
+        return true;
+      }
+
+      record["name"] = event.name;
+      record["ph"] = event.phase == 'B' ? "B" : "E";
+      record["ts"] = event.time;
+      record["args"]["core"] = event.core;
+      return true;
+    });
+  });
+
+  // Start/stop recording: {"enabled": true}
+  _server.on(
+      "/debug/trace", HTTP_POST,
+      [this](AsyncWebServerRequest* request) {
+        if (request->contentLength() > MAX_API_BODY_SIZE) {
+          request->send(413, "text/plain", "Cuerpo demasiado grande");
+          return;
+        }
+
+        if (request->_tempObject == nullptr) {
+          request->send(400, "text/plain", "Cuerpo vacío");
+          return;
+        }
+
+        _jsonPool.reset();
+        JsonDocument doc(&_jsonPool);
+        DeserializationError error =
+            deserializeJson(doc, (const char*)request->_tempObject,
+                            request->contentLength());
+
+        _releaseBody(request);
+
+        if (error || !doc["enabled"].is<bool>()) {
+          request->send(400, "text/plain", "Error en el formato JSON");
+          return;
+        }
+
+        Trace::setEnabled(doc["enabled"].as<bool>());
+        request->send(200, "text/plain", "OK");
+      },
+      nullptr,
+      [](AsyncWebServerRequest* request, uint8_t* data, size_t len,
+         size_t index, size_t total) {
+        _receiveBody(request, data, len, index, total, MAX_API_BODY_SIZE);
+      });
+#endif
+}
+
+void WebServerManager::_onWsEvent(AsyncWebSocketClient* client,
+                                  AwsEventType type) {
+  xSemaphoreTake(_wsMutex, portMAX_DELAY);
+
+  if (type == WS_EVT_CONNECT) {
+    uint32_t* slot = nullptr;
+    for (uint8_t i = 0; i < MAX_WS_CLIENTS && slot == nullptr; i++) {
+      if (_wsClientIds[i] == 0) slot = &_wsClientIds[i];
+    }
+
+    if (slot != nullptr) {
+      *slot = client->id();
+      _needsSnapshot = true;
+    } else {
+      client->close();  // Limite de clientes alcanzado
+    }
+  } else if (type == WS_EVT_DISCONNECT) {
+    for (uint8_t i = 0; i < MAX_WS_CLIENTS; i++) {
+      if (_wsClientIds[i] == client->id()) _wsClientIds[i] = 0;
+    }
+  }
+
+  xSemaphoreGive(_wsMutex);
+
+  if (_needsSnapshot) notifyDataChanged();
+}
+
+void WebServerManager::_pushTask(void* parameter) {
+  WebServerManager* server = static_cast<WebServerManager*>(parameter);
+
+  while (1) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    // Agrupar todos los cambios de la ventana en una sola trama
+    vTaskDelay(pdMS_TO_TICKS(PUSH_COALESCE_WINDOW));
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    server->_pushUpdates();
+  }
+}
+
+void WebServerManager::_pushUpdates() {
+  TRACE_SCOPE("ws_push");
+  uint8_t frame[sizeof(PushHeader) + sizeof(_sentSensors) +
+                sizeof(_sentActuators)];
+  PushHeader* header = reinterpret_cast<PushHeader*>(frame);
+  size_t length = sizeof(PushHeader);
+
+  const bool isSnapshot = _needsSnapshot;
+  _needsSnapshot = false;
+
+  uint8_t sensorCount =
+      std::min<size_t>(_now.getSensorListSize(), MAX_PUSH_SENSORS);
+  uint8_t actuatorCount =
+      std::min<size_t>(_now.getActuatorListSize(), MAX_PUSH_ACTUATORS);
+
+  // Si alguna tabla encoge se envia el estado completo
+  const bool isFull = isSnapshot || sensorCount < _sentSensorCount ||
+                      actuatorCount < _sentActuatorCount;
+
+  header->frameType = static_cast<uint8_t>(isFull ? PushFrame::SNAPSHOT
+                                                  : PushFrame::DELTA);
+  header->count = 0;
+
+  // Solo se codifican los registros que cambiaron desde el ultimo envio
+  for (uint8_t i = 0; i < sensorCount; i++) {
+    // Si la tabla encoge entre tanto, el siguiente envio es completo
+    NowManager::SensorData sensor;
+    if (!_now.copySensorAt(i, sensor)) {
+      sensorCount = i;
+      _needsSnapshot = true;
+      break;
+    }
+
+    SensorRecord record;
+    memcpy(record.mac, sensor.mac, 6);
+    memset(record.variable, 0, sizeof(record.variable));
+    strncpy(record.variable, sensor.variable, sizeof(record.variable));
+    record.connected = sensor.isConnected;
+    record.valueType = static_cast<uint8_t>(sensor.type);
+    memcpy(record.value, &sensor.value, sizeof(record.value));
+
+    if (!isFull && i < _sentSensorCount &&
+        memcmp(&record, &_sentSensors[i], sizeof(record)) == 0)
+      continue;
+
+    _sentSensors[i] = record;
+    memcpy(frame + length, &record, sizeof(record));
+    length += sizeof(record);
+    header->count++;
+  }
+
+  for (uint8_t i = 0; i < actuatorCount; i++) {
+    NowManager::ActuatorData actuator;
+    if (!_now.copyActuatorAt(i, actuator)) {
+      actuatorCount = i;
+      _needsSnapshot = true;
+      break;
+    }
+
+    ActuatorRecord record;
+    memcpy(record.mac, actuator.mac, 6);
+    record.connected = actuator.isConnected;
+    record.state = actuator.state;
+
+    if (!isFull && i < _sentActuatorCount &&
+        memcmp(&record, &_sentActuators[i], sizeof(record)) == 0)
+      continue;
+
+    _sentActuators[i] = record;
+    memcpy(frame + length, &record, sizeof(record));
+    length += sizeof(record);
+    header->count++;
+  }
+
+  _sentSensorCount = sensorCount;
+  _sentActuatorCount = actuatorCount;
+  if (_needsSnapshot) notifyDataChanged();
+
+  if (header->count == 0 && !isFull) return;
+
+  // Los clientes que no consumen sus mensajes se desconectan
+  xSemaphoreTake(_wsMutex, portMAX_DELAY);
+  for (uint8_t i = 0; i < MAX_WS_CLIENTS; i++) {
+    AsyncWebSocketClient* client =
+        _wsClientIds[i] != 0 ? _ws.client(_wsClientIds[i]) : nullptr;
+
+    if (client != nullptr &&
+        (client->queueIsFull() || client->queueLen() >= MAX_WS_QUEUE)) {
+      client->close();
+      _wsClientIds[i] = 0;
+      _droppedClients++;
+    }
+  }
+  xSemaphoreGive(_wsMutex);
+
+  // Un solo buffer compartido por todos los clientes
+  AsyncWebSocketMessageBuffer* buffer = _ws.makeBuffer(frame, length);
+  if (buffer != nullptr) _ws.binaryAll(buffer);
+
+  _ws.cleanupClients(MAX_WS_CLIENTS);
+}
+
+void WebServerManager::_sendJsonArray(AsyncWebServerRequest* request,
+                                      RecordWriter writer) {
+  // Respuesta chunked generada registro a registro desde las tablas
+  std::shared_ptr<JsonArrayStream> stream(new JsonArrayStream());
+  stream->writer = writer;
+
+  AsyncWebServerResponse* response = request->beginChunkedResponse(
+      "application/json",
+      [stream](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+        TRACE_SCOPE("http_json_chunk");
+        size_t written = 0;
+
+        while (written < maxLen) {
+          if (stream->offset == stream->length && !stream->fill()) break;
+
+          const size_t count = std::min(maxLen - written,
+                                        stream->length - stream->offset);
+          memcpy(buffer + written, stream->record + stream->offset, count);
+          stream->offset += count;
+          written += count;
+        }
+
+        return written;
+      });
+
+  request->send(response);
+}
+
+#ifdef EMBED_WEB_ASSETS
+const EmbeddedAsset* WebServerManager::_findAsset(const char* path) {
+  // Manifiesto ordenado en compilacion: busqueda binaria sin tocar LittleFS
+  const EmbeddedAsset* begin = WebAssetData::MANIFEST;
+  const EmbeddedAsset* end = begin + sizeof(WebAssetData::MANIFEST) /
+                                         sizeof(WebAssetData::MANIFEST[0]);
+  const EmbeddedAsset* it = std::lower_bound(
+      begin, end, path, [](const EmbeddedAsset& asset, const char* value) {
+        return strcmp(asset.path, value) < 0;
+      });
+
+  return (it != end && strcmp(it->path, path) == 0) ? it : nullptr;
+}
+#else
+void WebServerManager::_loadAssetManifest() {
+  _assets.clear();
+
+  File manifest = LittleFS.open(ASSET_MANIFEST_PATH, "r");
+  if (!manifest) {
+    LOG_WARN("Manifiesto de assets no encontrado");
+    return;
+  }
+
+  // Una linea por asset: "<url> <etag> <mime> <inmutable>"
+  while (manifest.available()) {
+    const String line = manifest.readStringUntil('\n');
+    char url[64];
+    char etag[17];
+    char mime[32];
+    int immutable;
+
+    if (sscanf(line.c_str(), "%63s %16s %31s %d", url, etag, mime,
+               &immutable) != 4)
+      continue;
+
+    _assets.push_back({url, String("\"") + etag + "\"", mime, immutable != 0});
+  }
+
+  manifest.close();
+}
+
+const WebServerManager::Asset* WebServerManager::_findAsset(
+    const char* path) {
+  for (const auto& asset : _assets) {
+    if (asset.url == path) return &asset;
+  }
+
+  return nullptr;
+}
+#endif
+
+void WebServerManager::_handleAsset(AsyncWebServerRequest* request) {
+  const char* url = request->url().c_str();
+  const auto* asset = _findAsset(url);
+
+  // Rutas de la SPA: cualquier URL desconocida fuera de la API sirve
+  // index.html
+  if (asset == nullptr && !isApiUrl(url)) asset = _findAsset("/index.html");
+  if (asset == nullptr) {
+    request->send(404);
+    return;
+  }
+
+  // El navegador ya tiene esta version
+  if (request->hasHeader("If-None-Match") &&
+      request->getHeader("If-None-Match")->value() == asset->etag) {
+    AsyncWebServerResponse* response = request->beginResponse(304);
+    response->addHeader("ETag", asset->etag);
+    request->send(response);
+    return;
+  }
+
+#ifdef EMBED_WEB_ASSETS
+  // Se envia directamente desde flash, sin copias ni E/S de ficheros
+  AsyncWebServerResponse* response =
+      request->beginResponse_P(200, asset->mime, asset->data, asset->length);
+#else
+  AsyncWebServerResponse* response = request->beginResponse(
+      LittleFS, "/www" + asset->url + ".gz", asset->mime);
+#endif
+  response->addHeader("Content-Encoding", "gzip");
+  response->addHeader("ETag", asset->etag);
+
+  // Los nombres con hash nunca cambian; el resto se revalida con el ETag
+  response->addHeader("Cache-Control",
+                      asset->immutable ? "public, max-age=31536000, immutable"
+                                       : "no-cache");
+  request->send(response);
+}
@@ -1,7 +1,32 @@
 #include "WiFiManager.hpp"
 
+#include <algorithm>
+
+#include "Logger.hpp"
 #include "Utils.hpp"
 
+bool WiFiManager::init() {
+  _mutex = _mutexStorage.create();
+  if (_mutex == NULL) return false;
+
+  // La reconexion la gestiona el backoff propio, no el driver
+  WiFi.setAutoReconnect(false);
+  WiFi.onEvent([this](arduino_event_id_t event, arduino_event_info_t info) {
+    _onWiFiEvent(event, info);
+  });
+
+  _staTimer =
+      _staTimerStorage.create("STA Backoff", pdMS_TO_TICKS(STA_BACKOFF_BASE),
+                              pdFALSE, this, _staTimerCallback);
+  _staQueue = _staQueueStorage.create();
+  if (_staTimer == NULL || _staQueue == NULL) return false;
+
+  return _staTaskStorage.create(_staTask, "WiFi STA", this, 1,
+                                &_staTaskHandler, 0) &&
+         _scanTaskStorage.create(_scanTask, "WiFi Scan", this, 1,
+                                 &_scanTaskHandler, 0);
+}
+
 void WiFiManager::modeAPSTA() { WiFi.mode(WIFI_AP_STA); }
 
 String WiFiManager::startAP(const String& ssid, const String& password) {
@@ -11,52 +36,271 @@ String WiFiManager::startAP(const String& ssid, const String& password) {
 
 void WiFiManager::closeAP() { WiFi.softAPdisconnect(); }
 
-bool WiFiManager::connectSTA(const String& ssid, const String& password) {
-  Serial.printf("Network: %s\n", ssid.c_str());
-  Serial.printf("Password: %s\n", password.c_str());
+bool WiFiManager::startSTA(const String& ssid, const String& password) {
+  if (ssid.isEmpty()) {
+    _staState = StaState::FAILED;
+    _bus.publish(EventId::STA_FAILED);
+    return false;
+  }
+
+  // Las credenciales se escriben antes de encolar: la tarea las ve completas
+  strlcpy(_staSsid, ssid.c_str(), sizeof(_staSsid));
+  strlcpy(_staPassword, password.c_str(), sizeof(_staPassword));
+
+  StaMessage message = {};
+  message.input = StaInput::START;
+  _postSta(message);
+  return true;
+}
+
+const char* WiFiManager::staStateToText(StaState state) {
+  switch (state) {
+    case StaState::IDLE:
+      return "idle";
+    case StaState::CONNECTING:
+      return "connecting";
+    case StaState::CONNECTED:
+      return "connected";
+    case StaState::BACKOFF:
+      return "backoff";
+    case StaState::FAILED:
+      return "failed";
+  }
+
+  return "";
+}
+
+void WiFiManager::_staTimerCallback(TimerHandle_t timer) {
+  WiFiManager* wifi = static_cast<WiFiManager*>(pvTimerGetTimerID(timer));
+
+  // En la tarea de los timers solo se avisa; el trabajo es de la tarea STA
+  StaMessage message = {};
+  message.input = StaInput::TIMER;
+  wifi->_postSta(message);
+}
+
+void WiFiManager::_onWiFiEvent(arduino_event_id_t event,
+                               arduino_event_info_t info) {
+  StaMessage message = {};
+
+  switch (event) {
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+      message.input = StaInput::GOT_IP;
+      message.ip = info.got_ip.ip_info.ip;
+      break;
+
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+      message.input = StaInput::DISCONNECTED;
+      message.reason = info.wifi_sta_disconnected.reason;
+      break;
+
+    default:
+      return;
+  }
+
+  _postSta(message);
+}
+
+void WiFiManager::_postSta(const StaMessage& message) {
+  // Sin espera ni log: se llama desde la tarea de los timers y la del driver.
+  // Con una sola tarea consumidora la cola no llega a llenarse
+  xQueueSend(_staQueue, &message, 0);
+}
+
+void WiFiManager::_staTask(void* parameter) {
+  WiFiManager* wifi = static_cast<WiFiManager*>(parameter);
+  StaMessage message;
+
+  while (1) {
+    if (xQueueReceive(wifi->_staQueue, &message, portMAX_DELAY) == pdTRUE)
+      wifi->_handleSta(message);
+  }
+}
+
+// Timer y eventos del driver llegan por la misma cola: una sola tarea
+// decide cada transicion y no se programan dos reintentos
+void WiFiManager::_handleSta(const StaMessage& message) {
+  switch (message.input) {
+    case StaInput::START:
+      _staAttempts = 0;
+      _authFailures = 0;
+      _disconnectedAt = 0;
+
+      LOG_INFO("Network: %s", _staSsid);
+
+      _connectSTA();
+      return;
+
+    case StaInput::TIMER:
+      // Aviso de un plazo que ya se ha sustituido por otro
+      if (static_cast<int32_t>(xTaskGetTickCount() - _staDeadline) < 0) return;
+
+      if (_staState == StaState::BACKOFF) {
+        _connectSTA();
+      } else if (_staState == StaState::CONNECTING) {
+        // Sin respuesta del AP dentro del plazo; la desconexion provocada
+        // llega despues en BACKOFF y no reprograma
+        WiFi.disconnect();
+        _scheduleReconnect();
+      }
+      return;
 
-  // Implementación de la conexión STA
-  WiFi.begin(ssid.c_str(), password.c_str());
+    default:
+      break;
+  }
+
+  if (_staState == StaState::IDLE || _staState == StaState::FAILED) return;
+
+  switch (message.input) {
+    case StaInput::GOT_IP:
+      xTimerStop(_staTimer, 0);
+      _staState = StaState::CONNECTED;
+      _staAttempts = 0;
+      _authFailures = 0;
+
+      if (_disconnectedAt != 0) {
+        _lastReconnectTime = millis() - _disconnectedAt;
+        _disconnectedAt = 0;
+        _reconnects++;
+        LOG_INFO("WiFi reconectado en %lu ms", _lastReconnectTime);
+      } else {
+        LOG_INFO("Conectado a WiFi, IP: " IPSTR, IP2STR(&message.ip));
+      }
+
+      _bus.publish(EventId::STA_CONNECTED);
+      break;
+
+    case StaInput::DISCONNECTED: {
+      const uint8_t reason = message.reason;
+
+      if (_staState == StaState::CONNECTED) {
+        _disconnectedAt = millis();
+        _bus.publish(EventId::STA_DISCONNECTED);
+      }
+
+      // Una clave incorrecta no se arregla reintentando
+      if (reason == WIFI_REASON_AUTH_FAIL ||
+          reason == WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT ||
+          reason == WIFI_REASON_HANDSHAKE_TIMEOUT) {
+        if (++_authFailures >= STA_MAX_AUTH_FAILURES) {
+          xTimerStop(_staTimer, 0);
+          _staState = StaState::FAILED;
+          LOG_ERROR("Error al conectar a WiFi: autenticacion");
+          _bus.publish(EventId::STA_FAILED);
+          break;
+        }
+      }
+
+      if (_staState != StaState::BACKOFF) _scheduleReconnect();
+      break;
+    }
 
-  // Esperar a que se establezca la conexión
-  uint8_t retries = 0;
-  while (WiFi.status() != WL_CONNECTED && retries < 20) {
-    delay(500);
-    Serial.print(".");
-    retries++;
+    default:
+      break;
   }
+}
+
+void WiFiManager::_connectSTA() {
+  _staState = StaState::CONNECTING;
+  _bus.publish(EventId::STA_CONNECTING);
+
+  // WiFi.begin no bloquea: el resultado llega por eventos
+  WiFi.begin(_staSsid, _staPassword);
+
+  _armStaTimer(STA_CONNECT_TIMEOUT);
+}
 
-  if (WiFi.status() == WL_CONNECTED) {
-    Serial.println("\nConectado a WiFi!");
-    Serial.print("IP: ");
-    Serial.println(WiFi.localIP());
+void WiFiManager::_scheduleReconnect() {
+  // Backoff exponencial con jitter: [delay / 2, delay]
+  const uint32_t exponential = STA_BACKOFF_BASE
+                               << std::min<uint8_t>(_staAttempts, 6);
+  const uint32_t delay =
+      exponential < STA_BACKOFF_MAX ? exponential : STA_BACKOFF_MAX;
+  const uint32_t wait = delay / 2 + esp_random() % (delay / 2 + 1);
+
+  if (_staAttempts < UINT8_MAX) _staAttempts++;
+  _staState = StaState::BACKOFF;
+
+  LOG_INFO("WiFi: reintento %u en %lu ms", _staAttempts, wait);
+
+  _armStaTimer(wait);
+}
 
-    return true;
+void WiFiManager::_armStaTimer(const uint32_t timeout) {
+  // El timer vence como pronto a partir de aqui: un aviso anterior a este
+  // plazo es de un armado previo
+  const TickType_t ticks = std::max<TickType_t>(pdMS_TO_TICKS(timeout), 1);
+  _staDeadline = xTaskGetTickCount() + ticks;
+  xTimerChangePeriod(_staTimer, ticks, 0);
+}
+
+WiFiManager::ScanState WiFiManager::requestScan() {
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+
+  ScanState state = ScanState::READY;
+
+  if (_isScanning) {
+    state = ScanState::SCANNING;
+  } else if (_scanFailed) {
+    // Informar del fallo una vez; la siguiente peticion reintenta
+    _scanFailed = false;
+    state = ScanState::FAILED;
+  } else if (!_hasScan || millis() - _scanTime > SCAN_CACHE_TTL) {
+    _isScanning = true;
+    xTaskNotifyGive(_scanTaskHandler);
+    state = ScanState::SCANNING;
   }
 
-  Serial.println("\nError al conectar a WiFi");
-  return false;
+  xSemaphoreGive(_mutex);
+
+  return state;
 }
 
-void WiFiManager::scanNetworks() {
-  _scanResults.clear();
-  uint16_t numNetworks =
+uint8_t WiFiManager::getScanResults(ScanResult* results,
+                                    const uint8_t maxResults) {
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  const uint8_t count = std::min(_scanCount, maxResults);
+  memcpy(results, _scanResults, count * sizeof(ScanResult));
+  xSemaphoreGive(_mutex);
+
+  return count;
+}
+
+void WiFiManager::_scanTask(void* parameter) {
+  WiFiManager* wifi = static_cast<WiFiManager*>(parameter);
+
+  while (1) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    wifi->_scanNetworks();
+  }
+}
+
+void WiFiManager::_scanNetworks() {
+  // El escaneo bloquea solo esta tarea, no el servidor web
+  const int16_t numNetworks =
       WiFi.scanNetworks(/*async*/ false, /*hidden*/ false, /*passive*/ false,
-                        /*max_ms_per_chan*/ 300);
+                        /*max_ms_per_chan*/ SCAN_CHANNEL_TIME);
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
 
-  uint8_t i = 0;
-  for (i; i < numNetworks; i++) {
-    ScanResult result;
-    result.ssid = WiFi.SSID(i);
-    result.rssi = WiFi.RSSI(i);
-    result.secure = isNetworkSecure(WiFi.encryptionType(i));
-    _scanResults.push_back(result);
+  if (numNetworks < 0) {
+    _scanFailed = true;
+  } else {
+    _scanCount = std::min<int16_t>(numNetworks, MAX_SCAN_RESULTS);
+
+    for (uint8_t i = 0; i < _scanCount; i++) {
+      ScanResult& result = _scanResults[i];
+      strlcpy(result.ssid, WiFi.SSID(i).c_str(), sizeof(result.ssid));
+      result.rssi = WiFi.RSSI(i);
+      result.secure = isNetworkSecure(WiFi.encryptionType(i));
+    }
+
+    _scanTime = millis();
+    _hasScan = true;
   }
 
+  _isScanning = false;
+  xSemaphoreGive(_mutex);
+
   WiFi.scanDelete();
 }
-
-const std::vector<WiFiManager::ScanResult>& WiFiManager::getScanResults()
-    const {
-  return _scanResults;
-}
\ No newline at end of file
@@ -3,11 +3,17 @@
 #include <freertos/FreeRTOS.h>
 
 #include "ConfigManager.hpp"
+#include "EventBus.hpp"
 #include "IndicatorManager.hpp"
 #include "KeypadManager.hpp"
+#include "Logger.hpp"
 #include "MenuManager.hpp"
+#include "NodeOtaManager.hpp"
 #include "NowManager.hpp"
+#include "PowerManager.hpp"
+#include "StaticAlloc.hpp"
 #include "SyncButtonManager.hpp"
+#include "Trace.hpp"
 #include "Utils.hpp"
 #include "WebServerManager.hpp"
 #include "WiFiManager.hpp"
@@ -29,35 +35,54 @@ const gpio_num_t lcdD6 = GPIO_NUM_25;
 const gpio_num_t lcdD7 = GPIO_NUM_33;
 
 // Task Handlers
+TaskHandle_t handleMenuTaskHandler = NULL;
+TaskHandle_t pingAllDevicesTaskHandler = NULL;
 TaskHandle_t blinkRGBTaskHandler = NULL;
 TaskHandle_t sendSyncBroadcastTaskHandler = NULL;
 
 // Timer Handlers
 TimerHandle_t syncModeTimeoutTimerHandler = NULL;
 
+// Pilas y bloques de control (estaticos con STATIC_ALLOCATION)
+StaticTask<10000> handleMenuTaskStorage;
+StaticTask<4096> pingAllDevicesTaskStorage;
+StaticTask<2048> blinkRGBTaskStorage;
+StaticTask<4096> sendSyncBroadcastTaskStorage;
+StaticTimer syncModeTimeoutTimerStorage;
+
 // Global Variables
-bool syncModeState = false;
-MenuManager::Data globalData;
+bool syncModeState = false;  // Solo lo modifica el contexto SYSTEM del bus
 uint32_t wdtTimeout = 5;
+const uint32_t KEY_WAIT_TIMEOUT = 1000;  // Menor que el timeout del watchdog
 
+EventBus bus;
 ConfigManager config;
-WiFiManager wifi;
-WebServerManager server(config, wifi);
+WiFiManager wifi(bus);
+NowManager now;
+NodeOtaManager nodeOta(now);
+PowerManager power;
+WebServerManager server(config, wifi, now, nodeOta, power, bus);
 IndicatorManager rgb(rgbRed, rgbGreen, rgbBlue);
 KeypadManager keypad(keypadUp, keypadDown, keypadBack, keypadEnter);
-SyncButtonManager syncButton(syncButtonPin);
-NowManager now;
-MenuManager menu(lcdRS, lcdEN, lcdD4, lcdD5, lcdD6, lcdD7, server, globalData,
-                 now);
+SyncButtonManager syncButton(syncButtonPin, bus);
+MenuManager menu(lcdRS, lcdEN, lcdD4, lcdD5, lcdD6, lcdD7, now, power, bus);
 
 // Definitions
 void setWatchdogTimeout(uint32_t newTimeout);
-void tryConnectSTA(const bool updateDisplay = false);
-void onConfigEnterCallback();
-void onConfigExitCallback();
-void onSetActuatorCallback();
-void onScheduleActuatorCallback();
+void onStaConnectingCallback(const BusEvent& event);
+void onStaConnectedCallback(const BusEvent& event);
+void onStaDisconnectedCallback(const BusEvent& event);
+void onStaFailedCallback(const BusEvent& event);
+void onConfigEnterCallback(const BusEvent& event);
+void onConfigExitCallback(const BusEvent& event);
+void onUpdateStartCallback(const BusEvent& event);
+void onUpdateProgressCallback(const BusEvent& event);
+void onUpdateEndCallback(const BusEvent& event);
+void onSetActuatorCallback(const BusEvent& event);
+void onScheduleActuatorCallback(const BusEvent& event);
+void onDataUpdatedCallback(const BusEvent& event);
 void onReceivedCallback(const uint8_t* mac, const uint8_t* data, int length);
+void handleReceivedFrame(const uint8_t* mac, const uint8_t* data, int length);
 void onSendCallback(const uint8_t* mac, esp_now_send_status_t status);
 void handleMenuTask(void* parameter);
 void blinkRGBTask(void* parameter);
@@ -65,42 +90,82 @@ void sendSyncBroadcastTask(void* parameter);
 void pingAllDevicesTask(void* parameter);
 void enterSyncMode();
 void endSyncMode();
-void onLongButtonPressCallback() { enterSyncMode(); }
-void onSimpleButtonPressCallback() { endSyncMode(); }
+void onLongButtonPressCallback(const BusEvent& event) { enterSyncMode(); }
+void onSyncEndCallback(const BusEvent& event) { endSyncMode(); }
 void onRegistrationReceivedCallback(const uint8_t* mac, const uint8_t* data,
                                     int length);
-void syncModeTimeoutCallback(TimerHandle_t xTimer) { endSyncMode(); };
+void syncModeTimeoutCallback(TimerHandle_t xTimer) {
+  bus.publish(EventId::SYNC_END);
+};
 void registerAllNodes(const uint8_t size);
 void pingAllDevices();
+void sendAllNodeConfigs();
+
+// Suscriptores del bus. UI: pantalla e indicador; SYSTEM: radio, red y modo
+// vinculacion, siempre en la misma tarea; INLINE: solo avisos no bloqueantes
+constexpr Subscriber subscribers[] = {
+    {EventId::STA_CONNECTING, EventContext::UI, onStaConnectingCallback},
+    {EventId::STA_CONNECTED, EventContext::UI, onStaConnectedCallback},
+    {EventId::STA_DISCONNECTED, EventContext::UI, onStaDisconnectedCallback},
+    {EventId::STA_FAILED, EventContext::UI, onStaFailedCallback},
+    {EventId::UPDATE_START, EventContext::UI, onUpdateStartCallback},
+    {EventId::UPDATE_PROGRESS, EventContext::UI, onUpdateProgressCallback},
+    {EventId::UPDATE_END, EventContext::UI, onUpdateEndCallback},
+    {EventId::CONFIG_ENTER, EventContext::SYSTEM, onConfigEnterCallback},
+    {EventId::CONFIG_EXIT, EventContext::SYSTEM, onConfigExitCallback},
+    {EventId::SET_ACTUATOR, EventContext::SYSTEM, onSetActuatorCallback},
+    {EventId::SCHEDULE_ACTUATOR, EventContext::SYSTEM,
+     onScheduleActuatorCallback},
+    {EventId::SYNC_PRESS, EventContext::SYSTEM, onSyncEndCallback},
+    {EventId::SYNC_LONG_PRESS, EventContext::SYSTEM,
+     onLongButtonPressCallback},
+    {EventId::SYNC_END, EventContext::SYSTEM, onSyncEndCallback},
+    {EventId::DATA_UPDATED, EventContext::INLINE, onDataUpdatedCallback},
+};
 
 void setup() {
   Serial.begin(115200);
+  Logger::begin(Serial);
+
+#ifdef TRACE_ENABLED
+  // Compilada pero parada: se activa con POST /debug/trace
+  if (!Trace::begin()) LOG_WARN("Error iniciando la traza");
+#endif
 
   if (!config.init()) {
     ESP.restart();
   }
 
-  // Test
-  config.printConfig();
+  LOG_DEBUG("Configuracion: %u nodos, perfil de energia %u",
+            config.getNodeLength(), config.getPowerProfile());
+
+  if (!bus.begin(subscribers)) {
+    ESP.restart();
+  }
 
   wifi.modeAPSTA();
+  if (!wifi.init()) {
+    ESP.restart();
+  }
 
-  menu.on(MenuManager::Event::CONFIG_ENTER, onConfigEnterCallback);
-  menu.on(MenuManager::Event::CONFIG_EXIT, onConfigExitCallback);
-  menu.on(MenuManager::Event::SET_ACTUATOR, onSetActuatorCallback);
-  menu.on(MenuManager::Event::SCHEDULE_ACTUATOR, onScheduleActuatorCallback);
+  // Perfil guardado; si no es valido se arranca sin ahorro de energia
+  const PowerManager::Profile profile =
+      static_cast<PowerManager::Profile>(config.getPowerProfile());
+  if (!power.begin(profile) &&
+      !power.setProfile(PowerManager::Profile::PERFORMANCE)) {
+    LOG_ERROR("Error configurando el perfil de energia");
+  }
 
-  menu.begin();
+  if (!menu.begin()) {
+    ESP.restart();
+  }
   menu.showCustomInfoScreen("HomeSphere", "Bienvenid@");
 
   rgb.begin();
-  keypad.begin();
 
-  syncButton.begin();
-  syncButton.on(SyncButtonManager::Event::SIMPLE_PRESS,
-                onSimpleButtonPressCallback);
-  syncButton.on(SyncButtonManager::Event::LONG_PRESS,
-                onLongButtonPressCallback);
+  if (!keypad.begin() || !syncButton.begin()) {
+    ESP.restart();
+  }
 
   now.init();
   now.onReceived(onReceivedCallback);
@@ -108,16 +173,52 @@ void setup() {
   now.setDataTransfer(true);
   registerAllNodes(config.getNodeLength());
   pingAllDevices();
+  sendAllNodeConfigs();
+
+  // Conexion STA en segundo plano; el resultado llega por eventos
+  const ConfigManager::NetworkConfig staConfig = config.getSTAConfig();
+  if (!staConfig.ssid.isEmpty())
+    wifi.startSTA(staConfig.ssid, staConfig.password);
+
+  // API y UI escuchan desde el arranque; el portal solo abre el AP
+  server.setupRoutes();
+  server.begin();
 
   menu.clearCustomInfoScreen();
 
   // Tasks
-  xTaskCreatePinnedToCore(handleMenuTask, "Handle Menu", 10000, NULL, 1, NULL,
-                          0);
-  xTaskCreatePinnedToCore(pingAllDevicesTask, "Ping All Devices", 4096, NULL, 2,
-                          NULL, 1);
+  syncModeTimeoutTimerHandler = syncModeTimeoutTimerStorage.create(
+      "Sync Mode Timeout", pdMS_TO_TICKS(NowManager::SYNC_MODE_TIMEOUT),
+      pdFALSE, (void*)0, syncModeTimeoutCallback);  // 30s
+
+  // Todo se crea una vez; las tareas de vinculacion arrancan suspendidas
+  if (syncModeTimeoutTimerHandler == NULL ||
+      !handleMenuTaskStorage.create(handleMenuTask, "Handle Menu", NULL, 1,
+                                    &handleMenuTaskHandler, 0) ||
+      !pingAllDevicesTaskStorage.create(pingAllDevicesTask, "Ping All Devices",
+                                        NULL, 2, &pingAllDevicesTaskHandler,
+                                        1) ||
+      !blinkRGBTaskStorage.create(blinkRGBTask, "Blink LED", NULL, 2,
+                                  &blinkRGBTaskHandler, 1) ||
+      !sendSyncBroadcastTaskStorage.create(sendSyncBroadcastTask,
+                                           "Send Sync Broadcast", NULL, 1,
+                                           &sendSyncBroadcastTaskHandler, 1)) {
+    ESP.restart();
+  }
+
+  // Tareas del camino estable: a partir de aqui no deben reservar memoria
+  HeapGuard::watch(NULL);  // loop()
+  HeapGuard::watch(handleMenuTaskHandler);
+  HeapGuard::watch(pingAllDevicesTaskHandler);
+  HeapGuard::watch(blinkRGBTaskHandler);
+  HeapGuard::watch(sendSyncBroadcastTaskHandler);
+  HeapGuard::watch(menu.getDisplayTask());
+  HeapGuard::watch(bus.getTask(EventContext::UI));
+  HeapGuard::watch(bus.getTask(EventContext::SYSTEM));
+  HeapGuard::arm();
 }
 
+// El boton de sincronizacion se atiende aqui; update() bloquea sin consumir CPU
 void loop() { syncButton.update(); }
 
 void setWatchdogTimeout(uint32_t newTimeout) {
@@ -125,71 +226,116 @@ void setWatchdogTimeout(uint32_t newTimeout) {
   esp_task_wdt_init(wdtTimeout, false);
 }
 
-void tryConnectSTA(const bool updateDisplay) {
-  const ConfigManager::NetworkConfig staConfig = config.getSTAConfig();
-
+void onStaConnectingCallback(const BusEvent& event) {
   rgb.set(Status::PENDING);
+}
 
-  if (updateDisplay) {
-    menu.tryConnect(staConfig.ssid);
-  }
+void onStaConnectedCallback(const BusEvent& event) {
+  menu.setWifiStatus(true);
+  rgb.set(Status::ONLINE);
+}
 
-  if (wifi.connectSTA(staConfig.ssid, staConfig.password)) {
-    globalData.wifi = true;
-    rgb.set(Status::ONLINE);
-  } else {
-    globalData.wifi = false;
-    rgb.set(Status::OFFLINE);
-  }
+void onStaDisconnectedCallback(const BusEvent& event) {
+  menu.setWifiStatus(false);
+  rgb.set(Status::OFFLINE);
+}
 
-  if (updateDisplay) {
-    menu.updateDisplay();
-  }
+void onStaFailedCallback(const BusEvent& event) {
+  menu.setWifiStatus(false);
+  rgb.set(Status::ERROR);
 }
 
-void onConfigEnterCallback() {
-  server.setupRoutes();
-  globalData.ipAP = server.begin();
+void onConfigEnterCallback(const BusEvent& event) {
+  HeapGuard::Exempt exempt;  // Punto de acceso
+
+  // El portal de configuracion debe responder sin esperas de light sleep
+  power.acquire(PowerManager::Lock::RADIO_LISTEN);
+  menu.setHotspotIp(server.openPortal().c_str());
+}
+
+void onConfigExitCallback(const BusEvent& event) {
+  HeapGuard::Exempt exempt;
+
+  server.closePortal();
+  power.release(PowerManager::Lock::RADIO_LISTEN);
+}
+
+void onUpdateStartCallback(const BusEvent& event) {
+  menu.showCustomInfoScreen("Actualizando", "0%");
+}
+
+void onUpdateProgressCallback(const BusEvent& event) {
+  char progress[17];
+
+  snprintf(progress, sizeof(progress), "%lu%%", event.value);
+  menu.showCustomInfoScreen("Actualizando", progress);
 }
 
-void onConfigExitCallback() { server.end(); }
+void onUpdateEndCallback(const BusEvent& event) {
+  if (event.value) {
+    menu.showCustomInfoScreen("Actualizado", "Reiniciando...");
+  } else {
+    menu.clearCustomInfoScreen();
+  }
+}
 
-void onSetActuatorCallback() {
-  const int index = menu.getCurrentActuatorIndex();
-  const NowManager::ActuatorData actuator = now.getActuatorAt(index);
+void onSetActuatorCallback(const BusEvent& event) {
+  // Copia: la tabla puede cambiar mientras se envia
+  NowManager::ActuatorData actuator;
+  if (!now.copyActuatorAt(event.value, actuator)) return;
 
-  Serial.printf("%s actuador: %s\n", actuator.state ? "Apagar" : "Encender",
-                macToString(actuator.mac).c_str());
+  LOG_INFO("%s actuador: %s", actuator.state ? "Apagar" : "Encender",
+           MacText(actuator.mac).c_str());
 
   if (now.sendSetActuatorMsg(actuator.mac, !actuator.state)) {
-    Serial.println("Mensaje SetActuator enviado");
+    LOG_INFO("Mensaje SetActuator enviado");
   } else {
-    Serial.println(" Error enviando mensaje SetActuator");
+    LOG_WARN("Error enviando mensaje SetActuator");
   }
 }
 
-void onScheduleActuatorCallback() {
-  const int index = menu.getCurrentActuatorIndex();
-  const NowManager::ActuatorData actuator = now.getActuatorAt(index);
+void onScheduleActuatorCallback(const BusEvent& event) {
+  NowManager::ActuatorData actuator;
+  if (!now.copyActuatorAt(event.value, actuator)) return;
   const MenuManager::ActuatorSchedule schedule = menu.getActuatorSchedule();
 
-  Serial.printf("Programar actuador: %s\nOffset: %d - Duration: %d\n",
-                macToString(actuator.mac).c_str(), schedule.offset,
-                schedule.duration);
+  LOG_INFO("Programar actuador: %s - Offset: %lu - Duration: %lu",
+           MacText(actuator.mac).c_str(), schedule.offset, schedule.duration);
 
   if (now.sendScheduleActuatorMsg(actuator.mac, schedule.offset,
                                   schedule.duration)) {
-    Serial.println("Mensaje ScheduleActuator enviado");
+    LOG_INFO("Mensaje ScheduleActuator enviado");
   } else {
-    Serial.println(" Error enviando mensaje ScheduleActuator");
+    LOG_WARN("Error enviando mensaje ScheduleActuator");
   }
 }
 
 void onReceivedCallback(const uint8_t* mac, const uint8_t* data, int length) {
+  TRACE_SCOPE("espnow_rx");
+  const uint32_t start = micros();
+
+  power.acquire(PowerManager::Lock::RADIO_RX);
+  handleReceivedFrame(mac, data, length);
+  power.release(PowerManager::Lock::RADIO_RX);
+
+  power.recordRadioReceive(micros() - start);
+}
+
+void handleReceivedFrame(const uint8_t* mac, const uint8_t* data, int length) {
   if (!now.getIsDataTransferEnabled()) return;
 
-  // Validar que la direccion mac este en la lista de paired devices
-  if (!now.isDevicePaired(mac)) return;
+  // Validar que el vecino este en la lista de paired devices y descartar
+  // rafagas antes de decodificar nada
+  if (!now.admitSender(mac)) return;
+
+  // Tramas reenviadas por relays: continuar con el nodo de origen
+  if (!now.resolveOrigin(mac, data, length, mac)) return;
+
+  // Mensajes de la actualizacion OTA de nodos
+  if (nodeOta.handleMessage(mac, data, length)) return;
+
+  // Duplicados del origen; la secuencia solo se registra con el CRC correcto
+  if (!now.acceptFrame(mac, data, length)) return;
 
   if (NowManager::validateMessage(NowManager::MessageType::TEMPERATURE_HUMIDITY,
                                   data, length)) {
@@ -197,10 +343,11 @@ void onReceivedCallback(const uint8_t* mac, const uint8_t* data, int length) {
         reinterpret_cast<const NowManager::TemperatureHumidityMsg*>(data);
 
     if (verifyCRC8(*msg)) {
+      now.commitFrame(mac, data, length);
       now.updateSensorData(mac, "Temp", msg->temp);
       now.updateSensorData(mac, "Hum", msg->hum);
       now.updateDeviceLastSeen(mac);
-      menu.updateData();
+      bus.publish(EventId::DATA_UPDATED);
     }
   } else if (NowManager::validateMessage(
                  NowManager::MessageType::ACTUATOR_STATE, data, length)) {
@@ -208,31 +355,48 @@ void onReceivedCallback(const uint8_t* mac, const uint8_t* data, int length) {
         reinterpret_cast<const NowManager::ActuatorStateMsg*>(data);
 
     if (verifyCRC8(*msg)) {
-      Serial.printf("Mensaje recibido: %s", msg->state ? "true" : "false");
+      now.commitFrame(mac, data, length);
+      LOG_DEBUG("Mensaje recibido: %s", msg->state ? "true" : "false");
       now.updateActuatorState(mac, msg->state);
       now.updateDeviceLastSeen(mac);
-      menu.updateData();
+      bus.publish(EventId::DATA_UPDATED);
     }
   }
 }
 
+void onDataUpdatedCallback(const BusEvent& event) {
+  // Mismo aviso para la pantalla y para los clientes WebSocket
+  menu.updateData();
+  server.notifyDataChanged();
+}
+
 void onSendCallback(const uint8_t* mac, esp_now_send_status_t status) {
+  // En los envios por relay mac es el primer salto; el fallo es del destino
+  uint8_t destination[6];
+  const uint32_t latency = now.popSendDestination(mac, destination);
+
+  // Los broadcast no tienen ACK: el callback no mide la entrega
+  if ((mac[0] & 0x01) == 0)
+    power.recordRadioSend(status == ESP_NOW_SEND_SUCCESS, latency);
+
   if (status != ESP_NOW_SEND_SUCCESS) {
-    NowManager::DeviceInfo* device = now.findDevice(mac);
+    NowManager::NodeType nodeType;
+    if (!now.getNodeType(destination, nodeType))
+      return;  // Broadcast o nodo ya eliminado
 
-    switch (static_cast<NowManager::NodeType>(device->nodeType)) {
+    switch (nodeType) {
       case NowManager::NodeType::TEMPERATURE_HUMIDITY:
-        Serial.println("Desconectando temperatura");
-        now.desconnectSensor(device->mac, "Temp");
-        Serial.println("Desconectando humedad");
-        now.desconnectSensor(device->mac, "Hum");
-        menu.updateData();
+        LOG_INFO("Desconectando temperatura");
+        now.desconnectSensor(destination, "Temp");
+        LOG_INFO("Desconectando humedad");
+        now.desconnectSensor(destination, "Hum");
+        bus.publish(EventId::DATA_UPDATED);
 
         break;
 
       case NowManager::NodeType::RELAY:
-        Serial.println("Desconectando relay");
-        now.desconnectActuator(device->mac);
+        LOG_INFO("Desconectando relay");
+        now.desconnectActuator(destination);
         break;
     }
 
@@ -244,35 +408,38 @@ void handleMenuTask(void* parameter) {
   bool isSuscribed = false;
 
   while (1) {
-    Key key = keypad.getKey();
+    // Bloquea hasta una tecla; el timeout solo sirve para atender el watchdog
+    const Key key = keypad.waitKey(pdMS_TO_TICKS(KEY_WAIT_TIMEOUT));
 
     if (key != Key::NONE) {
-      menu.handleKey(key);
+      menu.handleKey(key, keypad.getLastKeyTime());
       menu.updateDisplay();
     }
 
     if (isSuscribed) {
       esp_task_wdt_reset();  // Resetear el watchdog
 
-      if (!server.getIsListening()) {
+      if (!server.isPortalOpen()) {
+        HeapGuard::Exempt exempt;  // El watchdog gestiona su propia lista
         setWatchdogTimeout(5);
         esp_task_wdt_delete(NULL);  // Eliminar suscripción al watchdog
         isSuscribed = false;
       }
     } else {
-      if (server.getIsListening()) {
+      if (server.isPortalOpen()) {
+        HeapGuard::Exempt exempt;
         setWatchdogTimeout(10);
         esp_task_wdt_add(NULL);  // Suscribir tarea al watchdog
         isSuscribed = true;
       }
     }
-
-    // Delay - 10ms
-    vTaskDelay(pdMS_TO_TICKS(10));
   }
 }
 
 void blinkRGBTask(void* parameter) {
+  // Se reanuda en enterSyncMode() y se suspende en endSyncMode()
+  vTaskSuspend(NULL);
+
   while (1) {
     rgb.set(Status::PENDING);
     vTaskDelay(pdMS_TO_TICKS(500));  // 500ms
@@ -283,6 +450,8 @@ void blinkRGBTask(void* parameter) {
 }
 
 void sendSyncBroadcastTask(void* parameter) {
+  vTaskSuspend(NULL);
+
   while (1) {
     now.sendSyncBroadcastMsg();
 
@@ -300,6 +469,8 @@ void pingAllDevicesTask(void* parameter) {
 
 void enterSyncMode() {
   if (!syncModeState) {
+    HeapGuard::Exempt exempt;  // Reinicio de ESP-NOW
+
     menu.showCustomInfoScreen("Vinculando", "nodo secundario");
 
     now.setDataTransfer(false);
@@ -310,24 +481,12 @@ void enterSyncMode() {
 
     now.onReceived(onRegistrationReceivedCallback);
 
-    if (blinkRGBTaskHandler == NULL) {
-      xTaskCreatePinnedToCore(blinkRGBTask, "Blink LED", 2048, NULL, 2,
-                              &blinkRGBTaskHandler, 1);
-    }
-
-    if (sendSyncBroadcastTaskHandler == NULL) {
-      xTaskCreatePinnedToCore(sendSyncBroadcastTask, "Send Sync Broadcast",
-                              4096, NULL, 1, &sendSyncBroadcastTaskHandler, 1);
-    }
-
-    syncModeTimeoutTimerHandler = xTimerCreate(
-        "Sync Mode Timeout", pdMS_TO_TICKS(NowManager::SYNC_MODE_TIMEOUT),
-        pdFALSE, (void*)0,
-        syncModeTimeoutCallback);  // 30s
-
-    if (syncModeTimeoutTimerHandler != NULL)
-      xTimerStart(syncModeTimeoutTimerHandler, 0);
+    vTaskResume(blinkRGBTaskHandler);
+    vTaskResume(sendSyncBroadcastTaskHandler);
+    xTimerReset(syncModeTimeoutTimerHandler, 0);
 
+    // Ventana de registro: la radio escucha sin light sleep
+    power.acquire(PowerManager::Lock::RADIO_LISTEN);
     syncModeState = true;
   }
 }
@@ -345,51 +504,61 @@ void onRegistrationReceivedCallback(const uint8_t* mac, const uint8_t* data,
                       msg->firmwareVersion))
       now.sendConfirmRegistrationMsg(mac);
 
-    // Test
-    config.printConfig();
+    LOG_DEBUG("Registro de %s: %u nodos en la configuracion",
+              MacText(mac).c_str(), config.getNodeLength());
 
-    endSyncMode();
+    // El reinicio de ESP-NOW no puede hacerse dentro de su propio callback
+    bus.publish(EventId::SYNC_END);
   }
 }
 
+static_assert(NowManager::MAX_DEVICES >= ConfigManager::MAX_NODES,
+              "NowManager no admite todos los nodos de la configuracion");
+
 void registerAllNodes(const uint8_t size) {
-  for (uint8_t i = 0; i < size; i++) {
-    ConfigManager::NodeInfo node = config.getNode(i);
+  ConfigManager::NodeInfo node;
+  for (uint8_t i = 0; i < size && config.getNode(i, node); i++) {
     now.addDevice(node.mac, node.nodeType, node.deviceName,
-                  node.firmwareVersion);
+                  node.firmwareVersion, node.reportInterval,
+                  node.reportThreshold, node.relay);
   }
 }
 
 void pingAllDevices() {
-  for (NowManager::DeviceInfo device : now.getDeviceList()) {
+  // Copia por indice: registerAllNodes() puede reconstruir la tabla a la vez
+  NowManager::DeviceInfo device;
+  for (size_t i = 0; now.copyDeviceAt(i, device); i++) {
     if (now.sendPingMsg(device.mac)) {
-      Serial.println("Mensaje Ping enviado");
+      LOG_DEBUG("Mensaje Ping enviado");
     } else {
-      Serial.println("Error enviando mensaje Ping");
+      LOG_WARN("Error enviando mensaje Ping");
     }
   }
 }
 
-void endSyncMode() {
-  if (syncModeState) {
-    // Detener el timer
-    xTimerStop(syncModeTimeoutTimerHandler, 0);
-
-    // Eliminar el timer y liberar memoria
-    if (xTimerDelete(syncModeTimeoutTimerHandler, 0) == pdPASS)
-      syncModeTimeoutTimerHandler =
-          NULL;  // Reasignar a NULL para evitar usos indebidos
-
-    if (sendSyncBroadcastTaskHandler != NULL) {
-      vTaskDelete(sendSyncBroadcastTaskHandler);
-      sendSyncBroadcastTaskHandler = NULL;
+void sendAllNodeConfigs() {
+  NowManager::DeviceInfo device;
+  for (size_t i = 0; now.copyDeviceAt(i, device); i++) {
+    if (!now.sendReportConfigMsg(device.mac, device.reportInterval,
+                                 device.reportThreshold)) {
+      LOG_WARN("Error enviando mensaje ReportConfig");
     }
 
-    if (blinkRGBTaskHandler != NULL) {
-      vTaskDelete(blinkRGBTaskHandler);
-      blinkRGBTaskHandler = NULL;
-      rgb.set(Status::OFF);
+    if (!now.sendRelayRoleMsg(device.mac, device.isRelay)) {
+      LOG_WARN("Error enviando mensaje RelayRole");
     }
+  }
+}
+
+void endSyncMode() {
+  if (syncModeState) {
+    HeapGuard::Exempt exempt;  // Reinicio de ESP-NOW
+
+    // El timer y las tareas se reutilizan en la siguiente vinculacion
+    xTimerStop(syncModeTimeoutTimerHandler, 0);
+    vTaskSuspend(sendSyncBroadcastTaskHandler);
+    vTaskSuspend(blinkRGBTaskHandler);
+    rgb.set(Status::OFF);
 
     // Reiniciar ESP-NOW
     if (!now.reset()) ESP.restart();
@@ -399,8 +568,10 @@ void endSyncMode() {
     now.setDataTransfer(true);
     registerAllNodes(config.getNodeLength());
     pingAllDevices();
+    sendAllNodeConfigs();
 
     menu.clearCustomInfoScreen();
+    power.release(PowerManager::Lock::RADIO_LISTEN);
 
     syncModeState = false;
   }
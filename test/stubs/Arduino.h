@@ -0,0 +1,42 @@
+#pragma once
+
+// Entorno minimo de Arduino para las pruebas en el host (env:native). Las
+// funciones se implementan en cada prueba para controlar reloj y radio
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+
+class String;  // Solo aparece en declaraciones de Utils.hpp
+
+// strlcpy no existe en todas las libc del host
+#define strlcpy hostStrlcpy
+inline size_t hostStrlcpy(char* dest, const char* src, size_t size) {
+  const size_t length = strlen(src);
+
+  if (size > 0) {
+    const size_t count = length < size - 1 ? length : size - 1;
+    memcpy(dest, src, count);
+    dest[count] = '\0';
+  }
+
+  return length;
+}
+
+unsigned long millis();
+unsigned long micros();
+uint32_t esp_random();
+
+class HardwareSerial {
+ public:
+  template <typename... Args>
+  size_t printf(const char* format, Args... args) {
+    return 0;
+  }
+  size_t println(const char* text = "") { return 0; }
+};
+
+extern HardwareSerial Serial;
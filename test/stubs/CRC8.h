@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CRC8_DALLAS_MAXIM_POLYNOME 0x31
+
+// Mismo calculo que robtillaart/CRC por defecto: sin reflexion y valor
+// inicial 0
+class CRC8 {
+ public:
+  explicit CRC8(uint8_t polynome) : _polynome(polynome) {}
+  void reset() { _crc = 0; }
+  void add(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+      _crc ^= data[i];
+      for (uint8_t bit = 0; bit < 8; bit++)
+        _crc = (_crc & 0x80) ? (_crc << 1) ^ _polynome : _crc << 1;
+    }
+  }
+  uint8_t calc() const { return _crc; }
+
+ private:
+  uint8_t _polynome;
+  uint8_t _crc = 0;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Arduino.h"
+
+typedef enum { WIFI_IF_STA, WIFI_IF_AP } wifi_interface_t;
+typedef enum { WIFI_AUTH_OPEN, WIFI_AUTH_WPA2_PSK } wifi_auth_mode_t;
+
+class WiFiClass {
+ public:
+  uint8_t* macAddress(uint8_t* mac);
+};
+
+extern WiFiClass WiFi;
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "WiFi.h"
+#include "esp_err.h"
+
+#define ESP_NOW_MAX_DATA_LEN 250
+
+typedef enum {
+  ESP_NOW_SEND_SUCCESS,
+  ESP_NOW_SEND_FAIL
+} esp_now_send_status_t;
+
+typedef void (*esp_now_recv_cb_t)(const uint8_t* mac, const uint8_t* data,
+                                  int length);
+typedef void (*esp_now_send_cb_t)(const uint8_t* mac,
+                                  esp_now_send_status_t status);
+
+typedef struct {
+  uint8_t peer_addr[6];
+  uint8_t channel;
+  wifi_interface_t ifidx;
+  bool encrypt;
+} esp_now_peer_info_t;
+
+esp_err_t esp_now_init();
+esp_err_t esp_now_deinit();
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t* peer);
+esp_err_t esp_now_del_peer(const uint8_t* mac);
+esp_err_t esp_now_send(const uint8_t* mac, const uint8_t* data, size_t length);
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t callback);
+esp_err_t esp_now_unregister_recv_cb();
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t callback);
+esp_err_t esp_now_unregister_send_cb();
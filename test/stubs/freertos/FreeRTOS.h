@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+
+// Una sola tarea en el host: las secciones criticas no hacen nada
+typedef struct {
+  int owner;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portENTER_CRITICAL(mux) (void)(mux)
+#define portEXIT_CRITICAL(mux) (void)(mux)
+#define portMAX_DELAY 0xFFFFFFFF
+#define pdPASS 1
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
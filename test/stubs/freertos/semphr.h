@@ -0,0 +1,15 @@
+#pragma once
+
+#include "queue.h"
+
+// Una sola tarea en el host: el mutex siempre esta libre
+typedef void* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+  static int mutex;
+  return &mutex;
+}
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t ticks) {
+  return pdPASS;
+}
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex) { return pdPASS; }
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name,
+                                   uint32_t stackSize, void* parameter,
+                                   UBaseType_t priority, TaskHandle_t* handle,
+                                   BaseType_t core);
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void* TimerHandle_t;
+typedef void (*TimerCallbackFunction_t)(TimerHandle_t);
+
+TimerHandle_t xTimerCreate(const char* name, TickType_t period,
+                           UBaseType_t autoReload, void* id,
+                           TimerCallbackFunction_t callback);
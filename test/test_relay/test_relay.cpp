@@ -0,0 +1,338 @@
+// Enrutamiento por relays en el host: pio test -e native
+//
+// Red simulada: nodo -> relay_n -> ... -> relay_1 -> master. Cada salto de
+// radio pierde tramas con probabilidad HOP_LOSS y tarda HOP_AIRTIME_US; el
+// tiempo de proceso del master (admitSender + resolveOrigin + acceptFrame)
+// se mide.
+#include <unity.h>
+
+#include <chrono>
+
+#include "NowManager.hpp"
+#include "Utils.hpp"
+
+namespace {
+
+const uint8_t MASTER[6] = {0x24, 0x6F, 0x28, 0x00, 0x00, 0x01};
+const uint8_t NODE[6] = {0x24, 0x6F, 0x28, 0x00, 0x00, 0x10};
+const uint8_t SENSOR[6] = {0x24, 0x6F, 0x28, 0x00, 0x00, 0x11};
+const uint8_t RELAYS[NowManager::RELAY_MAX_HOPS][6] = {
+    {0x24, 0x6F, 0x28, 0x00, 0x00, 0x21},
+    {0x24, 0x6F, 0x28, 0x00, 0x00, 0x22},
+    {0x24, 0x6F, 0x28, 0x00, 0x00, 0x23},
+};
+const uint8_t FIRMWARE[3] = {1, 0, 0};
+// Orden de registro en setUp()
+const size_t NODE_INDEX = 0;
+const size_t RELAY_INDEX = 2;  // RELAYS[0]
+
+const uint16_t FRAME_COUNT = 2000;
+const uint32_t FRAME_INTERVAL = 1000;  // Por debajo del limite de tasa
+const double HOP_LOSS = 0.05;
+// Trama corta a 1 Mbps con preambulo, ACK y espera en cola del relay
+const double HOP_AIRTIME_US = 900;
+
+unsigned long clockMs = 0;
+uint32_t randomState = 1;
+
+// Ultimo envio de la radio simulada
+uint8_t sentPeer[6];
+uint8_t sentFrame[ESP_NOW_MAX_DATA_LEN];
+size_t sentLength = 0;
+esp_err_t sendResult = ESP_OK;
+
+NowManager* now = nullptr;
+
+bool isLost() {
+  randomState = randomState * 1103515245 + 12345;
+  return ((randomState >> 16) & 0x7FFF) < HOP_LOSS * 0x8000;
+}
+
+size_t buildFrame(uint8_t* frame, const uint16_t seq, const uint8_t relays) {
+  NowManager::TemperatureHumidityMsg msg;
+  msg.seq = seq;
+  msg.temp = 21.5;
+  msg.hum = 40;
+  addCRC8(msg);
+
+  if (relays == 0) {
+    memcpy(frame, &msg, sizeof(msg));
+    return sizeof(msg);
+  }
+
+  // El nodo encapsula y cada relay incrementa hops al reenviar
+  NowManager::RelayHeader header;
+  memcpy(header.origin, NODE, 6);
+  memcpy(header.destination, MASTER, 6);
+  header.hops = relays;
+  header.seq = seq;
+
+  memcpy(frame, &header, sizeof(header));
+  memcpy(frame + sizeof(header), &msg, sizeof(msg));
+  return sizeof(header) + sizeof(msg);
+}
+
+bool receive(const uint8_t* sender, const uint8_t* frame, int length) {
+  const uint8_t* data = frame;
+  const uint8_t* origin = sender;
+
+  if (!now->admitSender(sender)) return false;
+  if (!now->resolveOrigin(sender, data, length, origin)) return false;
+  if (memcmp(origin, NODE, 6) != 0) return false;
+  if (!now->acceptFrame(origin, data, length)) return false;
+
+  now->commitFrame(origin, data, length);
+  return true;
+}
+
+}  // namespace
+
+// Entorno de Arduino y ESP-NOW simulado
+HardwareSerial Serial;
+WiFiClass WiFi;
+
+unsigned long millis() { return clockMs; }
+unsigned long micros() { return clockMs * 1000; }
+uint32_t esp_random() { return 0x12345678; }
+
+uint8_t* WiFiClass::macAddress(uint8_t* mac) {
+  memcpy(mac, MASTER, 6);
+  return mac;
+}
+
+esp_err_t esp_now_init() { return ESP_OK; }
+esp_err_t esp_now_deinit() { return ESP_OK; }
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t* peer) { return ESP_OK; }
+esp_err_t esp_now_del_peer(const uint8_t* mac) { return ESP_OK; }
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t callback) {
+  return ESP_OK;
+}
+esp_err_t esp_now_unregister_recv_cb() { return ESP_OK; }
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t callback) {
+  return ESP_OK;
+}
+esp_err_t esp_now_unregister_send_cb() { return ESP_OK; }
+
+esp_err_t esp_now_send(const uint8_t* mac, const uint8_t* data,
+                       size_t length) {
+  memcpy(sentPeer, mac, 6);
+  memcpy(sentFrame, data, length);
+  sentLength = length;
+  return sendResult;
+}
+
+const char* formatBooleanToText(const bool data) { return data ? "Si" : "No"; }
+
+size_t formatMac(char* dest, size_t size, const uint8_t* mac) {
+  return snprintf(dest, size, "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1],
+                  mac[2], mac[3], mac[4], mac[5]);
+}
+
+uint8_t calcCRC8(const uint8_t* data, size_t length) {
+  CRC8 crc(CRC8_DALLAS_MAXIM_POLYNOME);
+  crc.reset();
+  crc.add(data, length);
+
+  return crc.calc();
+}
+
+void setUp() {
+  clockMs = 0;
+  randomState = 1;
+  sendResult = ESP_OK;
+  sentLength = 0;
+
+  now = new NowManager();
+  now->init();
+  now->setDataTransfer(true);
+
+  const uint8_t sensorType =
+      static_cast<uint8_t>(NowManager::NodeType::TEMPERATURE_HUMIDITY);
+  const uint8_t relayType = static_cast<uint8_t>(NowManager::NodeType::RELAY);
+
+  now->addDevice(NODE, sensorType, "Nodo", FIRMWARE);
+  now->addDevice(SENSOR, sensorType, "Sensor", FIRMWARE);
+  for (uint8_t i = 0; i < NowManager::RELAY_MAX_HOPS; i++)
+    now->addDevice(RELAYS[i], relayType, "Relay", FIRMWARE,
+                   NowManager::DEFAULT_REPORT_INTERVAL,
+                   NowManager::DEFAULT_REPORT_THRESHOLD, true);
+}
+
+void tearDown() {
+  delete now;
+  now = nullptr;
+}
+
+// Entrega y latencia con 0 (directo) a RELAY_MAX_HOPS relays
+void test_delivery_and_latency_per_hop_count() {
+  for (uint8_t relays = 0; relays <= NowManager::RELAY_MAX_HOPS; relays++) {
+    tearDown();
+    setUp();
+
+    const uint8_t* sender = relays == 0 ? NODE : RELAYS[0];
+    uint8_t frame[ESP_NOW_MAX_DATA_LEN];
+    uint16_t delivered = 0;
+    double processing = 0;
+
+    for (uint16_t seq = 0; seq < FRAME_COUNT; seq++) {
+      clockMs += FRAME_INTERVAL;
+
+      bool isDropped = false;
+      for (uint8_t hop = 0; hop <= relays; hop++) isDropped |= isLost();
+      if (isDropped) continue;
+
+      const size_t length = buildFrame(frame, seq, relays);
+      const auto start = std::chrono::steady_clock::now();
+      const bool isDelivered = receive(sender, frame, length);
+      processing += std::chrono::duration<double, std::micro>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+
+      TEST_ASSERT_TRUE(isDelivered);
+      delivered++;
+    }
+
+    const double ratio = static_cast<double>(delivered) / FRAME_COUNT;
+    const double expected = pow(1 - HOP_LOSS, relays + 1);
+    const double latency =
+        (relays + 1) * HOP_AIRTIME_US + processing / delivered;
+
+    char message[128];
+    snprintf(message, sizeof(message),
+             "relays=%u entrega=%.3f (esperada %.3f) latencia=%.0f us "
+             "(proceso %.2f us)",
+             relays, ratio, expected, latency, processing / delivered);
+    TEST_MESSAGE(message);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.03, expected, ratio);
+
+    // La ruta aprendida apunta al ultimo relay con los saltos recibidos
+    NowManager::DeviceInfo device;
+    TEST_ASSERT_TRUE(now->copyDeviceAt(NODE_INDEX, device));
+    TEST_ASSERT_EQUAL_UINT8(relays, device.hops);
+    TEST_ASSERT_EQUAL_MEMORY(sender, device.nextHop, 6);
+  }
+}
+
+// La misma trama por dos relays solo se entrega una vez
+void test_relayed_duplicate_is_dropped() {
+  uint8_t frame[ESP_NOW_MAX_DATA_LEN];
+  const size_t length = buildFrame(frame, 7, 1);
+
+  TEST_ASSERT_TRUE(receive(RELAYS[0], frame, length));
+  clockMs += FRAME_INTERVAL;
+  TEST_ASSERT_FALSE(receive(RELAYS[1], frame, length));
+}
+
+// Un nodo que reinicia vuelve a empezar en 0 sin volver a vincularse
+void test_node_restart_resyncs_sequence() {
+  uint8_t frame[ESP_NOW_MAX_DATA_LEN];
+
+  for (uint16_t seq = 1000; seq < 1005; seq++) {
+    clockMs += FRAME_INTERVAL;
+    TEST_ASSERT_TRUE(receive(NODE, frame, buildFrame(frame, seq, 0)));
+  }
+
+  for (uint16_t seq = 0; seq < 5; seq++) {
+    clockMs += FRAME_INTERVAL;
+    TEST_ASSERT_TRUE(receive(NODE, frame, buildFrame(frame, seq, 0)));
+  }
+
+  // La ventana sigue a la nueva secuencia y descarta sus repeticiones
+  clockMs += FRAME_INTERVAL;
+  TEST_ASSERT_FALSE(receive(NODE, frame, buildFrame(frame, 4, 0)));
+
+  // Lo mismo con la secuencia de la cabecera de relay
+  for (uint16_t seq = 2000; seq < 2003; seq++) {
+    clockMs += FRAME_INTERVAL;
+    TEST_ASSERT_TRUE(receive(RELAYS[0], frame, buildFrame(frame, seq, 1)));
+  }
+  clockMs += FRAME_INTERVAL;
+  TEST_ASSERT_TRUE(receive(RELAYS[0], frame, buildFrame(frame, 0, 1)));
+}
+
+// El limite de tasa se aplica al vecino antes de decodificar la trama
+void test_rate_limit_applies_to_sender() {
+  uint8_t frame[ESP_NOW_MAX_DATA_LEN];
+  const size_t length = buildFrame(frame, 1, 1);
+
+  // Tramas invalidas: no llegan a resolverse pero gastan tokens del relay
+  frame[sizeof(NowManager::RelayHeader) - 3] = NowManager::RELAY_MAX_HOPS + 1;
+  for (uint8_t i = 0; i < NowManager::RATE_LIMIT_BURST; i++)
+    TEST_ASSERT_FALSE(receive(RELAYS[0], frame, length));
+
+  buildFrame(frame, 1, 1);
+  TEST_ASSERT_FALSE(receive(RELAYS[0], frame, length));
+  NowManager::DeviceInfo relay;
+  TEST_ASSERT_TRUE(now->copyDeviceAt(RELAY_INDEX, relay));
+  TEST_ASSERT_EQUAL_UINT32(1, relay.filter.rateLimitDrops);
+
+  clockMs += NowManager::RATE_LIMIT_REFILL_INTERVAL;
+  TEST_ASSERT_TRUE(receive(RELAYS[0], frame, length));
+}
+
+// Un nodo vinculado sin el rol de relay no puede reenviar tramas
+void test_forward_from_non_relay_is_rejected() {
+  uint8_t frame[ESP_NOW_MAX_DATA_LEN];
+  const size_t length = buildFrame(frame, 1, 1);
+
+  TEST_ASSERT_FALSE(receive(SENSOR, frame, length));
+  TEST_ASSERT_TRUE(receive(RELAYS[0], frame, length));
+}
+
+// Los envios al nodo siguen la ruta y el fallo se atribuye al destino
+void test_send_follows_route_and_reports_destination() {
+  uint8_t frame[ESP_NOW_MAX_DATA_LEN];
+  TEST_ASSERT_TRUE(receive(RELAYS[0], frame, buildFrame(frame, 1, 2)));
+
+  TEST_ASSERT_TRUE(now->sendPingMsg(NODE));
+  TEST_ASSERT_EQUAL_MEMORY(RELAYS[0], sentPeer, 6);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(NowManager::MessageType::RELAY),
+                          sentFrame[0]);
+
+  NowManager::RelayHeader header;
+  memcpy(&header, sentFrame, sizeof(header));
+  TEST_ASSERT_EQUAL_MEMORY(MASTER, header.origin, 6);
+  TEST_ASSERT_EQUAL_MEMORY(NODE, header.destination, 6);
+
+  TEST_ASSERT_TRUE(now->sendPingMsg(RELAYS[0]));
+  TEST_ASSERT_EQUAL_MEMORY(RELAYS[0], sentPeer, 6);
+
+  // Callbacks en orden de envio: primero el nodo, despues el propio relay.
+  // El tiempo devuelto va del envio al callback
+  clockMs += 2;
+  uint8_t destination[6];
+  TEST_ASSERT_EQUAL_UINT32(2000,
+                           now->popSendDestination(RELAYS[0], destination));
+  TEST_ASSERT_EQUAL_MEMORY(NODE, destination, 6);
+  now->popSendDestination(RELAYS[0], destination);
+  TEST_ASSERT_EQUAL_MEMORY(RELAYS[0], destination, 6);
+
+  // Un envio rechazado no deja anotacion: el callback ajeno no la consume
+  sendResult = ESP_FAIL;
+  TEST_ASSERT_FALSE(now->sendPingMsg(NODE));
+  now->popSendDestination(RELAYS[0], destination);
+  TEST_ASSERT_EQUAL_MEMORY(RELAYS[0], destination, 6);
+}
+
+// Una ruta caducada vuelve al envio directo
+void test_stale_route_falls_back_to_direct() {
+  uint8_t frame[ESP_NOW_MAX_DATA_LEN];
+  TEST_ASSERT_TRUE(receive(RELAYS[0], frame, buildFrame(frame, 1, 1)));
+
+  clockMs += NowManager::ROUTE_TIMEOUT + 1;
+  TEST_ASSERT_TRUE(now->sendPingMsg(NODE));
+  TEST_ASSERT_EQUAL_MEMORY(NODE, sentPeer, 6);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_delivery_and_latency_per_hop_count);
+  RUN_TEST(test_relayed_duplicate_is_dropped);
+  RUN_TEST(test_node_restart_resyncs_sequence);
+  RUN_TEST(test_rate_limit_applies_to_sender);
+  RUN_TEST(test_forward_from_non_relay_is_rejected);
+  RUN_TEST(test_send_follows_route_and_reports_destination);
+  RUN_TEST(test_stale_route_falls_back_to_direct);
+  return UNITY_END();
+}